@@ -2,6 +2,7 @@ import logging
 import time
 import psutil
 import os
+import threading
 
 class ConcurrentScheduler:
 
@@ -53,3 +54,46 @@ class ConcurrentScheduler:
         for completeProc in completed:
             self.jobsProcessing.remove(completeProc)
             self.jobsComplete.append(completeProc)
+
+class WorkerScheduler:
+    """
+    Runs jobs on a fixed pool of NTRTWorkers that stay alive between generations, one thread
+    per worker. Each job must provide runOnWorker(worker).
+    """
+
+    def __init__(self, toProcess, workers):
+        self.workers = workers
+        self.jobsUnprocessed = toProcess
+        self.jobsComplete = []
+        self.lock = threading.Lock()
+        logging.info("Worker scheduler instantiated. Contains %d jobs. Number of workers: %d." % (len(self.jobsUnprocessed), len(self.workers)))
+
+    def processJobs(self):
+        logging.info("Worker scheduler beginning jobs.")
+        self.failure = None
+        threads = [threading.Thread(target=self.__workerLoop, args=(w,)) for w in self.workers]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        if self.failure is not None:
+            raise self.failure
+        return self.jobsComplete
+
+    def __workerLoop(self, worker):
+        while True:
+            with self.lock:
+                if len(self.jobsUnprocessed) == 0 or self.failure is not None:
+                    return
+                toRun = self.jobsUnprocessed.pop()
+
+            try:
+                toRun.runOnWorker(worker)
+            except Exception as e:
+                logging.error("Job failed on worker: %s" % e)
+                with self.lock:
+                    self.failure = e
+                return
+
+            with self.lock:
+                self.jobsComplete.append(toRun)
@@ -60,6 +60,26 @@ class EvolutionJob(NTRTJob):
                 subprocess.check_call([self.args['executable'], "-l", self.args['filename'], "-P", self.args['path'], "-s", str(trialLength), "-b", str(run[0]), "-H", str(run[1]), "-a", str(run[2]), "-B", str(run[3])], stdout=logFile)
             sys.exit()
 
+    def runOnWorker(self, worker):
+        """
+        Run every terrain of this job on a warm NTRTWorker instead of a new process. The
+        controller file is written back with the scores, as the app would have left it.
+        """
+
+        logging.info("RUNNING job on worker with args %r" % self.args)
+        scoresPath = self.args['resourcePrefix'] + self.args['path'] + self.args['filename']
+
+        fin = open(scoresPath, 'r')
+        controller = json.load(fin)
+        fin.close()
+
+        for run in self.args['terrain']:
+            controller = worker.runTrial(controller, run, self.args['length'])
+
+        fout = open(scoresPath, 'w')
+        json.dump(controller, fout, indent=4)
+        fout.close()
+
     def processJobOutput(self):
         scoresPath = self.args['resourcePrefix'] + self.args['path'] + self.args['filename']
 
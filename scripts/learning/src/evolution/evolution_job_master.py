@@ -2,8 +2,8 @@ import os
 import json
 import random
 import collections
-from interfaces import NTRTJobMaster, NTRTMasterError
-from concurrent_scheduler import ConcurrentScheduler
+from interfaces import NTRTJobMaster, NTRTMasterError, NTRTWorker
+from concurrent_scheduler import ConcurrentScheduler, WorkerScheduler
 import collections
 #TODO: This is hackety, fix it.
 from evolution_job import EvolutionJob
@@ -523,6 +523,15 @@ class EvolutionJobMaster(NTRTJobMaster):
 
         scoreDump = open('scoreDump.txt', 'w')
         scoreDump.close()
+
+        # Optionally keep one app per process alive for the whole run
+        workers = []
+        if self.jConf.get('workers', False):
+            for w in range(self.numProcesses):
+                workerFile = self.jConf['filePrefix'] + "_worker" + str(w) + self.jConf['fileSuffix']
+                logPath = self.jConf['resourcePath'] + self.jConf['lowerPath'] + workerFile + '_log.txt'
+                workers.append(NTRTWorker(self.jConf['executable'], workerFile, self.jConf['lowerPath'], logPath))
+
         for n in range(numGenerations):
             # Create the generation'
             for p in self.prefixes:
@@ -554,7 +563,10 @@ class EvolutionJobMaster(NTRTJobMaster):
                         jobList.append(EvolutionJob(args))
 
             # Run the jobs
-            conSched = ConcurrentScheduler(jobList, self.numProcesses)
+            if workers:
+                conSched = WorkerScheduler(jobList, workers)
+            else:
+                conSched = ConcurrentScheduler(jobList, self.numProcesses)
             completedJobs = conSched.processJobs()
 
             # Read scores from files, write to logs
@@ -586,3 +598,5 @@ class EvolutionJobMaster(NTRTJobMaster):
             logFile.write(str((n+1) * numTrials) + ',' + str(maxScore) + ',' + str(avgScore) +'\n')
             logFile.close()
 
+        for w in workers:
+            w.close()
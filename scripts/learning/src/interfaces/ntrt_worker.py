@@ -0,0 +1,73 @@
+import json
+import logging
+import struct
+import subprocess
+from ntrt_master_error import NTRTMasterError
+
+class NTRTWorker:
+    """
+    A learning app kept alive between trials. The app is started once with --worker and takes
+    trials on its stdin. Each message either way is a four byte big endian length followed by a
+    JSON document of that length. The app's console output goes to the log file instead of stdout.
+    """
+
+    __HEADER = struct.Struct('>I')
+
+    def __init__(self, executable, filename, path, logPath):
+        """
+        Start the app. filename is the controller file the worker writes each trial's parameters
+        to, so each worker needs its own.
+        """
+        logging.info("Starting worker %s with file %s" % (executable, filename))
+        self.logFile = open(logPath, 'wb')
+        self.process = subprocess.Popen([executable, "--worker", "-l", filename, "-P", path],
+                                        stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                        stderr=self.logFile)
+
+    def runTrial(self, controller, run, length):
+        """
+        Run one trial and block until it is done. controller is the object that would have been
+        written to the controller's file, and run is a row of the terrain matrix. Returns the
+        controller object the app wrote back, with the scores of this trial appended.
+        """
+        if len(run) < 4:
+            raise NTRTMasterError("Not enough terrain args!")
+
+        trial = {'controller' : controller,
+                 'blocks'     : bool(run[0]),
+                 'hills'      : bool(run[1]),
+                 'angle'      : float(run[2]),
+                 'goalAngle'  : float(run[3]),
+                 'steps'      : int(run[4]) if len(run) >= 5 else int(length)}
+
+        self.__send(json.dumps(trial))
+        reply = json.loads(self.__receive())
+        if 'error' in reply:
+            raise NTRTMasterError("Worker trial failed: " + reply['error'])
+        return reply
+
+    def close(self):
+        """
+        Close the app's stdin, which ends its loop, and wait for it to exit.
+        """
+        self.process.stdin.close()
+        self.process.wait()
+        self.logFile.close()
+
+    def __send(self, message):
+        data = message.encode('utf-8')
+        self.process.stdin.write(self.__HEADER.pack(len(data)) + data)
+        self.process.stdin.flush()
+
+    def __receive(self):
+        size = self.__HEADER.unpack(self.__readFully(self.__HEADER.size))[0]
+        return self.__readFully(size).decode('utf-8')
+
+    def __readFully(self, size):
+        data = b''
+        while len(data) < size:
+            chunk = self.process.stdout.read(size - len(data))
+            if not chunk:
+                raise NTRTMasterError("Worker exited with status %r" % self.process.poll())
+            data += chunk
+        return data
@@ -114,3 +114,23 @@ void tgPIDController::setSensorData(double sensorData)
 	/// @todo - are there any sanity checks we can enforce here?
 	m_sensorData = sensorData;
 }
+
+void tgPIDController::saveState(std::vector<double>& state) const
+{
+	state.push_back(m_setPoint);
+	state.push_back(m_sensorData);
+	state.push_back(m_prevError);
+	state.push_back(m_intError);
+}
+
+void tgPIDController::restoreState(const std::vector<double>& state, std::size_t& pos)
+{
+	if (pos + 4 > state.size())
+	{
+		throw std::invalid_argument("Saved state is too short for tgPIDController");
+	}
+	m_setPoint = state[pos++];
+	m_sensorData = state[pos++];
+	m_prevError = state[pos++];
+	m_intError = state[pos++];
+}
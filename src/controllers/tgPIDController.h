@@ -29,6 +29,10 @@
 
 #include "tgBasicController.h"
 
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
 // Forward declarations
 class tgControllable;
 
@@ -134,6 +138,21 @@ public:
 	
 	/// @todo should we have a getSensorData function? Might make code changes simpler later
 	
+	/**
+	 * Append the setpoint, the sensor data and the error terms, for the
+	 * tgObserver::onSaveState of the controller that owns this one
+	 * @param[out] state the buffer to append to
+	 */
+	void saveState(std::vector<double>& state) const;
+	
+	/**
+	 * Read back the values appended by saveState
+	 * @param[in] state the buffer written by saveState
+	 * @param[in,out] pos the read position
+	 * @throw std::invalid_argument if state is too short
+	 */
+	void restoreState(const std::vector<double>& state, std::size_t& pos);
+	
 private:
 	/**
 	 * Member variable for sensor data. Units are application dependant.
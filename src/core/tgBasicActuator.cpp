@@ -106,10 +106,37 @@ void tgBasicActuator::step(double dt)
     {   
         // Want to update any controls before applying forces
         notifyStep(dt); 
-        m_springCable->step(dt);
-        logHistory();  
-        tgModel::step(dt);
+        if (!dynamicsDeferred())
+        {
+            stepDynamics(dt);
+        }
+    }
+}
+
+void tgBasicActuator::stepDynamics(double dt)
+{
+    m_springCable->step(dt);
+    logHistory();  
+    tgModel::step(dt);
+}
+
+void tgBasicActuator::saveState(std::vector<double>& state) const
+{
+    state.push_back(m_preferredLength);
+    state.push_back(prevVel);
+    tgSpringCableActuator::saveState(state);
+}
+
+void tgBasicActuator::restoreState(const std::vector<double>& state,
+                                   std::size_t& pos)
+{
+    if (pos + 2 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgBasicActuator");
     }
+    m_preferredLength = state[pos++];
+    prevVel = state[pos++];
+    tgSpringCableActuator::restoreState(state, pos);
 }
 
 void tgBasicActuator::onVisit(const tgModelVisitor& r) const
@@ -124,13 +151,13 @@ void tgBasicActuator::logHistory()
 {
     m_prevVelocity = m_springCable->getVelocity();
 
-    if (m_config.hist)
+    if (m_config.hist || m_config.histStats)
     {
-        m_pHistory->lastLengths.push_back(m_springCable->getActualLength());
-        m_pHistory->lastVelocities.push_back(m_springCable->getVelocity());
-        m_pHistory->dampingHistory.push_back(m_springCable->getDamping());
-        m_pHistory->restLengths.push_back(m_springCable->getRestLength());
-        m_pHistory->tensionHistory.push_back(m_springCable->getTension());
+        recordHistory(m_springCable->getActualLength(),
+                      m_springCable->getVelocity(),
+                      m_springCable->getDamping(),
+                      m_springCable->getRestLength(),
+                      m_springCable->getTension());
     }
 }
 
@@ -76,6 +76,13 @@ public:
      * @param[in] dt, must be >= 0.0
      */    
     virtual void step(double dt);
+
+    /**
+     * Applies forces to rigid bodies via tgBulletSpringCable, logs history
+     * if desired, steps children. Called by step() unless deferred.
+     * @param[in] dt, must be positive
+     */
+    virtual void stepDynamics(double dt);
     
     /**
      * Double dispatch function for a tgModelVisitor. This object
@@ -85,6 +92,21 @@ public:
      */
     virtual void onVisit(const tgModelVisitor& r) const;
     
+    /**
+     * Appends the preferred length, then calls
+     * tgSpringCableActuator::saveState
+     * @param[out] state the buffer to append to
+     */
+    virtual void saveState(std::vector<double>& state) const;
+
+    /**
+     * Read back the values appended by saveState, in the same order
+     * @param[in] state the buffer written by saveState
+     * @param[in,out] pos the read position
+     * @throw std::invalid_argument if state is too short
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
     
     /** Functions for interfacing with higher level controllers */
     /**
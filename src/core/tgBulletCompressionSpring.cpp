@@ -298,6 +298,29 @@ const std::vector<const tgSpringCableAnchor*>tgBulletCompressionSpring::getAncho
     return tgCast::constFilter<tgBulletSpringCableAnchor, const tgSpringCableAnchor>(m_anchors);
 }
 
+void tgBulletCompressionSpring::saveState(std::vector<double>& state) const
+{
+    state.push_back(m_restLength);
+    state.push_back(m_prevLength);
+    state.push_back(m_velocity);
+    state.push_back(m_dampingForce);
+}
+
+void tgBulletCompressionSpring::restoreState(const std::vector<double>& state,
+                                             std::size_t& pos)
+{
+    if (pos + 4 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgBulletCompressionSpring");
+    }
+    m_restLength = state[pos++];
+    m_prevLength = state[pos++];
+    m_velocity = state[pos++];
+    m_dampingForce = state[pos++];
+
+    assert(invariant());
+}
+
 // The invariant, for checking that everything is OK.
 bool tgBulletCompressionSpring::invariant(void) const
 {
@@ -30,6 +30,7 @@
 // The Bullet Physics library
 #include "LinearMath/btVector3.h"
 // The C++ Standard Library
+#include <cstddef>
 #include <vector>
 
 // Forward references
@@ -167,6 +168,21 @@ public:
      */
     virtual const std::vector<const tgSpringCableAnchor*> getAnchors() const;
 
+    /**
+     * Append the rest length, previous length, velocity and damping force
+     * @param[out] state the buffer to append to
+     */
+    virtual void saveState(std::vector<double>& state) const;
+
+    /**
+     * Read back the values appended by saveState
+     * @param[in] state the buffer written by saveState
+     * @param[in,out] pos the read position, advanced past this spring
+     * @throw std::invalid_argument if state is too short
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
+
     
 protected:
     
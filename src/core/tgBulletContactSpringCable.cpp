@@ -48,6 +48,7 @@
 #include "LinearMath/btQuickprof.h"
 
 // The C++ Standard Library
+#include <cassert>
 #include <iostream>
 #include <cmath>		// abs
 #include <stdexcept>
@@ -79,6 +80,25 @@ tgBulletContactSpringCable::~tgBulletContactSpringCable()
     btCollisionShape* shape = m_ghostObject->getCollisionShape();
     deleteCollisionShape(shape);
     delete m_ghostObject;
+    
+    for (std::size_t i = 0; i < m_spareSegments.size(); i++)
+    {
+        delete m_spareSegments[i];
+    }
+    
+    // The pool goes before tgBulletSpringCable deletes the rest
+    for (std::size_t j = 0; j < m_newAnchors.size(); j++)
+    {
+        m_anchorPool.destroy(m_newAnchors[j]);
+    }
+    std::size_t i = 0;
+    while (i < m_anchors.size())
+    {
+        if (!deleteAnchor(i))
+        {
+            i++;
+        }
+    }
 }
 
 const btScalar tgBulletContactSpringCable::getActualLength() const
@@ -125,6 +145,31 @@ void tgBulletContactSpringCable::step(double dt)
     assert(invariant());
 }
 
+void tgBulletContactSpringCable::restoreState(const std::vector<double>& state,
+                                              std::size_t& pos)
+{
+    tgBulletSpringCable::restoreState(state, pos);
+
+    // Anchor 0 and the last anchor are permanent
+    std::size_t i = 1;
+    while (i < m_anchors.size() - 1)
+    {
+        if (!deleteAnchor(i))
+        {
+            i++;
+        }
+    }
+    for (std::size_t j = 0; j < m_newAnchors.size(); j++)
+    {
+        m_anchorPool.destroy(m_newAnchors[j]);
+    }
+    m_newAnchors.clear();
+
+    updateCollisionObject();
+
+    assert(invariant());
+}
+
 void tgBulletContactSpringCable::calculateAndApplyForce(double dt)
 {
 #ifndef BT_NO_PROFILE 
@@ -308,10 +353,6 @@ void tgBulletContactSpringCable::updateManifolds()
 						// -1 means findNearestPastAnchor failed
 						if (anchorPos >= 0)
 						{
-							// Not permanent, sliding contact
-							tgBulletSpringCableAnchor* const newAnchor = new tgBulletSpringCableAnchor(rb, pos, m_touchingNormal, false, true, manifold);
-						
-							
 							tgBulletSpringCableAnchor* backAnchor = m_anchors[anchorPos];
 							tgBulletSpringCableAnchor* forwardAnchor = m_anchors[anchorPos + 1];
 							
@@ -324,10 +365,10 @@ void tgBulletContactSpringCable::updateManifolds()
 							btScalar lengthA = lineA.length();
 							btScalar lengthB = lineB.length();
 							
-							btScalar mDistB = backAnchor->getManifoldDistance(newAnchor->getManifold()).first;
-							btScalar mDistA = forwardAnchor->getManifoldDistance(newAnchor->getManifold()).first;
+							btScalar mDistB = backAnchor->getManifoldDistance(manifold).first;
+							btScalar mDistA = forwardAnchor->getManifoldDistance(manifold).first;
 							
-							//std::cout << "Update Manifolds " << newAnchor->getManifold() << std::endl;
+							//std::cout << "Update Manifolds " << manifold << std::endl;
 							
 							bool del = false;	
 										
@@ -344,14 +385,12 @@ void tgBulletContactSpringCable::updateManifolds()
 									//std::cout << "UpdateA " << mDistA << std::endl;
 							}
 							
-							if (del)
+							/// @todo further examination of whether the anchors should be skipped here
+							if (!del)
 							{
-								/// @todo further examination of whether the anchors should be deleted here
-								delete newAnchor;
-							}
-							else
-							{
-												
+								// Not permanent, sliding contact
+								tgBulletSpringCableAnchor* const newAnchor =
+									m_anchorPool.create(rb, pos, m_touchingNormal, manifold);
 								m_newAnchors.push_back(newAnchor);
 							} // If anchor passes distance tests
 						} // If we could find the anchor's position
@@ -376,8 +415,8 @@ void tgBulletContactSpringCable::updateAnchorList()
 	while (m_newAnchors.size() > 0)
 	{
 		// Not permanent, sliding contact
-		tgBulletSpringCableAnchor* const newAnchor = m_newAnchors[0];
-		m_newAnchors.erase(m_newAnchors.begin());
+		tgBulletSpringCableAnchor* const newAnchor = m_newAnchors.front();
+		m_newAnchors.pop_front();
 		
 		btVector3 pos1 = newAnchor->getWorldPosition();
 
@@ -434,11 +473,11 @@ void tgBulletContactSpringCable::updateAnchorList()
             
 			if (del)
 			{
-				delete newAnchor;
+				m_anchorPool.destroy(newAnchor);
 			}
 			else if(normalValue1 < 0.0 || normalValue2 < 0.0)
 			{
-				delete newAnchor;
+				m_anchorPool.destroy(newAnchor);
 			}
 			else if ((backNormal.dot(contactNormal) < 0.0 && newAnchor->attachedBody == backAnchor->attachedBody) || 
                         (forwardNormal.dot(contactNormal) < 0.0 && newAnchor->attachedBody == forwardAnchor->attachedBody))
@@ -447,7 +486,7 @@ void tgBulletContactSpringCable::updateAnchorList()
                 std::cout << "Deleting based on contact normals! " << backNormal.dot(contactNormal);
                 std::cout << " " << forwardNormal.dot(contactNormal) << std::endl;
 #endif
-                delete newAnchor;
+                m_anchorPool.destroy(newAnchor);
             }
 			else
 			{		
@@ -480,7 +519,7 @@ void tgBulletContactSpringCable::updateAnchorList()
 		}
 		else
 		{
-			delete newAnchor;
+			m_anchorPool.destroy(newAnchor);
 		}
 	}
    
@@ -689,9 +728,14 @@ void tgBulletContactSpringCable::updateCollisionObject()
 	btDispatcher* m_dispatcher = tgBulletUtil::worldToDynamicsWorld(m_world).getDispatcher();
 	btBroadphaseInterface* const m_overlappingPairCache = tgBulletUtil::worldToDynamicsWorld(m_world).getBroadphase();
 	
-    // Clear the existing child shapes
     btCompoundShape* m_compoundShape = tgCast::cast<btCollisionShape, btCompoundShape> (m_ghostObject->getCollisionShape());
-    clearCompoundShape(m_compoundShape);
+    
+    // The builder's placeholder child is not one of our segments
+    if (static_cast<std::size_t>(m_compoundShape->getNumChildShapes()) != m_segments.size())
+    {
+        clearCompoundShape(m_compoundShape);
+        m_segments.clear();
+    }
     
     btVector3 maxes(anchor2->getWorldPosition());
     btVector3 mins(anchor1->getWorldPosition());
@@ -715,10 +759,17 @@ void tgBulletContactSpringCable::updateCollisionObject()
     }
     btVector3 center = (maxes + mins)/2.0;
     
-    btVector3 from = anchor1->getWorldPosition();
-	btVector3 to = anchor2->getWorldPosition();
+    // Only touch the child list when the number of segments changes,
+    // always at the end so the remaining children keep their indices
+    const std::size_t nSegments = n - 1;
+    while (m_segments.size() > nSegments)
+    {
+        m_compoundShape->removeChildShapeByIndex(m_segments.size() - 1);
+        m_spareSegments.push_back(m_segments.back());
+        m_segments.pop_back();
+    }
 	
-    for (std::size_t i = 0; i < n-1; i++)
+    for (std::size_t i = 0; i < nSegments; i++)
     {
         btVector3 pos1 = m_anchors[i]->getWorldPosition();
         btVector3 pos2 = m_anchors[i+1]->getWorldPosition();
@@ -728,12 +779,33 @@ void tgBulletContactSpringCable::updateCollisionObject()
         t.setOrigin(t.getOrigin() - center);
         
         btScalar length = (pos2 - pos1).length() / 2.0;
+        const btVector3 halfExtents(m_thickness, length, m_thickness);
 		
         /// @todo - seriously examine box vs cylinder shapes
-        btCylinderShape* box = new btCylinderShape(btVector3(m_thickness, length, m_thickness));
-        
-        m_compoundShape->addChildShape(t, box);
+        if (i < m_segments.size())
+        {
+            setSegmentHalfExtents(m_segments[i], halfExtents);
+            // The compound's bounds are recalculated once, below
+            m_compoundShape->updateChildTransform(i, t, false);
+        }
+        else
+        {
+            btCylinderShape* box;
+            if (m_spareSegments.empty())
+            {
+                box = new btCylinderShape(halfExtents);
+            }
+            else
+            {
+                box = m_spareSegments.back();
+                m_spareSegments.pop_back();
+                setSegmentHalfExtents(box, halfExtents);
+            }
+            m_compoundShape->addChildShape(t, box);
+            m_segments.push_back(box);
+        }
     }
+    m_compoundShape->recalculateLocalAabb();
     // Default margin is 0.04, so larger than default thickness. Behavior is better with larger margin
     //m_compoundShape->setMargin(m_thickness);
     
@@ -741,13 +813,21 @@ void tgBulletContactSpringCable::updateCollisionObject()
     transform.setOrigin(center);
     transform.setRotation(btQuaternion::getIdentity());
     
-    m_ghostObject->setCollisionShape (m_compoundShape);
     m_ghostObject->setWorldTransform(transform);
 	
 	// Delete the existing contacts in bullet to prevent sticking - may exacerbate problems with rotations
 	m_overlappingPairCache->getOverlappingPairCache()->cleanProxyFromPairs(m_ghostObject->getBroadphaseHandle(),m_dispatcher);
 }
 
+void tgBulletContactSpringCable::setSegmentHalfExtents(btCylinderShape* pShape,
+                                                       const btVector3& halfExtents)
+{
+    // As btCylinderShape's constructor does, with unit scaling
+    const btScalar margin = pShape->getMargin();
+    pShape->setImplicitShapeDimensions(halfExtents -
+                                       btVector3(margin, margin, margin));
+}
+
 void tgBulletContactSpringCable::deleteCollisionShape(btCollisionShape* pShape)
 {
 #ifndef BT_NO_PROFILE 
@@ -797,7 +877,7 @@ bool tgBulletContactSpringCable::deleteAnchor(int i)
 	
 	if (m_anchors[i]->permanent != true)
 	{
-		delete m_anchors[i];
+		m_anchorPool.destroy(m_anchors[i]);
 		m_anchors.erase(m_anchors.begin() + i);
 		return true;
 	}
@@ -29,11 +29,12 @@
 
 // NTRT
 #include "core/tgBulletSpringCable.h"
+#include "core/tgBulletSpringCableAnchorPool.h"
 // The Bullet Physics library
 #include "LinearMath/btScalar.h"
 #include "LinearMath/btVector3.h"
 // The C++ Standard Library
-
+#include <deque>
 #include <vector>
 
 // Forward references
@@ -42,7 +43,9 @@ class tgBulletSpringCableAnchor;
 class btRigidBody;
 class btCollisionShape;
 class btCompoundShape;
+class btCylinderShape;
 class btPairCachingGhostObject;
+class btPersistentManifold;
 class btDynamicsWorld;
 
 /**
@@ -113,6 +116,16 @@ public:
      */
     virtual const btScalar getActualLength() const;
     
+    /**
+     * Restores the spring state, then drops every sliding contact
+     * anchor. Their manifolds belong to the state being discarded;
+     * contacts are found again by updateManifolds() on the next step.
+     * @param[in] state the buffer written by saveState
+     * @param[in,out] pos the read position, advanced past this cable
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
+    
 private:
     
     /**
@@ -181,10 +194,20 @@ private:
     /**
      * Uses m_anchors to update the collision shape of the m_ghostObject
      * Also resets the broadphase's pairCache after collision object
-     * is changed.
+     * is changed. The segment shapes are reused from step to step;
+     * children are only added or removed when the number of anchors
+     * changes.
      */
     void updateCollisionObject();
     
+    /**
+     * Resize a segment shape in place
+     * @param[in] pShape a segment in m_segments or m_spareSegments
+     * @param[in] halfExtents as for btCylinderShape's constructor
+     */
+    void setSegmentHalfExtents(btCylinderShape* pShape,
+                               const btVector3& halfExtents);
+    
     /**
      * Deletes a collision shape and it's child shapes
      * @param[in] pShape the btCollisionShape to be deleted
@@ -224,11 +247,29 @@ private:
      */
     std::vector<tgBulletSpringCableAnchor*>::iterator m_anchorIt;
     
+    /**
+     * Every non-permanent anchor of the cable is made and destroyed
+     * here, never with new and delete
+     */
+    tgBulletSpringCableAnchorPool m_anchorPool;
+    
     /**
      * Temporary storage for anchors between updateManifolds() and
-     * updateAnchorList()
+     * updateAnchorList(), consumed from the front
+     */
+    std::deque<tgBulletSpringCableAnchor*> m_newAnchors;
+    
+    /**
+     * The children of the ghost object's compound shape, one per pair
+     * of adjacent anchors, in order. Owned by the compound shape.
+     */
+    std::vector<btCylinderShape*> m_segments;
+    
+    /**
+     * Segment shapes removed from the compound when the cable lost
+     * anchors, kept for reuse. We own these.
      */
-    std::vector<tgBulletSpringCableAnchor*> m_newAnchors;
+    std::vector<btCylinderShape*> m_spareSegments;
     
     /**
      * A reference to the dynamics world so that we can track the
@@ -25,6 +25,7 @@
 // This module
 #include "tgBulletSpringCable.h"
 #include "tgBulletSpringCableAnchor.h"
+#include "tgBulletSpringCableBatch.h"
 #include "tgCast.h"
 // The BulletPhysics library
 #include "BulletDynamics/Dynamics/btRigidBody.h"
@@ -35,14 +36,25 @@
 tgBulletSpringCable::tgBulletSpringCable( const std::vector<tgBulletSpringCableAnchor*>& anchors,
                 double coefK,
                 double dampingCoefficient,
-                double pretension) :
+                double pretension,
+                tgBulletSpringCableBatch* batch) :
 tgSpringCable(tgCast::filter<tgBulletSpringCableAnchor, tgSpringCableAnchor>(anchors),
                 coefK, dampingCoefficient, pretension),
 m_anchors(anchors),
 anchor1(anchors.front()),
-anchor2(anchors.back())
+anchor2(anchors.back()),
+m_pBatch(batch),
+m_batchSlot(0)
 {
     assert(m_anchors.size() >= 2);
+    if (m_pBatch)
+    {
+        if (m_anchors.size() != 2)
+        {
+            throw std::invalid_argument("Only two-anchor cables can be batched");
+        }
+        m_pBatch->add(*anchor1, *anchor2, &m_batchSlot);
+    }
     assert(invariant());
     // tgSpringCable does heavy lifting as far as determining rest length
 }
@@ -54,6 +66,11 @@ tgBulletSpringCable::~tgBulletSpringCable()
     std::cout << "Destroying tgBulletSpringCable" << std::endl;
     #endif
     
+    if (m_pBatch)
+    {
+        m_pBatch->remove(m_batchSlot);
+    }
+
     std::size_t n = m_anchors.size();
     
     // Make absolutely sure these are deleted, in case we have a poorly timed reset
@@ -89,17 +106,50 @@ void tgBulletSpringCable::step(double dt)
 
 void tgBulletSpringCable::calculateAndApplyForce(double dt)
 {
+    if (m_pBatch)
+    {
+        // The batch finds the lengths of all cables at once, and applies
+        // the force with all the others after the models have stepped
+        const double magnitude =
+          calculateForceMagnitude(m_pBatch->length(m_batchSlot), dt);
+        m_pBatch->queueForce(m_batchSlot, magnitude, dt);
+        return;
+    }
+
     btVector3 force(0.0, 0.0, 0.0);
-    double magnitude = 0.0;
     const btVector3 dist =
       anchor2->getWorldPosition() - anchor1->getWorldPosition();
       
     // These computations should occur for history regardless of motion
     const double currLength = dist.length();
     const btVector3 unitVector = dist / currLength;
+    
+    const double magnitude = calculateForceMagnitude(currLength, dt);
+    if (magnitude != 0.0)
+    {   
+        force = unitVector * magnitude; 
+    }
+    else
+    {
+        // Leave force as the zero vector
+    }
+
+    //Now Apply it to the connected two bodies
+    btVector3 point1 = this->anchor1->getRelativePosition();
+    this->anchor1->attachedBody->activate();
+    this->anchor1->attachedBody->applyImpulse(force*dt,point1);
+
+    btVector3 point2 = this->anchor2->getRelativePosition();
+    this->anchor2->attachedBody->activate();
+    this->anchor2->attachedBody->applyImpulse(-force*dt,point2);
+}
+
+double tgBulletSpringCable::calculateForceMagnitude(double currLength,
+                                                    double dt)
+{
     const double stretch = currLength - m_restLength;
     
-    magnitude =  m_coefK * stretch;
+    double magnitude =  m_coefK * stretch;
     
     const double deltaStretch = currLength - m_prevLength;
     m_velocity = deltaStretch / dt;
@@ -115,29 +165,13 @@ void tgBulletSpringCable::calculateAndApplyForce(double dt)
     magnitude += m_damping;
     
     #if (0)
-    std::cout << "Length: " << dist.length() << " rl: " << m_restLength <<std::endl; 
+    std::cout << "Length: " << currLength << " rl: " << m_restLength <<std::endl; 
     #endif
-      
-    if (dist.length() > m_restLength)
-    {   
-        force = unitVector * magnitude; 
-    }
-    else
-    {
-        // Leave force as the zero vector
-    }
     
     // Finished calculating, so can store things
     m_prevLength = currLength;
 
-    //Now Apply it to the connected two bodies
-    btVector3 point1 = this->anchor1->getRelativePosition();
-    this->anchor1->attachedBody->activate();
-    this->anchor1->attachedBody->applyImpulse(force*dt,point1);
-
-    btVector3 point2 = this->anchor2->getRelativePosition();
-    this->anchor2->attachedBody->activate();
-    this->anchor2->attachedBody->applyImpulse(-force*dt,point2);
+    return (currLength > m_restLength) ? magnitude : 0.0;
 }
 
 const double tgBulletSpringCable::getActualLength() const
@@ -38,6 +38,7 @@
 class btRigidBody;
 class tgSpringCableAnchor;
 class tgBulletSpringCableAnchor;
+class tgBulletSpringCableBatch;
 
 /**
  * This class defines the passive dynamics of a spring-cable system
@@ -55,14 +56,19 @@ public:
      * @param[in] coefK - the stiffness of the spring. Must be positive
      * @param[in] dampingCoefficient - the damping in the spring. Must be non-negative
      * @param[in] pretension - must be small enough to keep the rest length positive
+     * @param[in] batch - if not NULL, the world's tgBulletSpringCableBatch,
+     * which then finds this cable's length and applies its force. Only for
+     * cables between two pin anchors.
      */
     tgBulletSpringCable( const std::vector<tgBulletSpringCableAnchor*>& anchors,
                 double coefK,
                 double dampingCoefficient,
-                double pretension = 0.0);
+                double pretension = 0.0,
+                tgBulletSpringCableBatch* batch = NULL);
     
     /**
-     * The virtual destructor. Deletes all of the anchors including anchor1 and anchor2
+     * The virtual destructor. Deletes all of the anchors including anchor1
+     * and anchor2, and leaves the batch if there is one
      */
     virtual ~tgBulletSpringCable();
 
@@ -92,6 +98,15 @@ public:
      * @todo figure out how to cast and pass by reference
      */
     virtual const std::vector<const tgSpringCableAnchor*> getAnchors() const;
+
+    /**
+     * A batched cable queues its forces in the tgBulletSpringCableBatch
+     * @return true if this cable has a batch
+     */
+    virtual bool canStepConcurrently() const
+    {
+        return m_pBatch != NULL;
+    }
     
 protected:
     
@@ -124,6 +139,21 @@ private:
      */
     virtual void calculateAndApplyForce(double dt);
 
+    /**
+     * The spring-damper law. Updates the velocity, damping and previous
+     * length from the current length.
+     * @return the tension to apply, or zero if the cable is slack
+     */
+    double calculateForceMagnitude(double currLength, double dt);
+
+private:
+
+    /** The world's batch, or NULL if this cable applies its own force */
+    tgBulletSpringCableBatch* const m_pBatch;
+
+    /** This cable's slot in m_pBatch, kept up to date by the batch */
+    std::size_t m_batchSlot;
+
 private: 
     /** Ensures integrity of member variables */
     bool invariant(void) const;
@@ -101,6 +101,16 @@ public:
      * @return a btVector3 in body coordinates
      */
     virtual btVector3 getRelativePosition() const;
+
+    /**
+     * The attachment point in the body's own frame, as it was when the
+     * anchor was created. Only sliding anchors ever change it.
+     * @return a btVector3 in body coordinates
+     */
+    const btVector3& getLocalPosition() const
+    {
+        return attachedRelativeOriginalPosition;
+    }
     
     /**
      * Return an up to date contact normal based on the rigid
@@ -0,0 +1,88 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBulletSpringCableAnchorPool.cpp
+ * @brief Definitions of members of class tgBulletSpringCableAnchorPool
+ * $Id$
+ */
+
+// This module
+#include "tgBulletSpringCableAnchorPool.h"
+#include "tgBulletSpringCableAnchor.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cassert>
+#include <new>
+
+tgBulletSpringCableAnchorPool::tgBulletSpringCableAnchorPool() :
+m_live(0)
+{
+}
+
+tgBulletSpringCableAnchorPool::~tgBulletSpringCableAnchorPool()
+{
+    assert(m_live == 0);
+    for (std::size_t i = 0; i < m_free.size(); i++)
+    {
+        ::operator delete(m_free[i]);
+    }
+}
+
+tgBulletSpringCableAnchor*
+tgBulletSpringCableAnchorPool::create(btRigidBody* body,
+                                      const btVector3& pos,
+                                      const btVector3& cn,
+                                      btPersistentManifold* m)
+{
+    void* pBlock;
+    if (m_free.empty())
+    {
+        pBlock = ::operator new(sizeof(tgBulletSpringCableAnchor));
+    }
+    else
+    {
+        pBlock = m_free.back();
+        m_free.pop_back();
+    }
+
+    tgBulletSpringCableAnchor* pAnchor;
+    try
+    {
+        pAnchor = new (pBlock) tgBulletSpringCableAnchor(body, pos, cn, false, true, m);
+    }
+    catch (...)
+    {
+        m_free.push_back(pBlock);
+        throw;
+    }
+    m_live++;
+    return pAnchor;
+}
+
+void tgBulletSpringCableAnchorPool::destroy(tgBulletSpringCableAnchor* pAnchor)
+{
+    assert(pAnchor != NULL && !pAnchor->permanent);
+    assert(m_live > 0);
+    // Make room first, so that nothing can throw once it is destroyed
+    m_free.reserve(m_free.size() + 1);
+    pAnchor->~tgBulletSpringCableAnchor();
+    m_free.push_back(pAnchor);
+    m_live--;
+}
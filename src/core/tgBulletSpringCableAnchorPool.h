@@ -0,0 +1,92 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
+#define SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
+
+/**
+ * @file tgBulletSpringCableAnchorPool.h
+ * @brief Definition of class tgBulletSpringCableAnchorPool
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward references
+class btPersistentManifold;
+class btRigidBody;
+class btVector3;
+class tgBulletSpringCableAnchor;
+
+/**
+ * Recycles the storage of the sliding anchors of a
+ * tgBulletContactSpringCable, which come and go with the contacts, often
+ * within a single step. Anchors made by create() must be destroyed by
+ * the same pool's destroy(), never deleted.
+ */
+class tgBulletSpringCableAnchorPool
+{
+public:
+
+    tgBulletSpringCableAnchorPool();
+
+    /** Frees the recycled storage. All anchors must be destroyed. */
+    ~tgBulletSpringCableAnchorPool();
+
+    /**
+     * @return a new sliding, non-permanent anchor, as constructed by
+     * tgBulletSpringCableAnchor(body, pos, cn, false, true, m)
+     */
+    tgBulletSpringCableAnchor* create(btRigidBody* body,
+                                      const btVector3& pos,
+                                      const btVector3& cn,
+                                      btPersistentManifold* m);
+
+    /**
+     * Destroy an anchor made by create() and keep its storage
+     * @param[in] pAnchor the anchor; must not be used again
+     */
+    void destroy(tgBulletSpringCableAnchor* pAnchor);
+
+    /** @return the number of anchors that are live, made and not destroyed */
+    std::size_t live() const
+    {
+        return m_live;
+    }
+
+    /** @return the number of blocks of storage waiting for reuse */
+    std::size_t spare() const
+    {
+        return m_free.size();
+    }
+
+private:
+
+    /** Storage of destroyed anchors */
+    std::vector<void*> m_free;
+
+    std::size_t m_live;
+
+    // Not copyable
+    tgBulletSpringCableAnchorPool(const tgBulletSpringCableAnchorPool&);
+    tgBulletSpringCableAnchorPool& operator=(const tgBulletSpringCableAnchorPool&);
+};
+
+#endif // SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
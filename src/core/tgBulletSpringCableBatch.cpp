@@ -0,0 +1,385 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBulletSpringCableBatch.cpp
+ * @brief Definitions of members of class tgBulletSpringCableBatch
+ * $Id$
+ */
+
+// This module
+#include "tgBulletSpringCableBatch.h"
+#include "tgBulletSpringCableAnchor.h"
+// The Bullet Physics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btMatrix3x3.h"
+#include "LinearMath/btTransform.h"
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+// Lets the compiler assume the field arrays do not overlap, so it can
+// vectorize without run time alias checks for every pair of them
+#ifdef __GNUC__
+#define TG_RESTRICT __restrict__
+#else
+#define TG_RESTRICT
+#endif
+
+namespace
+{
+    // The loops below use plain arrays, with no branches or calls, so the
+    // compiler can vectorize them. Each expression is evaluated in the
+    // same order as the btVector3 and btTransform operators that
+    // tgBulletSpringCable uses, so the results are the same to the last
+    // bit.
+
+    /**
+     * The world positions of anchors, and their positions relative to
+     * the centers of mass: w = basis * local + origin, r = w - origin.
+     */
+    void transformAnchors(std::size_t n,
+                          const double* TG_RESTRICT lx,
+                          const double* TG_RESTRICT ly,
+                          const double* TG_RESTRICT lz,
+                          const double* TG_RESTRICT m00,
+                          const double* TG_RESTRICT m01,
+                          const double* TG_RESTRICT m02,
+                          const double* TG_RESTRICT m10,
+                          const double* TG_RESTRICT m11,
+                          const double* TG_RESTRICT m12,
+                          const double* TG_RESTRICT m20,
+                          const double* TG_RESTRICT m21,
+                          const double* TG_RESTRICT m22,
+                          const double* TG_RESTRICT ox,
+                          const double* TG_RESTRICT oy,
+                          const double* TG_RESTRICT oz,
+                          double* TG_RESTRICT wx,
+                          double* TG_RESTRICT wy,
+                          double* TG_RESTRICT wz,
+                          double* TG_RESTRICT rx,
+                          double* TG_RESTRICT ry,
+                          double* TG_RESTRICT rz)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            wx[i] = (lx[i] * m00[i] + ly[i] * m01[i] + lz[i] * m02[i]) + ox[i];
+            wy[i] = (lx[i] * m10[i] + ly[i] * m11[i] + lz[i] * m12[i]) + oy[i];
+            wz[i] = (lx[i] * m20[i] + ly[i] * m21[i] + lz[i] * m22[i]) + oz[i];
+            rx[i] = wx[i] - ox[i];
+            ry[i] = wy[i] - oy[i];
+            rz[i] = wz[i] - oz[i];
+        }
+    }
+
+    /** The length and the unit vector of each cable, from A to B. */
+    void measureCables(std::size_t n,
+                       const double* TG_RESTRICT ax,
+                       const double* TG_RESTRICT ay,
+                       const double* TG_RESTRICT az,
+                       const double* TG_RESTRICT bx,
+                       const double* TG_RESTRICT by,
+                       const double* TG_RESTRICT bz,
+                       double* TG_RESTRICT ux,
+                       double* TG_RESTRICT uy,
+                       double* TG_RESTRICT uz,
+                       double* TG_RESTRICT length)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            ux[i] = bx[i] - ax[i];
+            uy[i] = by[i] - ay[i];
+            uz[i] = bz[i] - az[i];
+            length[i] = ux[i] * ux[i] + uy[i] * uy[i] + uz[i] * uz[i];
+        }
+
+        // On its own, since sqrt may set errno
+        for (std::size_t i = 0; i < n; i++)
+        {
+            length[i] = std::sqrt(length[i]);
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double inverse = 1.0 / length[i];
+            ux[i] *= inverse;
+            uy[i] *= inverse;
+            uz[i] *= inverse;
+        }
+    }
+}
+
+tgBulletSpringCableBatch::tgBulletSpringCableBatch() :
+    m_current(false)
+{
+    if (pthread_key_create(&m_laneKey, NULL) != 0)
+    {
+        throw std::runtime_error("Cannot create the cable batch lane key.");
+    }
+}
+
+tgBulletSpringCableBatch::~tgBulletSpringCableBatch()
+{
+    pthread_key_delete(m_laneKey);
+}
+
+void tgBulletSpringCableBatch::add(const tgBulletSpringCableAnchor& anchor1,
+                                   const tgBulletSpringCableAnchor& anchor2,
+                                   std::size_t* pSlot)
+{
+    if (pSlot == NULL)
+    {
+        throw std::invalid_argument("Pointer to slot is NULL");
+    }
+    else if (anchor1.sliding || anchor2.sliding)
+    {
+        throw std::invalid_argument("Batched cables cannot have sliding anchors");
+    }
+
+    *pSlot = m_bodyA.size();
+    m_bodyA.push_back(anchor1.attachedBody);
+    m_bodyB.push_back(anchor2.attachedBody);
+    m_slotRefs.push_back(pSlot);
+
+    for (int f = 0; f < eNumFields; f++)
+    {
+        m_field[f].push_back(0.0);
+    }
+    const btVector3& localA = anchor1.getLocalPosition();
+    const btVector3& localB = anchor2.getLocalPosition();
+    m_field[eLocalAX][*pSlot] = localA.x();
+    m_field[eLocalAY][*pSlot] = localA.y();
+    m_field[eLocalAZ][*pSlot] = localA.z();
+    m_field[eLocalBX][*pSlot] = localB.x();
+    m_field[eLocalBY][*pSlot] = localB.y();
+    m_field[eLocalBZ][*pSlot] = localB.z();
+
+    m_current = false;
+}
+
+void tgBulletSpringCableBatch::remove(std::size_t slot)
+{
+    assert(slot < size());
+
+    // Drop this cable's queued force
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_queue.size(); i++)
+    {
+        if (m_queue[i].slot != slot)
+        {
+            m_queue[kept++] = m_queue[i];
+        }
+    }
+    m_queue.resize(kept);
+
+    // Move the last cable into the hole
+    const std::size_t last = size() - 1;
+    if (slot != last)
+    {
+        m_bodyA[slot] = m_bodyA[last];
+        m_bodyB[slot] = m_bodyB[last];
+        m_slotRefs[slot] = m_slotRefs[last];
+        *m_slotRefs[slot] = slot;
+        for (int f = 0; f < eNumFields; f++)
+        {
+            m_field[f][slot] = m_field[f][last];
+        }
+        for (std::size_t i = 0; i < m_queue.size(); i++)
+        {
+            if (m_queue[i].slot == last)
+            {
+                m_queue[i].slot = slot;
+            }
+        }
+    }
+
+    m_bodyA.pop_back();
+    m_bodyB.pop_back();
+    m_slotRefs.pop_back();
+    for (int f = 0; f < eNumFields; f++)
+    {
+        m_field[f].pop_back();
+    }
+}
+
+void tgBulletSpringCableBatch::update()
+{
+    if (size() != 0)
+    {
+        gatherTransforms();
+        computeGeometry();
+    }
+    m_current = true;
+}
+
+void tgBulletSpringCableBatch::openLanes(std::size_t n)
+{
+    if (!m_current)
+    {
+        update();
+    }
+    m_lanes.resize(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_lanes[i].clear();
+    }
+}
+
+void tgBulletSpringCableBatch::selectLane(std::size_t lane)
+{
+    assert(lane < m_lanes.size());
+    pthread_setspecific(m_laneKey, &m_lanes[lane]);
+}
+
+void tgBulletSpringCableBatch::deselectLane()
+{
+    pthread_setspecific(m_laneKey, NULL);
+}
+
+void tgBulletSpringCableBatch::closeLanes()
+{
+    for (std::size_t i = 0; i < m_lanes.size(); i++)
+    {
+        m_queue.insert(m_queue.end(), m_lanes[i].begin(), m_lanes[i].end());
+        m_lanes[i].clear();
+    }
+}
+
+void tgBulletSpringCableBatch::queueForce(std::size_t slot,
+                                          double magnitude,
+                                          double dt)
+{
+    assert(slot < size());
+    QueuedForce queued;
+    queued.slot = slot;
+    queued.magnitude = magnitude;
+    queued.dt = dt;
+
+    std::vector<QueuedForce>* const pLane =
+        static_cast<std::vector<QueuedForce>*>(pthread_getspecific(m_laneKey));
+    if (pLane)
+    {
+        pLane->push_back(queued);
+    }
+    else
+    {
+        m_queue.push_back(queued);
+    }
+}
+
+void tgBulletSpringCableBatch::applyImpulses()
+{
+    // The fields are empty in worlds without batched cables
+    if (m_queue.empty())
+    {
+        return;
+    }
+    const double* const ux = &m_field[eUnitX][0];
+    const double* const uy = &m_field[eUnitY][0];
+    const double* const uz = &m_field[eUnitZ][0];
+    const std::size_t n = m_queue.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const QueuedForce& queued = m_queue[i];
+        const std::size_t s = queued.slot;
+
+        // A slack cable still wakes its bodies
+        btVector3 force(0.0, 0.0, 0.0);
+        if (queued.magnitude != 0.0)
+        {
+            force = btVector3(ux[s], uy[s], uz[s]) * queued.magnitude;
+        }
+
+        const btVector3 relA(m_field[eRelAX][s],
+                             m_field[eRelAY][s],
+                             m_field[eRelAZ][s]);
+        m_bodyA[s]->activate();
+        m_bodyA[s]->applyImpulse(force * queued.dt, relA);
+
+        const btVector3 relB(m_field[eRelBX][s],
+                             m_field[eRelBY][s],
+                             m_field[eRelBZ][s]);
+        m_bodyB[s]->activate();
+        m_bodyB[s]->applyImpulse(-force * queued.dt, relB);
+    }
+    m_queue.clear();
+}
+
+void tgBulletSpringCableBatch::gatherTransforms()
+{
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const btTransform& trA = m_bodyA[i]->getWorldTransform();
+        const btMatrix3x3& basisA = trA.getBasis();
+        m_field[eBasisA00][i] = basisA[0].x();
+        m_field[eBasisA01][i] = basisA[0].y();
+        m_field[eBasisA02][i] = basisA[0].z();
+        m_field[eBasisA10][i] = basisA[1].x();
+        m_field[eBasisA11][i] = basisA[1].y();
+        m_field[eBasisA12][i] = basisA[1].z();
+        m_field[eBasisA20][i] = basisA[2].x();
+        m_field[eBasisA21][i] = basisA[2].y();
+        m_field[eBasisA22][i] = basisA[2].z();
+        m_field[eOriginAX][i] = trA.getOrigin().x();
+        m_field[eOriginAY][i] = trA.getOrigin().y();
+        m_field[eOriginAZ][i] = trA.getOrigin().z();
+
+        const btTransform& trB = m_bodyB[i]->getWorldTransform();
+        const btMatrix3x3& basisB = trB.getBasis();
+        m_field[eBasisB00][i] = basisB[0].x();
+        m_field[eBasisB01][i] = basisB[0].y();
+        m_field[eBasisB02][i] = basisB[0].z();
+        m_field[eBasisB10][i] = basisB[1].x();
+        m_field[eBasisB11][i] = basisB[1].y();
+        m_field[eBasisB12][i] = basisB[1].z();
+        m_field[eBasisB20][i] = basisB[2].x();
+        m_field[eBasisB21][i] = basisB[2].y();
+        m_field[eBasisB22][i] = basisB[2].z();
+        m_field[eOriginBX][i] = trB.getOrigin().x();
+        m_field[eOriginBY][i] = trB.getOrigin().y();
+        m_field[eOriginBZ][i] = trB.getOrigin().z();
+    }
+}
+
+void tgBulletSpringCableBatch::computeGeometry()
+{
+    const std::size_t n = size();
+    transformAnchors(n,
+                     &m_field[eLocalAX][0], &m_field[eLocalAY][0], &m_field[eLocalAZ][0],
+                     &m_field[eBasisA00][0], &m_field[eBasisA01][0], &m_field[eBasisA02][0],
+                     &m_field[eBasisA10][0], &m_field[eBasisA11][0], &m_field[eBasisA12][0],
+                     &m_field[eBasisA20][0], &m_field[eBasisA21][0], &m_field[eBasisA22][0],
+                     &m_field[eOriginAX][0], &m_field[eOriginAY][0], &m_field[eOriginAZ][0],
+                     &m_field[eWorldAX][0], &m_field[eWorldAY][0], &m_field[eWorldAZ][0],
+                     &m_field[eRelAX][0], &m_field[eRelAY][0], &m_field[eRelAZ][0]);
+    transformAnchors(n,
+                     &m_field[eLocalBX][0], &m_field[eLocalBY][0], &m_field[eLocalBZ][0],
+                     &m_field[eBasisB00][0], &m_field[eBasisB01][0], &m_field[eBasisB02][0],
+                     &m_field[eBasisB10][0], &m_field[eBasisB11][0], &m_field[eBasisB12][0],
+                     &m_field[eBasisB20][0], &m_field[eBasisB21][0], &m_field[eBasisB22][0],
+                     &m_field[eOriginBX][0], &m_field[eOriginBY][0], &m_field[eOriginBZ][0],
+                     &m_field[eWorldBX][0], &m_field[eWorldBY][0], &m_field[eWorldBZ][0],
+                     &m_field[eRelBX][0], &m_field[eRelBY][0], &m_field[eRelBZ][0]);
+    measureCables(n,
+                  &m_field[eWorldAX][0], &m_field[eWorldAY][0], &m_field[eWorldAZ][0],
+                  &m_field[eWorldBX][0], &m_field[eWorldBY][0], &m_field[eWorldBZ][0],
+                  &m_field[eUnitX][0], &m_field[eUnitY][0], &m_field[eUnitZ][0],
+                  &m_field[eLength][0]);
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_CORE_TG_BULLET_SPRING_CABLE_BATCH_H_
+#define SRC_CORE_TG_BULLET_SPRING_CABLE_BATCH_H_
+
+/**
+ * @file tgBulletSpringCableBatch.h
+ * @brief Definition of class tgBulletSpringCableBatch
+ * $Id$
+ */
+
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+// POSIX threads
+#include <pthread.h>
+
+// Forward references
+class btRigidBody;
+class tgBulletSpringCableAnchor;
+
+/**
+ * The world's registry of two-anchor tgBulletSpringCables. It keeps the
+ * anchor bodies and offsets of every registered cable in contiguous
+ * arrays, one per coordinate, so that the anchor positions, lengths and
+ * directions of all cables are found in one pass, when the first cable
+ * steps after the bodies moved. Each cable then applies its own force
+ * law to its slot's length and queues the result; the queued impulses
+ * are applied to the bodies in a second pass, in the order the cables
+ * were stepped.
+ *
+ * The world step, tgWorld::restoreState() and add() mark the lengths as
+ * out of date, so bodies moved by the world or by the models before the
+ * cables step are seen. The lengths are then the ones each cable would
+ * have found itself, and the forces the same as when every cable applied
+ * its own, as long as no body moves while the cables step.
+ *
+ * Cables may also be stepped on several threads at once: between
+ * openLanes() and closeLanes() each thread queues into the lane it
+ * selected, and closeLanes() appends the lanes in order, so the impulses
+ * are applied in the same order as if the cables had been stepped one
+ * after another.
+ *
+ * Owned by tgWorldBulletPhysicsImpl.
+ */
+class tgBulletSpringCableBatch
+{
+public:
+
+    tgBulletSpringCableBatch();
+
+    ~tgBulletSpringCableBatch();
+
+    /**
+     * Register a cable between two pin anchors.
+     * @param[in] anchor1 the anchor the force pulls toward anchor2
+     * @param[in] anchor2 the other anchor
+     * @param[in,out] pSlot where the caller keeps its slot number. It is
+     * set now, and updated if the slot moves when another cable is
+     * removed. Must stay valid until remove().
+     * @throw std::invalid_argument if pSlot is NULL or an anchor slides
+     */
+    void add(const tgBulletSpringCableAnchor& anchor1,
+             const tgBulletSpringCableAnchor& anchor2,
+             std::size_t* pSlot);
+
+    /**
+     * Unregister a cable. Any impulse it has queued is dropped.
+     * @param[in] slot the slot set by add()
+     */
+    void remove(std::size_t slot);
+
+    /** @return the number of registered cables */
+    std::size_t size() const { return m_bodyA.size(); }
+
+    /**
+     * Find the anchor positions, length and direction of every cable
+     * from the current body transforms.
+     */
+    void update();
+
+    /**
+     * Mark the lengths as out of date, because bodies have moved. The
+     * next length() or openLanes() call calls update().
+     */
+    void invalidate() { m_current = false; }
+
+    /**
+     * @param[in] slot a slot set by add()
+     * @return the distance between the cable's anchors
+     */
+    double length(std::size_t slot)
+    {
+        if (!m_current)
+        {
+            update();
+        }
+        return m_field[eLength][slot];
+    }
+
+    /**
+     * Prepare n lanes for queueForce() calls from several threads, and
+     * bring the lengths up to date so that length() does not write.
+     * @param[in] n the number of lanes
+     */
+    void openLanes(std::size_t n);
+
+    /**
+     * Make the calling thread queue into a lane until deselectLane().
+     * @param[in] lane less than the n given to openLanes()
+     */
+    void selectLane(std::size_t lane);
+
+    /** Make the calling thread queue into the main queue again. */
+    void deselectLane();
+
+    /**
+     * Append the lanes to the queue, lane 0 first, and empty them.
+     * Call after every thread has deselected its lane.
+     */
+    void closeLanes();
+
+    /**
+     * Queue the force a cable applies this step. Applied by
+     * applyImpulses(). Goes into the calling thread's lane, if it has
+     * selected one.
+     * @param[in] slot a slot set by add()
+     * @param[in] magnitude the tension along the cable; zero if it is slack
+     * @param[in] dt the step the force acts over
+     */
+    void queueForce(std::size_t slot, double magnitude, double dt);
+
+    /**
+     * Apply the queued forces as impulses on the anchor bodies, in the
+     * order they were queued, and clear the queue.
+     */
+    void applyImpulses();
+
+private:
+
+    /** The per-cable arrays, one entry per slot each. */
+    enum Field
+    {
+        // Anchor positions in body coordinates
+        eLocalAX, eLocalAY, eLocalAZ,
+        eLocalBX, eLocalBY, eLocalBZ,
+        // Body transforms, gathered at the start of update()
+        eBasisA00, eBasisA01, eBasisA02,
+        eBasisA10, eBasisA11, eBasisA12,
+        eBasisA20, eBasisA21, eBasisA22,
+        eOriginAX, eOriginAY, eOriginAZ,
+        eBasisB00, eBasisB01, eBasisB02,
+        eBasisB10, eBasisB11, eBasisB12,
+        eBasisB20, eBasisB21, eBasisB22,
+        eOriginBX, eOriginBY, eOriginBZ,
+        // Results of update(): anchors in world coordinates and relative
+        // to the centers of mass, the unit vector from A to B, and the
+        // length
+        eWorldAX, eWorldAY, eWorldAZ,
+        eWorldBX, eWorldBY, eWorldBZ,
+        eRelAX, eRelAY, eRelAZ,
+        eRelBX, eRelBY, eRelBZ,
+        eUnitX, eUnitY, eUnitZ,
+        eLength,
+        eNumFields
+    };
+
+    /** A force waiting for applyImpulses() */
+    struct QueuedForce
+    {
+        std::size_t slot;
+        double magnitude;
+        double dt;
+    };
+
+    /** Copy every body transform into the basis and origin fields. */
+    void gatherTransforms();
+
+    /** The arithmetic of update(), over the gathered transforms. */
+    void computeGeometry();
+
+    // Not copyable
+    tgBulletSpringCableBatch(const tgBulletSpringCableBatch&);
+    tgBulletSpringCableBatch& operator=(const tgBulletSpringCableBatch&);
+
+private:
+
+    std::vector<btRigidBody*> m_bodyA;
+    std::vector<btRigidBody*> m_bodyB;
+
+    /** Each owner's slot number, so it can follow a moved slot. */
+    std::vector<std::size_t*> m_slotRefs;
+
+    std::vector<double> m_field[eNumFields];
+
+    std::vector<QueuedForce> m_queue;
+
+    /** Per-thread queues, see openLanes() */
+    std::vector<std::vector<QueuedForce> > m_lanes;
+
+    /** Each thread's selected lane, as a pointer into m_lanes */
+    pthread_key_t m_laneKey;
+
+    /** True if the results of update() match the body transforms */
+    bool m_current;
+};
+
+#endif  // SRC_CORE_TG_BULLET_SPRING_CABLE_BATCH_H_
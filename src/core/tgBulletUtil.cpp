@@ -88,3 +88,12 @@ btDynamicsWorld& tgBulletUtil::worldToDynamicsWorld(const tgWorld& world)
   btDynamicsWorld& result = bulletPhysicsImpl.dynamicsWorld();
   return result;
 }
+
+tgBulletSpringCableBatch& tgBulletUtil::worldToCableBatch(const tgWorld& world)
+{
+  tgWorldImpl& impl = world.implementation();
+  // As above, avoid dynamic_cast
+  tgWorldBulletPhysicsImpl& bulletPhysicsImpl =
+    static_cast<tgWorldBulletPhysicsImpl&>(impl);
+  return bulletPhysicsImpl.cableBatch();
+}
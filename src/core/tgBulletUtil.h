@@ -31,6 +31,7 @@ class btCollisionShape;
 class btDynamicsWorld;
 class btRigidBody;
 class btTransform;
+class tgBulletSpringCableBatch;
 class tgWorld;
 
 /**
@@ -54,6 +55,14 @@ public:
      * @todo consider implications of casting to include Corde objects
      */
     static btDynamicsWorld& worldToDynamicsWorld(const tgWorld& world);
+
+    /**
+     * Assuming that world has a tgWorldBulletPhysicsImpl, return
+     * its registry of batched spring cables.
+     * @param[in] world a tgWorld
+     * @return the world's implementation's tgBulletSpringCableBatch
+     */
+    static tgBulletSpringCableBatch& worldToCableBatch(const tgWorld& world);
 };
 
 
@@ -166,6 +166,24 @@ void tgCompressionSpringActuator::step(double dt)
     }
 }
 
+void tgCompressionSpringActuator::saveState(std::vector<double>& state) const
+{
+    m_compressionSpring->saveState(state);
+    notifySaveState(state);
+    tgModel::saveState(state);
+}
+
+void tgCompressionSpringActuator::restoreState(const std::vector<double>& state,
+                                               std::size_t& pos)
+{
+    m_compressionSpring->restoreState(state, pos);
+    notifyRestoreState(state, pos);
+    tgModel::restoreState(state, pos);
+
+    // Postcondition
+    assert(invariant());
+}
+
 // Renders the spring in the NTRT window
 void tgCompressionSpringActuator::onVisit(const tgModelVisitor& r) const
 {
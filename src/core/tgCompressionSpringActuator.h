@@ -38,6 +38,10 @@
 // for history logging
 #include <deque>
 
+// for saving and restoring state
+#include <cstddef>
+#include <vector>
+
 // Forward declarations
 class tgBulletCompressionSpring;
 class tgModelVisitor;
@@ -180,6 +184,21 @@ public:
    * @param[in] r, the visiting tgModelVisitor
    */
   virtual void onVisit(const tgModelVisitor& r) const;
+
+  /**
+   * Appends the state of the spring and of any observers, then the
+   * children.
+   * @param[out] state the buffer to append to
+   */
+  virtual void saveState(std::vector<double>& state) const;
+
+  /**
+   * Read back the values appended by saveState, in the same order
+   * @param[in] state the buffer written by saveState
+   * @param[in,out] pos the read position
+   */
+  virtual void restoreState(const std::vector<double>& state,
+                            std::size_t& pos);
     
   /**
    * Functions for interfacing with tgBulletCompressionSpring.
@@ -145,17 +145,50 @@ void tgKinematicActuator::step(double dt)
     {   
         // Want to update any controls before applying forces
         notifyStep(dt); 
-        // Adjust rest length based on muscle dynamics
-        integrateRestLength(dt);
-        m_springCable->step(dt);
-        logHistory();  
-        tgModel::step(dt);
+        if (!dynamicsDeferred())
+        {
+            stepDynamics(dt);
+        }
     }
+}
+
+void tgKinematicActuator::stepDynamics(double dt)
+{
+    // Adjust rest length based on muscle dynamics
+    integrateRestLength(dt);
+    m_springCable->step(dt);
+    logHistory();  
+    tgModel::step(dt);
     
     // Reset and wait for next control input
     m_desiredTorque = 0.0;
 }
 
+void tgKinematicActuator::saveState(std::vector<double>& state) const
+{
+    state.push_back(prevVel);
+    state.push_back(m_motorVel);
+    state.push_back(m_motorAcc);
+    state.push_back(m_desiredTorque);
+    state.push_back(m_appliedTorque);
+    tgSpringCableActuator::saveState(state);
+}
+
+void tgKinematicActuator::restoreState(const std::vector<double>& state,
+                                       std::size_t& pos)
+{
+    if (pos + 5 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgKinematicActuator");
+    }
+    prevVel = state[pos++];
+    m_motorVel = state[pos++];
+    m_motorAcc = state[pos++];
+    m_desiredTorque = state[pos++];
+    m_appliedTorque = state[pos++];
+    tgSpringCableActuator::restoreState(state, pos);
+}
+
 void tgKinematicActuator::onVisit(const tgModelVisitor& r) const
 {
 #ifndef BT_NO_PROFILE 
@@ -168,13 +201,13 @@ void tgKinematicActuator::logHistory()
 {
     m_prevVelocity = getVelocity();
 
-    if (m_config.hist)
+    if (m_config.hist || m_config.histStats)
     {
-        m_pHistory->lastLengths.push_back(m_springCable->getActualLength());
-        m_pHistory->lastVelocities.push_back(m_motorVel);
-        m_pHistory->dampingHistory.push_back(m_springCable->getDamping());
-        m_pHistory->restLengths.push_back(m_springCable->getRestLength());
-        m_pHistory->tensionHistory.push_back(m_appliedTorque);
+        recordHistory(m_springCable->getActualLength(),
+                      m_motorVel,
+                      m_springCable->getDamping(),
+                      m_springCable->getRestLength(),
+                      m_appliedTorque);
     }
 }
     
@@ -30,14 +30,18 @@
 // The C++ Standard Library
 #include <stdexcept>
 
-tgModel::tgModel()
+tgModel::tgModel() :
+  m_pParent(NULL),
+  m_descendantsValid(false)
 {
   // Postcondition
   assert(invariant());
 }
 
 tgModel::tgModel(const tgTags& tags) :
-        tgTaggable(tags)
+        tgTaggable(tags),
+        m_pParent(NULL),
+        m_descendantsValid(false)
 {
   assert(invariant());
 }
@@ -73,6 +77,7 @@ void tgModel::teardown()
     delete m_children[i];
   }
   m_children.clear();
+  invalidateDescendants();
   //Clear the markers
   this->m_markers.clear();
 
@@ -130,17 +135,26 @@ void tgModel::addChild(tgModel* pChild)
   {
     throw std::invalid_argument("child is this object");
   } 
+  else if (pChild->m_pParent != NULL)
+  {
+    // Its parent owns it and indexes it among its descendants
+    throw std::invalid_argument("child already has a parent");
+  }
   else 
   {
-    const std::vector<tgModel*> descendants = getDescendants();
-    if (std::find(descendants.begin(), descendants.end(), pChild) !=
-    descendants.end())
+    // Adding an ancestor would make a cycle
+    for (const tgModel* p = m_pParent; p != NULL; p = p->m_pParent)
     {
-      throw std::invalid_argument("child is already a descendant");
+      if (p == pChild)
+      {
+        throw std::invalid_argument("child is an ancestor of this object");
+      }
     }
   }
 
   m_children.push_back(pChild);
+  pChild->m_pParent = this;
+  invalidateDescendants();
 
   // Postcondition
   assert(invariant());
@@ -163,13 +177,20 @@ std::string tgModel::toString(std::string prefix) const
   return os.str();
 }
 
-/**
- * @todo Unnecessary copying can be avoided by pasing the result
- * collection in the recursive step.
- */
-std::vector<tgModel*> tgModel::getDescendants() const
+const std::vector<tgModel*>& tgModel::getDescendants() const
+{
+  if (!m_descendantsValid)
+  {
+    m_descendants.clear();
+    m_descendantsByType.clear();
+    appendDescendants(m_descendants);
+    m_descendantsValid = true;
+  }
+  return m_descendants;
+}
+
+void tgModel::appendDescendants(std::vector<tgModel*>& result) const
 {
-  std::vector<tgModel*> result;
   const size_t n = m_children.size();
   for (std::size_t i = 0; i < n; i++)
   {
@@ -177,10 +198,19 @@ std::vector<tgModel*> tgModel::getDescendants() const
     assert(pChild != NULL);
     result.push_back(pChild);
     // Recursion
-    const std::vector<tgModel*> cd = pChild->getDescendants();
-    result.insert(result.end(), cd.begin(), cd.end());
+    pChild->appendDescendants(result);
+  }
+}
+
+void tgModel::invalidateDescendants()
+{
+  // Every ancestor's index holds our descendants
+  for (tgModel* p = this; p != NULL; p = p->m_pParent)
+  {
+    p->m_descendantsValid = false;
+    p->m_descendants.clear();
+    p->m_descendantsByType.clear();
   }
-  return result;
 }
 
 /**
@@ -192,7 +222,7 @@ std::vector<tgSenseable*> tgModel::getSenseableDescendants() const
 {
   // TO-DO: why can't we just return the results of getDescendants?
   // There seems to be some polymorphism issue here...
-  std::vector<tgModel*> myDescendants = getDescendants();
+  const std::vector<tgModel*>& myDescendants = getDescendants();
   std::vector<tgSenseable*> mySenseableDescendants;
   for (size_t i=0; i < myDescendants.size(); i++) {
     mySenseableDescendants.push_back(myDescendants[i]);
@@ -200,6 +230,27 @@ std::vector<tgSenseable*> tgModel::getSenseableDescendants() const
   return mySenseableDescendants;
 }
 
+void tgModel::saveState(std::vector<double>& state) const
+{
+  const size_t n = m_children.size();
+  for (std::size_t i = 0; i < n; i++)
+  {
+    m_children[i]->saveState(state);
+  }
+}
+
+void tgModel::restoreState(const std::vector<double>& state, std::size_t& pos)
+{
+  const size_t n = m_children.size();
+  for (std::size_t i = 0; i < n; i++)
+  {
+    m_children[i]->restoreState(state, pos);
+  }
+
+  // Postcondition
+  assert(invariant());
+}
+
 const std::vector<abstractMarker>& tgModel::getMarkers() const {
     return m_markers;
 }
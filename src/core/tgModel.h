@@ -33,6 +33,9 @@
 #include "tgSenseable.h"
 // The C++ Standard Library
 #include <iostream>
+#include <map>
+#include <string>
+#include <typeinfo>
 #include <vector>
 
 // Forward declarations
@@ -103,9 +106,9 @@ public:
     * The model takes ownership of the child sub-model and is responsible for
     * deallocating it.
     * @param[in,out] pChild a pointer to a sub-model
-    * @throw std::invalid_argument is pChild is NULL, this object, or already
-    * a descendant
-    * @todo Make sure that every child appears no more than once in the tree.
+    * @throw std::invalid_argument is pChild is NULL, this object, an
+    * ancestor of this object, or already the child of a model (this one
+    * or another), so that every model appears once in one tree
     */
     void addChild(tgModel* pChild);
 	
@@ -120,6 +123,9 @@ public:
 	/**
 	 * Get a vector of descendants sorted by type and a tagsearch.
 	 * Useful for pulling out muscle groups, or similar.
+	 * The descendants of type T are indexed the first time they are
+	 * asked for, until the tree changes; the tags are checked on each
+	 * call, since they may change without the model knowing.
 	 * @param[in] tagSearch, a tagSearch that contains the desired tags
 	 * @return a std::vector of pointers to members that match the tag
 	 * search and typename T
@@ -127,7 +133,16 @@ public:
     template <typename T>
     std::vector<T*> find(const tgTagSearch& tagSearch)
     {
-        return tgCast::find<tgModel, T>(tagSearch, getDescendants());
+        const std::vector<Found>& candidates = descendantsOfType<T>();
+        std::vector<T*> result;
+        for (std::size_t i = 0; i < candidates.size(); i++)
+        {
+            if (tagSearch.matches(*candidates[i].pModel))
+            {
+                result.push_back(static_cast<T*>(candidates[i].pObject));
+            }
+        }
+        return result;
     }
 	
 	/**
@@ -140,16 +155,38 @@ public:
     template <typename T>
     std::vector<T*> find(const std::string& tagSearch)
     {
-        return tgCast::find<tgModel, T>(tgTagSearch(tagSearch), getDescendants());
+        return find<T>(tgTagSearch(tagSearch));
     }
 
     /**
-     * Return a std::vector of const pointers to all sub-models.
+     * Return all sub-models, depth first. Kept between calls and rebuilt
+     * when a child is added or torn down anywhere below this model.
      * @todo examine whether this should be public, and perhaps create
      * a read only version
-     * @return a std::vector of const pointers all sub-models.
+     * @return a std::vector of pointers to all sub-models, valid until
+     * the tree changes
      */
-    std::vector<tgModel*> getDescendants() const;
+    const std::vector<tgModel*>& getDescendants() const;
+
+    /**
+     * Append the state this model and its descendants need to resume
+     * from the current step. Used by tgSimulation::snapshot(). Rigid
+     * bodies are saved by the world, so subclasses only append what
+     * Bullet does not hold, then call this function for the children.
+     * @param[out] state the buffer to append to
+     */
+    virtual void saveState(std::vector<double>& state) const;
+
+    /**
+     * Read back the state appended by saveState(), in the same order.
+     * Used by tgSimulation::restore(). The model tree must not have
+     * changed since the state was saved.
+     * @param[in] state the buffer written by saveState()
+     * @param[in,out] pos the read position, advanced past this model
+     * and its descendants
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
 
     const std::vector<abstractMarker>& getMarkers() const;
 
@@ -165,6 +202,50 @@ public:
 
 private:
 
+    /** A descendant of some type, as found by descendantsOfType() */
+    struct Found
+    {
+        /** The descendant as the type, cast back with static_cast */
+        void* pObject;
+        tgModel* pModel;
+    };
+
+    /**
+     * @return the descendants that are of type T, in the order of
+     * getDescendants(), valid until the tree changes
+     */
+    template <typename T>
+    const std::vector<Found>& descendantsOfType() const
+    {
+        const std::vector<tgModel*>& descendants = getDescendants();
+        const std::string key = typeid(T).name();
+        std::map<std::string, std::vector<Found> >::iterator it =
+            m_descendantsByType.find(key);
+        if (it == m_descendantsByType.end())
+        {
+            std::vector<Found> ofType;
+            for (std::size_t i = 0; i < descendants.size(); i++)
+            {
+                T* const pObject = tgCast::cast<tgModel, T>(descendants[i]);
+                if (pObject != 0)
+                {
+                    Found found;
+                    found.pObject = pObject;
+                    found.pModel = descendants[i];
+                    ofType.push_back(found);
+                }
+            }
+            it = m_descendantsByType.insert(std::make_pair(key, ofType)).first;
+        }
+        return it->second;
+    }
+
+    /** Append the sub-models to result, depth first. */
+    void appendDescendants(std::vector<tgModel*>& result) const;
+
+    /** Drop the indices of this model and its ancestors. */
+    void invalidateDescendants();
+
     /** Integrity predicate. */
     bool invariant() const;
 
@@ -179,6 +260,17 @@ private:
 
     std::vector<abstractMarker> m_markers;
 
+    /** The model this is a child of, if any */
+    tgModel* m_pParent;
+
+    /** The result of getDescendants(), if m_descendantsValid */
+    mutable std::vector<tgModel*> m_descendants;
+
+    /** The results of descendantsOfType(), by type name */
+    mutable std::map<std::string, std::vector<Found> > m_descendantsByType;
+
+    mutable bool m_descendantsValid;
+
 };
 
 /**
@@ -27,6 +27,10 @@
  * $Id$
  */
 
+// The C++ standard library
+#include <cstddef>
+#include <vector>
+
 /**
  * A mixin class which makes its derived class the Subject in the Obsever
  * design pattern. These are typically controllers.
@@ -65,6 +69,29 @@ public:
      * @param[in,out] subject the subject being observed
      */    
     virtual void onTeardown(Subject& subject) { }
+
+    /**
+     * Notify the observers when tgSimulation::snapshot() is called.
+     * Observers that carry state from one step to the next should
+     * append it here.
+     * @param[in] subject the subject being observed
+     * @param[out] state the buffer to append to
+     */
+    virtual void onSaveState(const Subject& subject,
+                             std::vector<double>& state) const { }
+
+    /**
+     * Notify the observers when tgSimulation::restore() is called.
+     * Read back what onSaveState() appended, in the same order.
+     * This is called instead of onTeardown() and onSetup(), so it is
+     * also the place to finish an episode and load new parameters.
+     * @param[in,out] subject the subject being observed
+     * @param[in] state the buffer written by onSaveState()
+     * @param[in,out] pos the read position; advance it past what was read
+     */
+    virtual void onRestoreState(Subject& subject,
+                                const std::vector<double>& state,
+                                std::size_t& pos) { }
     
 };
    
@@ -0,0 +1,166 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgParallelActuatorStepper.cpp
+ * @brief Contains the definitions of members of class
+ * tgParallelActuatorStepper
+ * $Id$
+ */
+
+// This module
+#include "tgParallelActuatorStepper.h"
+// This application
+#include "tgBulletSpringCableBatch.h"
+#include "tgBulletUtil.h"
+#include "tgCast.h"
+#include "tgModel.h"
+#include "tgSpringCableActuator.h"
+// The C++ Standard Library
+#include <cassert>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Fewer actuators than this per thread are not worth the hand-off.
+     * A cable step is a few hundred flops.
+     */
+    const std::size_t minChunkSize = 32;
+}
+
+void tgParallelActuatorStepper::Chunk::run()
+{
+    tgBulletSpringCableBatch& batch = *pBatch;
+    batch.selectLane(lane);
+    try
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            pStepper->m_actuators[i]->stepDynamics(dt);
+        }
+    }
+    catch (...)
+    {
+        batch.deselectLane();
+        throw;
+    }
+    batch.deselectLane();
+}
+
+tgParallelActuatorStepper::tgParallelActuatorStepper(std::size_t nThreads) :
+    m_pool(nThreads),
+    m_chunks(m_pool.size())
+{
+    for (std::size_t i = 0; i < m_chunks.size(); i++)
+    {
+        m_chunks[i].pStepper = this;
+        m_chunks[i].lane = i;
+    }
+}
+
+tgParallelActuatorStepper::~tgParallelActuatorStepper()
+{
+    release();
+}
+
+void tgParallelActuatorStepper::collect(const std::vector<tgModel*>& models)
+{
+    release();
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        std::vector<tgModel*> found(1, models[i]);
+        const std::vector<tgModel*> descendants = models[i]->getDescendants();
+        found.insert(found.end(), descendants.begin(), descendants.end());
+
+        for (std::size_t j = 0; j < found.size(); j++)
+        {
+            tgSpringCableActuator* const pActuator =
+                tgCast::cast<tgModel, tgSpringCableActuator>(found[j]);
+            if (pActuator && pActuator->canStepConcurrently())
+            {
+                pActuator->deferDynamics(true);
+                m_actuators.push_back(pActuator);
+            }
+        }
+    }
+}
+
+void tgParallelActuatorStepper::release()
+{
+    for (std::size_t i = 0; i < m_actuators.size(); i++)
+    {
+        m_actuators[i]->deferDynamics(false);
+    }
+    m_actuators.clear();
+}
+
+void tgParallelActuatorStepper::step(const tgWorld& world, double dt)
+{
+    const std::size_t n = m_actuators.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    std::size_t nChunks = (n + minChunkSize - 1) / minChunkSize;
+    if (nChunks > m_chunks.size())
+    {
+        nChunks = m_chunks.size();
+    }
+
+    if (nChunks <= 1)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            m_actuators[i]->stepDynamics(dt);
+        }
+        return;
+    }
+
+    tgBulletSpringCableBatch& batch = tgBulletUtil::worldToCableBatch(world);
+    batch.openLanes(nChunks);
+
+    // Contiguous ranges keep the lanes in step order
+    const std::size_t base = n / nChunks;
+    const std::size_t extra = n % nChunks;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < nChunks; i++)
+    {
+        Chunk& chunk = m_chunks[i];
+        chunk.pBatch = &batch;
+        chunk.begin = begin;
+        chunk.end = begin + base + (i < extra ? 1 : 0);
+        chunk.dt = dt;
+        begin = chunk.end;
+        m_pool.submit(&chunk);
+    }
+    assert(begin == n);
+
+    try
+    {
+        m_pool.wait();
+    }
+    catch (const std::runtime_error&)
+    {
+        // Keep what was queued, as a serial step would up to the failure
+        batch.closeLanes();
+        throw;
+    }
+    batch.closeLanes();
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_PARALLEL_ACTUATOR_STEPPER_H
+#define TG_PARALLEL_ACTUATOR_STEPPER_H
+
+/**
+ * @file tgParallelActuatorStepper.h
+ * @brief Contains the definition of class tgParallelActuatorStepper
+ * $Id$
+ */
+
+// This application
+#include "tgThreadPool.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgBulletSpringCableBatch;
+class tgModel;
+class tgSpringCableActuator;
+class tgWorld;
+
+/**
+ * Steps the dynamics of a simulation's spring cable actuators on a
+ * tgThreadPool, after the models have stepped.
+ *
+ * collect() defers the dynamics of every actuator that can step
+ * concurrently (see tgSpringCableActuator::canStepConcurrently()), so
+ * the models' step only notifies their controllers. step() then runs the
+ * deferred dynamics in contiguous chunks, one lane of the world's
+ * tgBulletSpringCableBatch per chunk. The lanes are joined in chunk
+ * order, so the impulses reach the bodies in the same order as in a
+ * serial step and the results are identical.
+ *
+ * Owned by tgSimulation.
+ */
+class tgParallelActuatorStepper
+{
+public:
+
+    /**
+     * Start the worker threads.
+     * @param[in] nThreads the number of threads; if zero, one per
+     * processor
+     */
+    tgParallelActuatorStepper(std::size_t nThreads);
+
+    /** Calls release(). */
+    ~tgParallelActuatorStepper();
+
+    /**
+     * Defer the dynamics of the eligible actuators among the models and
+     * their descendants. Call after the models are set up.
+     * @param[in] models the models to search, in step order
+     */
+    void collect(const std::vector<tgModel*>& models);
+
+    /**
+     * Hand the actuators back to their models' step. Call before the
+     * models are torn down.
+     */
+    void release();
+
+    /**
+     * Step the dynamics of the collected actuators.
+     * @param[in] world the world the actuators were set up in
+     * @param[in] dt the step, must be positive
+     */
+    void step(const tgWorld& world, double dt);
+
+    /** @return the number of actuators step() steps */
+    std::size_t size() const { return m_actuators.size(); }
+
+private:
+
+    /** A contiguous range of m_actuators, stepped into one lane. */
+    class Chunk : public tgThreadPool::Task
+    {
+    public:
+        Chunk() : pStepper(NULL), pBatch(NULL), lane(0), begin(0), end(0),
+            dt(0.0) { }
+
+        virtual void run();
+
+        tgParallelActuatorStepper* pStepper;
+        tgBulletSpringCableBatch* pBatch;
+        std::size_t lane;
+        std::size_t begin;
+        std::size_t end;
+        double dt;
+    };
+
+    friend class Chunk;
+
+    // Not copyable
+    tgParallelActuatorStepper(const tgParallelActuatorStepper&);
+    tgParallelActuatorStepper& operator=(const tgParallelActuatorStepper&);
+
+private:
+
+    tgThreadPool m_pool;
+
+    /** The deferred actuators, in step order. */
+    std::vector<tgSpringCableActuator*> m_actuators;
+
+    /** Reused every step. */
+    std::vector<Chunk> m_chunks;
+};
+
+#endif  // TG_PARALLEL_ACTUATOR_STEPPER_H
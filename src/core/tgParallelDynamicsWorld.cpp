@@ -0,0 +1,433 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgParallelDynamicsWorld.cpp
+ * @brief Contains the definitions of members of class
+ * tgParallelDynamicsWorld
+ * $Id$
+ */
+
+// This module
+#include "tgParallelDynamicsWorld.h"
+// The Bullet Physics library
+#include "BulletCollision/BroadphaseCollision/btDispatcher.h"
+#include "BulletDynamics/ConstraintSolver/btConstraintSolver.h"
+#include "BulletDynamics/ConstraintSolver/btTypedConstraint.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btTransform.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace
+{
+    /** Bodies per job below which a phase is not worth splitting. */
+    const int minBodiesPerJob = 16;
+
+    /** As btGetConstraintIslandId in btDiscreteDynamicsWorld.cpp */
+    int constraintIslandId(const btTypedConstraint* pConstraint)
+    {
+        const btCollisionObject& a = pConstraint->getRigidBodyA();
+        const btCollisionObject& b = pConstraint->getRigidBodyB();
+        return (a.getIslandTag() >= 0) ? a.getIslandTag() : b.getIslandTag();
+    }
+
+    /**
+     * As btSortConstraintOnIslandPredicate in btDiscreteDynamicsWorld.cpp.
+     * The batches match the single-threaded world only if the constraints
+     * are sorted the same way.
+     */
+    class IslandIdLess
+    {
+    public:
+        bool operator()(const btTypedConstraint* lhs,
+                        const btTypedConstraint* rhs) const
+        {
+            return constraintIslandId(lhs) < constraintIslandId(rhs);
+        }
+    };
+}
+
+void tgParallelDynamicsWorld::Job::run()
+{
+    assert(pWorld != NULL);
+    switch (phase)
+    {
+    case ePredict:
+        pWorld->predictBodies(begin, end, timeStep);
+        break;
+    case eIntegrate:
+        pWorld->integrateBodies(begin, end, timeStep);
+        break;
+    case eSolve:
+        {
+            btConstraintSolver* const pSolver = pWorld->m_solvers[index];
+            const std::vector<std::size_t>& batches =
+                pWorld->m_assignment[index];
+            for (std::size_t i = 0; i < batches.size(); i++)
+            {
+                Batch& batch = pWorld->m_batches[batches[i]];
+                pSolver->solveGroup(
+                    batch.bodies.size() ? &batch.bodies[0] : 0,
+                    batch.bodies.size(),
+                    batch.manifolds.size() ? &batch.manifolds[0] : 0,
+                    batch.manifolds.size(),
+                    batch.constraints.size() ? &batch.constraints[0] : 0,
+                    batch.constraints.size(),
+                    *pWorld->m_pSolverInfo,
+                    pWorld->getDebugDrawer(),
+                    pWorld->getDispatcher());
+            }
+        }
+        break;
+    default:
+        assert(false);
+    }
+}
+
+void tgParallelDynamicsWorld::BatchCollector::setup(
+        const btContactSolverInfo& solverInfo)
+{
+    m_pSolverInfo = &solverInfo;
+    m_open = false;
+    m_world.m_nBatches = 0;
+}
+
+void tgParallelDynamicsWorld::BatchCollector::processIsland(
+        btCollisionObject** bodies,
+        int numBodies,
+        btPersistentManifold** manifolds,
+        int numManifolds,
+        int islandId)
+{
+    assert(m_pSolverInfo != NULL);
+    const btAlignedObjectArray<btTypedConstraint*>& sorted =
+        m_world.m_sortedConstraints;
+
+    if (islandId < 0)
+    {
+        // Islands are not split: everything is solved together
+        Batch& batch = m_world.newBatch();
+        for (int i = 0; i < numBodies; i++)
+        {
+            batch.bodies.push_back(bodies[i]);
+        }
+        for (int i = 0; i < numManifolds; i++)
+        {
+            batch.manifolds.push_back(manifolds[i]);
+        }
+        for (int i = 0; i < sorted.size(); i++)
+        {
+            batch.constraints.push_back(sorted[i]);
+        }
+        m_open = false;
+        return;
+    }
+
+    // The constraints are sorted by island; find this island's run
+    int first = 0;
+    while (first < sorted.size() &&
+           constraintIslandId(sorted[first]) != islandId)
+    {
+        first++;
+    }
+    int last = first;
+    while (last < sorted.size() &&
+           constraintIslandId(sorted[last]) == islandId)
+    {
+        last++;
+    }
+
+    Batch& batch = m_open ? m_world.m_batches[m_world.m_nBatches - 1] :
+                            m_world.newBatch();
+    for (int i = 0; i < numBodies; i++)
+    {
+        batch.bodies.push_back(bodies[i]);
+    }
+    for (int i = 0; i < numManifolds; i++)
+    {
+        batch.manifolds.push_back(manifolds[i]);
+    }
+    for (int i = first; i < last; i++)
+    {
+        batch.constraints.push_back(sorted[i]);
+    }
+
+    // Small islands are solved together, as in
+    // btDiscreteDynamicsWorld's InplaceSolverIslandCallback
+    m_open = (m_pSolverInfo->m_minimumSolverBatchSize > 1) &&
+             (batch.constraints.size() + batch.manifolds.size() <=
+              m_pSolverInfo->m_minimumSolverBatchSize);
+}
+
+void tgParallelDynamicsWorld::BatchCollector::flush()
+{
+    m_open = false;
+}
+
+tgParallelDynamicsWorld::tgParallelDynamicsWorld(
+        btDispatcher* dispatcher,
+        btBroadphaseInterface* pairCache,
+        const std::vector<btConstraintSolver*>& solvers,
+        btCollisionConfiguration* collisionConfiguration,
+        tgThreadPool& pool) :
+    btSoftRigidDynamicsWorld(dispatcher, pairCache,
+                             solvers.empty() ? NULL : solvers[0],
+                             collisionConfiguration),
+    m_solvers(solvers),
+    m_pool(pool),
+    m_jobs(m_pool.size()),
+    m_collector(*this),
+    m_nBatches(0),
+    m_assignment(m_pool.size()),
+    m_pSolverInfo(NULL)
+{
+    if (solvers.size() != m_pool.size())
+    {
+        throw std::invalid_argument("Need one constraint solver per thread");
+    }
+    for (std::size_t i = 0; i < solvers.size(); i++)
+    {
+        if (solvers[i] == NULL)
+        {
+            throw std::invalid_argument("NULL pointer to btConstraintSolver");
+        }
+    }
+    for (std::size_t i = 0; i < m_jobs.size(); i++)
+    {
+        m_jobs[i].pWorld = this;
+        m_jobs[i].index = i;
+    }
+}
+
+tgParallelDynamicsWorld::~tgParallelDynamicsWorld()
+{
+}
+
+void tgParallelDynamicsWorld::predictUnconstraintMotion(btScalar timeStep)
+{
+    if (getSoftBodyArray().size() != 0)
+    {
+        btSoftRigidDynamicsWorld::predictUnconstraintMotion(timeStep);
+    }
+    else
+    {
+#ifndef BT_NO_PROFILE
+        BT_PROFILE("tgParallelDynamicsWorld::predictUnconstraintMotion");
+#endif //BT_NO_PROFILE
+        runBodyPhase(ePredict, timeStep);
+    }
+}
+
+void tgParallelDynamicsWorld::integrateTransforms(btScalar timeStep)
+{
+    // Continuous collision detection sweeps against the whole world
+    for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+    {
+        if (m_nonStaticRigidBodies[i]->getCcdSquareMotionThreshold() != 0.0)
+        {
+            btSoftRigidDynamicsWorld::integrateTransforms(timeStep);
+            return;
+        }
+    }
+
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgParallelDynamicsWorld::integrateTransforms");
+#endif //BT_NO_PROFILE
+    runBodyPhase(eIntegrate, timeStep);
+}
+
+void tgParallelDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo)
+{
+    if (!canSolveInParallel())
+    {
+        btSoftRigidDynamicsWorld::solveConstraints(solverInfo);
+        return;
+    }
+
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgParallelDynamicsWorld::solveConstraints");
+#endif //BT_NO_PROFILE
+
+    // Sort the constraints by island, as btDiscreteDynamicsWorld does
+    m_sortedConstraints.resize(m_constraints.size());
+    for (int i = 0; i < m_constraints.size(); i++)
+    {
+        m_sortedConstraints[i] = m_constraints[i];
+    }
+    m_sortedConstraints.quickSort(IslandIdLess());
+
+    for (std::size_t i = 0; i < m_solvers.size(); i++)
+    {
+        m_solvers[i]->prepareSolve(getNumCollisionObjects(),
+                                   getDispatcher()->getNumManifolds());
+    }
+
+    // Gather the islands into batches without solving them
+    m_collector.setup(solverInfo);
+    getSimulationIslandManager()->buildAndProcessIslands(getDispatcher(),
+                                                         this,
+                                                         &m_collector);
+    m_collector.flush();
+
+    solveBatches(solverInfo);
+
+    for (std::size_t i = 0; i < m_solvers.size(); i++)
+    {
+        m_solvers[i]->allSolved(solverInfo, getDebugDrawer());
+    }
+}
+
+void tgParallelDynamicsWorld::runBodyPhase(Phase phase, btScalar timeStep)
+{
+    const int n = m_nonStaticRigidBodies.size();
+    const int maxJobs = std::max(1, n / minBodiesPerJob);
+    const int nJobs = std::min(static_cast<int>(m_jobs.size()), maxJobs);
+
+    if (nJobs <= 1)
+    {
+        if (phase == ePredict)
+        {
+            predictBodies(0, n, timeStep);
+        }
+        else
+        {
+            integrateBodies(0, n, timeStep);
+        }
+        return;
+    }
+
+    const int chunk = (n + nJobs - 1) / nJobs;
+    for (int i = 0; i < nJobs; i++)
+    {
+        Job& job = m_jobs[i];
+        job.phase = phase;
+        job.timeStep = timeStep;
+        job.begin = std::min(n, i * chunk);
+        job.end = std::min(n, job.begin + chunk);
+        m_pool.submit(&job);
+    }
+    m_pool.wait();
+}
+
+void tgParallelDynamicsWorld::solveBatches(const btContactSolverInfo& solverInfo)
+{
+    const std::size_t nThreads = m_jobs.size();
+    for (std::size_t t = 0; t < nThreads; t++)
+    {
+        m_assignment[t].clear();
+    }
+
+    // Give each batch to the least loaded thread. Which solver takes a
+    // batch does not change the result.
+    std::vector<std::size_t> load(nThreads, 0);
+    for (std::size_t b = 0; b < m_nBatches; b++)
+    {
+        const Batch& batch = m_batches[b];
+        const std::size_t t =
+            std::min_element(load.begin(), load.end()) - load.begin();
+        m_assignment[t].push_back(b);
+        load[t] += batch.bodies.size() + batch.manifolds.size() +
+                   batch.constraints.size();
+    }
+
+    m_pSolverInfo = &solverInfo;
+    if (m_nBatches <= 1)
+    {
+        // Nothing to share out
+        m_jobs[0].phase = eSolve;
+        m_jobs[0].run();
+    }
+    else
+    {
+        for (std::size_t t = 0; t < nThreads; t++)
+        {
+            if (!m_assignment[t].empty())
+            {
+                m_jobs[t].phase = eSolve;
+                m_pool.submit(&m_jobs[t]);
+            }
+        }
+        m_pool.wait();
+    }
+    m_pSolverInfo = NULL;
+}
+
+void tgParallelDynamicsWorld::predictBodies(int begin, int end,
+                                            btScalar timeStep)
+{
+    // As btDiscreteDynamicsWorld::predictUnconstraintMotion
+    for (int i = begin; i < end; i++)
+    {
+        btRigidBody* const pBody = m_nonStaticRigidBodies[i];
+        if (!pBody->isStaticOrKinematicObject())
+        {
+            pBody->applyDamping(timeStep);
+            pBody->predictIntegratedTransform(timeStep,
+                pBody->getInterpolationWorldTransform());
+        }
+    }
+}
+
+void tgParallelDynamicsWorld::integrateBodies(int begin, int end,
+                                              btScalar timeStep)
+{
+    // As btDiscreteDynamicsWorld::integrateTransforms, without the
+    // continuous collision detection
+    btTransform predictedTransform;
+    for (int i = begin; i < end; i++)
+    {
+        btRigidBody* const pBody = m_nonStaticRigidBodies[i];
+        pBody->setHitFraction(1.0);
+        if (pBody->isActive() && !pBody->isStaticOrKinematicObject())
+        {
+            pBody->predictIntegratedTransform(timeStep, predictedTransform);
+            pBody->proceedToTransform(predictedTransform);
+        }
+    }
+}
+
+bool tgParallelDynamicsWorld::canSolveInParallel() const
+{
+    // A kinematic body is given a solver body by every batch that
+    // touches it, so two threads could write to it at once
+    for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+    {
+        if (m_nonStaticRigidBodies[i]->isKinematicObject())
+        {
+            return false;
+        }
+    }
+    return m_solvers.size() > 1;
+}
+
+tgParallelDynamicsWorld::Batch& tgParallelDynamicsWorld::newBatch()
+{
+    if (m_nBatches == m_batches.size())
+    {
+        m_batches.push_back(Batch());
+    }
+    Batch& batch = m_batches[m_nBatches++];
+    batch.bodies.resize(0);
+    batch.manifolds.resize(0);
+    batch.constraints.resize(0);
+    return batch;
+}
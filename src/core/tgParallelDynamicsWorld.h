@@ -0,0 +1,214 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_PARALLEL_DYNAMICS_WORLD_H
+#define TG_PARALLEL_DYNAMICS_WORLD_H
+
+/**
+ * @file tgParallelDynamicsWorld.h
+ * @brief Contains the definition of class tgParallelDynamicsWorld
+ * $Id$
+ */
+
+// This application
+#include "tgThreadPool.h"
+// The Bullet Physics library
+#include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#include "LinearMath/btAlignedObjectArray.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class btPersistentManifold;
+class btTypedConstraint;
+
+/**
+ * A btSoftRigidDynamicsWorld that spreads the per-body and per-island
+ * work of a step over a tgThreadPool:
+ * - velocity damping and transform prediction,
+ * - constraint solving, one solver per thread, and
+ * - transform integration.
+ *
+ * The simulation islands are gathered into exactly the solver batches
+ * that btDiscreteDynamicsWorld would make, so every batch is solved with
+ * the same input as in the single-threaded world and the results are
+ * identical. The narrowphase stays on the calling thread: Bullet 2.82's
+ * collision algorithms share one simplex and penetration depth solver
+ * per collision configuration.
+ *
+ * Scenes with kinematic bodies, soft bodies or continuous collision
+ * detection fall back to the single-threaded code for the affected phase.
+ *
+ * @note Bullet's internal profiler is not thread safe, so Bullet and
+ * NTRT must be built with BT_NO_PROFILE to use this world.
+ */
+class tgParallelDynamicsWorld : public btSoftRigidDynamicsWorld
+{
+public:
+
+    /**
+     * @param[in] dispatcher as for btSoftRigidDynamicsWorld
+     * @param[in] pairCache as for btSoftRigidDynamicsWorld
+     * @param[in] solvers one constraint solver of the same type per
+     * thread; the first is also the world's solver. The caller keeps
+     * ownership.
+     * @param[in] collisionConfiguration as for btSoftRigidDynamicsWorld
+     * @param[in] pool the threads to spread each step over. The caller
+     * keeps ownership, so that the threads outlive a reset of the world.
+     * @throw std::invalid_argument if solvers has a NULL entry or does not
+     * have one solver per thread of pool
+     */
+    tgParallelDynamicsWorld(btDispatcher* dispatcher,
+                            btBroadphaseInterface* pairCache,
+                            const std::vector<btConstraintSolver*>& solvers,
+                            btCollisionConfiguration* collisionConfiguration,
+                            tgThreadPool& pool);
+
+    virtual ~tgParallelDynamicsWorld();
+
+    /** @return the number of threads a step is spread over */
+    std::size_t threadCount() const { return m_pool.size(); }
+
+protected:
+
+    virtual void predictUnconstraintMotion(btScalar timeStep);
+
+    virtual void solveConstraints(btContactSolverInfo& solverInfo);
+
+    virtual void integrateTransforms(btScalar timeStep);
+
+private:
+
+    /** The phases of a step that are run on the pool. */
+    enum Phase
+    {
+        ePredict,
+        eSolve,
+        eIntegrate
+    };
+
+    /**
+     * One thread's share of a phase: a range of m_nonStaticRigidBodies,
+     * or the solver batches assigned to that thread.
+     */
+    class Job : public tgThreadPool::Task
+    {
+    public:
+        Job() : pWorld(NULL), phase(ePredict), index(0), begin(0), end(0),
+            timeStep(0.0) { }
+
+        virtual void run();
+
+        tgParallelDynamicsWorld* pWorld;
+        Phase phase;
+        std::size_t index;
+        int begin;
+        int end;
+        btScalar timeStep;
+    };
+
+    /** The bodies, contacts and joints passed to one solveGroup call. */
+    struct Batch
+    {
+        btAlignedObjectArray<btCollisionObject*> bodies;
+        btAlignedObjectArray<btPersistentManifold*> manifolds;
+        btAlignedObjectArray<btTypedConstraint*> constraints;
+    };
+
+    /**
+     * Gathers the islands into batches the same way as
+     * btDiscreteDynamicsWorld's InplaceSolverIslandCallback, but defers
+     * solving them.
+     */
+    class BatchCollector : public btSimulationIslandManager::IslandCallback
+    {
+    public:
+        BatchCollector(tgParallelDynamicsWorld& world) : m_world(world),
+            m_pSolverInfo(NULL), m_open(false) { }
+
+        void setup(const btContactSolverInfo& solverInfo);
+
+        virtual void processIsland(btCollisionObject** bodies,
+                                   int numBodies,
+                                   btPersistentManifold** manifolds,
+                                   int numManifolds,
+                                   int islandId);
+
+        /** Close the batch being filled, if it is not empty. */
+        void flush();
+
+    private:
+        tgParallelDynamicsWorld& m_world;
+        const btContactSolverInfo* m_pSolverInfo;
+        /** True while the last batch may still take more islands */
+        bool m_open;
+    };
+
+    /** Split the bodies over the threads and run the phase. */
+    void runBodyPhase(Phase phase, btScalar timeStep);
+
+    /** Assign the batches to threads by size and solve them. */
+    void solveBatches(const btContactSolverInfo& solverInfo);
+
+    void predictBodies(int begin, int end, btScalar timeStep);
+
+    void integrateBodies(int begin, int end, btScalar timeStep);
+
+    /** @return true if the island solve can run on several threads */
+    bool canSolveInParallel() const;
+
+    /** @return a cleared batch at the end of m_batches */
+    Batch& newBatch();
+
+    friend class Job;
+    friend class BatchCollector;
+
+    // Not copyable
+    tgParallelDynamicsWorld(const tgParallelDynamicsWorld&);
+    tgParallelDynamicsWorld& operator=(const tgParallelDynamicsWorld&);
+
+private:
+
+    /** One solver per thread, not owned. */
+    const std::vector<btConstraintSolver*> m_solvers;
+
+    /** Not owned. */
+    tgThreadPool& m_pool;
+
+    /** One job per thread, reused every phase. */
+    std::vector<Job> m_jobs;
+
+    BatchCollector m_collector;
+
+    /**
+     * The batches of the current step. Only the first m_nBatches are in
+     * use; the rest keep their storage for the next step.
+     */
+    std::vector<Batch> m_batches;
+    std::size_t m_nBatches;
+
+    /** The batch indices assigned to each thread. */
+    std::vector<std::vector<std::size_t> > m_assignment;
+
+    /** The solver info of the current step, for the solve jobs. */
+    const btContactSolverInfo* m_pSolverInfo;
+};
+
+#endif  // TG_PARALLEL_DYNAMICS_WORLD_H
@@ -0,0 +1,205 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRolloutEngine.cpp
+ * @brief Contains the definitions of members of class tgRolloutEngine
+ * $Id$
+ */
+
+// This module
+#include "tgRolloutEngine.h"
+// This application
+#include "tgModel.h"
+#include "tgSimView.h"
+#include "tgSimulation.h"
+#include "terrain/tgBoxGround.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    /**
+     * One rollout: build a private world, view and simulation, step the
+     * model and score it. Everything is destroyed when run() returns.
+     */
+    class Rollout : public tgThreadPool::Task
+    {
+    public:
+        Rollout(const tgRolloutEngine::Config& config,
+                tgRolloutFactory& factory,
+                const std::vector<double>& params,
+                double& score) :
+            m_config(config),
+            m_factory(factory),
+            m_params(params),
+            m_score(score)
+        {
+        }
+
+        virtual void run()
+        {
+            tgGround* pGround = m_factory.createGround();
+            if (pGround == NULL)
+            {
+                pGround = new tgBoxGround();
+            }
+            tgWorld world(m_config.worldConfig, pGround);
+
+            // Nothing is rendered, but the view insists on renderRate >= stepSize
+            const double renderRate = std::max(m_config.stepSize, 1.0/60.0);
+            tgSimView view(world, m_config.stepSize, renderRate);
+            tgSimulation simulation(view);
+
+            tgModel* const pModel = m_factory.createModel(m_params);
+            if (pModel == NULL)
+            {
+                throw std::invalid_argument("tgRolloutFactory returned a NULL model");
+            }
+            // The simulation takes ownership of the model
+            simulation.addModel(pModel);
+
+            for (int i = 0; i < m_config.steps; i++)
+            {
+                simulation.step(m_config.stepSize);
+            }
+
+            m_score = m_factory.score(*pModel);
+        }
+
+    private:
+        const tgRolloutEngine::Config& m_config;
+        tgRolloutFactory& m_factory;
+        const std::vector<double>& m_params;
+        double& m_score;
+    };
+
+    void deleteRollouts(std::vector<Rollout*>& rollouts)
+    {
+        for (std::size_t i = 0; i < rollouts.size(); i++)
+        {
+            delete rollouts[i];
+        }
+        rollouts.clear();
+    }
+}
+
+tgRolloutEngine::Config::Config(const tgWorld::Config& world,
+                                double ss,
+                                int n,
+                                std::size_t t) :
+    worldConfig(world),
+    stepSize(ss),
+    steps(n),
+    threads(t)
+{
+    if (ss <= 0.0)
+    {
+        throw std::invalid_argument("stepSize is not positive");
+    }
+    else if (n <= 0)
+    {
+        throw std::invalid_argument("steps is not positive");
+    }
+}
+
+tgRolloutEngine::tgRolloutEngine(const Config& config) :
+    m_config(config),
+    m_pool(config.threads)
+{
+}
+
+tgRolloutEngine::~tgRolloutEngine()
+{
+}
+
+std::vector<double>
+tgRolloutEngine::run(const std::vector<tgRolloutFactory*>& factories,
+                     const std::vector<std::vector<double> >& params)
+{
+    if (factories.size() != params.size())
+    {
+        throw std::invalid_argument("factories and params differ in size");
+    }
+    const std::size_t n = factories.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (factories[i] == NULL)
+        {
+            throw std::invalid_argument("NULL pointer to tgRolloutFactory");
+        }
+    }
+
+    std::vector<double> scores(n, 0.0);
+    std::vector<Rollout*> rollouts;
+    rollouts.reserve(n);
+    try
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            rollouts.push_back(new Rollout(m_config, *factories[i], params[i],
+                                           scores[i]));
+            m_pool.submit(rollouts.back());
+        }
+    }
+    catch (...)
+    {
+        // The rollouts submitted so far are running. Let them finish,
+        // dropping their own failures in favour of this one.
+        try
+        {
+            m_pool.wait();
+        }
+        catch (std::runtime_error&)
+        {
+        }
+        deleteRollouts(rollouts);
+        throw;
+    }
+
+    // Wait before deleting the tasks, even if one of them failed
+    bool failed = false;
+    std::string error;
+    try
+    {
+        m_pool.wait();
+    }
+    catch (std::runtime_error& e)
+    {
+        failed = true;
+        error = e.what();
+    }
+    deleteRollouts(rollouts);
+    if (failed)
+    {
+        throw std::runtime_error(error);
+    }
+
+    return scores;
+}
+
+std::vector<double>
+tgRolloutEngine::run(tgRolloutFactory& factory,
+                     const std::vector<std::vector<double> >& params)
+{
+    const std::vector<tgRolloutFactory*> factories(params.size(), &factory);
+    return run(factories, params);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_ROLLOUT_ENGINE_H
+#define TG_ROLLOUT_ENGINE_H
+
+/**
+ * @file tgRolloutEngine.h
+ * @brief Contains the definitions of classes tgRolloutFactory and
+ * tgRolloutEngine
+ * $Id$
+ */
+
+// This application
+#include "tgWorld.h"
+#include "tgThreadPool.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgGround;
+class tgModel;
+
+/**
+ * Builds the model for one rollout and scores it afterwards.
+ * A factory passed to tgRolloutEngine::run() once per rollout is only
+ * ever called from one thread at a time. A factory shared by several
+ * rollouts must make createModel() and score() reentrant.
+ */
+class tgRolloutFactory
+{
+public:
+
+    virtual ~tgRolloutFactory() { }
+
+    /**
+     * Create the model for a rollout, with its controllers attached and
+     * configured from params. The rollout takes ownership of the model.
+     * @param[in] params the controller parameter set for this rollout
+     * @return a new model; must not be NULL
+     */
+    virtual tgModel* createModel(const std::vector<double>& params) = 0;
+
+    /**
+     * Score the model after its last step, before it is torn down.
+     * @param[in] model the model returned by createModel()
+     * @return the score of the rollout
+     */
+    virtual double score(tgModel& model) = 0;
+
+    /**
+     * Create the ground for a rollout's world. The world takes ownership.
+     * @return a new ground, or NULL for the default tgBoxGround
+     */
+    virtual tgGround* createGround() { return NULL; }
+};
+
+/**
+ * Runs independent rollouts in parallel, each in its own tgWorld,
+ * tgSimView and tgSimulation. No Bullet state is shared between the
+ * worlds, so throughput scales with the number of threads without
+ * paying the process startup cost of one executable per trial.
+ *
+ * @note Bullet 2.82's built-in profiler (CProfileManager) is a process
+ * wide singleton. Build Bullet and NTRT with BT_NO_PROFILE when using
+ * more than one thread.
+ */
+class tgRolloutEngine
+{
+public:
+
+    /**
+     * Rollout configuration. This is Plain Old Data.
+     */
+    struct Config
+    {
+        Config(const tgWorld::Config& world = tgWorld::Config(),
+               double stepSize = 1.0/1000.0,
+               int steps = 60000,
+               std::size_t threads = 0);
+
+        /** The configuration of every rollout's world. */
+        tgWorld::Config worldConfig;
+
+        /** Simulation time step in seconds. Must be positive. */
+        double stepSize;
+
+        /** Number of steps per rollout. Must be positive. */
+        int steps;
+
+        /** Number of worker threads; zero means one per processor. */
+        std::size_t threads;
+    };
+
+    /**
+     * Start the worker threads.
+     * @param[in] config a tgRolloutEngine::Config
+     */
+    tgRolloutEngine(const Config& config = Config());
+
+    ~tgRolloutEngine();
+
+    /**
+     * Run one rollout per factory, with the matching parameter set, and
+     * block until all of them are done.
+     * @param[in] factories one factory per rollout; no NULL entries
+     * @param[in] params one controller parameter set per rollout
+     * @return the score of each rollout, in the order of factories
+     * @throw std::invalid_argument if the sizes differ or a factory is NULL
+     * @throw std::runtime_error if any rollout threw
+     */
+    std::vector<double> run(const std::vector<tgRolloutFactory*>& factories,
+                            const std::vector<std::vector<double> >& params);
+
+    /**
+     * Run one rollout per parameter set, all built by the same factory.
+     * @param[in] factory a reentrant factory
+     * @param[in] params one controller parameter set per rollout
+     * @return the score of each rollout, in the order of params
+     * @throw std::runtime_error if any rollout threw
+     */
+    std::vector<double> run(tgRolloutFactory& factory,
+                            const std::vector<std::vector<double> >& params);
+
+    /** @return the number of worker threads */
+    std::size_t threadCount() const { return m_pool.size(); }
+
+private:
+
+    const Config m_config;
+
+    tgThreadPool m_pool;
+};
+
+#endif  // TG_ROLLOUT_ENGINE_H
@@ -27,6 +27,7 @@
 #include "tgSimulation.h"
 // This application
 #include "tgModel.h"
+#include "tgParallelActuatorStepper.h"
 #include "tgSimView.h"
 #include "tgSimViewGraphics.h"
 #include "tgWorld.h"
@@ -38,7 +39,8 @@
 #include <stdexcept>
 
 tgSimulation::tgSimulation(tgSimView& view) :
-  m_view(view)
+  m_view(view),
+  m_pStepper(NULL)
 {
         m_view.bindToSimulation(*this);
 
@@ -51,6 +53,7 @@ tgSimulation::tgSimulation(tgSimView& view) :
 tgSimulation::~tgSimulation()
 {
     teardown();
+    delete m_pStepper;
     m_view.releaseFromSimulation();
     for (std::size_t i = 0; i < m_models.size(); i++)
     {
@@ -74,6 +77,7 @@ void tgSimulation::addModel(tgModel* pModel)
 
         pModel->setup(m_view.world());
         m_models.push_back(pModel);
+        collectActuators();
     }
 
     // Postcondition
@@ -93,6 +97,7 @@ void tgSimulation::addObstacle(tgModel* pObstacle)
 
         pObstacle->setup(m_view.world());
         m_obstacles.push_back(pObstacle);
+        collectActuators();
     }
 
     // Postcondition
@@ -144,6 +149,7 @@ void tgSimulation::reset()
         
         m_models[i]->setup(m_view.world());
     }
+    collectActuators();
     // Also, need to set up the data managers again.
     // Note that this MUST occur after calling setup on the models,
     // otherwise the data manager will not create any sensors
@@ -170,6 +176,7 @@ void tgSimulation::reset(tgGround* newGround)
         
         m_models[i]->setup(m_view.world());
     }
+    collectActuators();
     // Also, need to set up the data managers again.
     // Note that this MUST occur after calling setup on the models,
     // otherwise the data manager will not create any sensors
@@ -182,6 +189,86 @@ void tgSimulation::reset(tgGround* newGround)
     // Don't need to set up obstacles since they were just added
 }
 
+tgSimulation::SnapshotHandle tgSimulation::snapshot()
+{
+    Snapshot snap;
+    snap.nModels = m_models.size();
+    snap.nObstacles = m_obstacles.size();
+
+    m_view.world().saveState(snap.state);
+    for (std::size_t i = 0; i < m_models.size(); i++)
+    {
+        m_models[i]->saveState(snap.state);
+    }
+    for (std::size_t i = 0; i < m_obstacles.size(); i++)
+    {
+        m_obstacles[i]->saveState(snap.state);
+    }
+
+    m_snapshots.push_back(snap);
+
+    // Postcondition
+    assert(invariant());
+    
+    return m_snapshots.size() - 1;
+}
+
+void tgSimulation::restore(SnapshotHandle handle)
+{
+    // Precondition
+    if (handle >= m_snapshots.size())
+    {
+        throw std::invalid_argument("No such snapshot, or it was discarded by reset");
+    }
+
+    const Snapshot& snap = m_snapshots[handle];
+    if (snap.nModels != m_models.size() ||
+        snap.nObstacles != m_obstacles.size())
+    {
+        throw std::runtime_error("Models or obstacles were added after the snapshot");
+    }
+
+    std::size_t pos = 0;
+    m_view.world().restoreState(snap.state, pos);
+    for (std::size_t i = 0; i < m_models.size(); i++)
+    {
+        m_models[i]->restoreState(snap.state, pos);
+    }
+    for (std::size_t i = 0; i < m_obstacles.size(); i++)
+    {
+        m_obstacles[i]->restoreState(snap.state, pos);
+    }
+    assert(pos == snap.state.size());
+
+    // Postcondition
+    assert(invariant());
+}
+
+void tgSimulation::setActuatorThreads(std::size_t nThreads)
+{
+    if (m_pStepper)
+    {
+        m_pStepper->release();
+        delete m_pStepper;
+        m_pStepper = NULL;
+    }
+    if (nThreads != 1)
+    {
+        m_pStepper = new tgParallelActuatorStepper(nThreads);
+        collectActuators();
+    }
+}
+
+void tgSimulation::collectActuators()
+{
+    if (m_pStepper)
+    {
+        std::vector<tgModel*> all(m_models);
+        all.insert(all.end(), m_obstacles.begin(), m_obstacles.end());
+        m_pStepper->collect(all);
+    }
+}
+
 /**
  * @note This is not inlined because it depends on the definition of tgSimView.
  */
@@ -217,6 +304,15 @@ void tgSimulation::step(double dt) const
             m_obstacles[i]->step(dt);
         }
 
+        // Step the actuators the models left to the stepper
+        if (m_pStepper)
+        {
+            m_pStepper->step(m_view.world(), dt);
+        }
+
+        // Batched cables queue their forces while the models step
+        m_view.world().applyQueuedForces();
+
 	// Step the data managers
 	for (std::size_t i = 0; i < m_dataManagers.size(); i++) {
 	  m_dataManagers[i]->step(dt);
@@ -226,6 +322,11 @@ void tgSimulation::step(double dt) const
   
 void tgSimulation::teardown()
 {
+    if (m_pStepper)
+    {
+        m_pStepper->release();
+    }
+
     const size_t n = m_models.size();
     for (std::size_t i = 0; i < n; i++)
     {
@@ -260,6 +361,9 @@ void tgSimulation::teardown()
     // Reset the world after the models - models need world info for
     // their onTeardown() functions
     m_view.world().reset();
+
+    // The bodies the snapshots refer to are gone
+    m_snapshots.clear();
     // Postcondition
     assert(invariant());
 }
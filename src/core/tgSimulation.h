@@ -27,6 +27,7 @@
  */
 
 // The C++ Standard Library
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -37,6 +38,7 @@ class tgSimView;
 class tgWorld;
 class tgGround;
 class tgDataManager;
+class tgParallelActuatorStepper;
 
 /**
  * Holds objects necessary for simulation, a world, a view
@@ -120,7 +122,48 @@ public:
      * ground will be deleted
      */
     void reset(tgGround* newGround);
+
+    /** Identifies a state saved by snapshot(). */
+    typedef std::size_t SnapshotHandle;
+
+    /**
+     * Save the state of the world, the models and the obstacles, so that
+     * restore() can return to it without rebuilding the world.
+     * Snapshots are discarded by reset().
+     * @return a handle to pass to restore()
+     */
+    SnapshotHandle snapshot();
+
+    /**
+     * Return the world, the models and the obstacles to the state saved
+     * by snapshot(). This is much cheaper than reset(): nothing is torn
+     * down or set up again, so controllers are notified through
+     * tgObserver::onRestoreState() instead of onTeardown() and onSetup().
+     * Data managers are not notified. Cable contacts are dropped and
+     * found again on the next step, so a restored run may differ slightly
+     * from a run that was never interrupted.
+     * @param[in] handle a handle returned by snapshot() since the last
+     * reset()
+     * @throw std::invalid_argument if handle is not a current snapshot
+     * @throw std::runtime_error if models or obstacles were added since
+     * the snapshot was taken
+     */
+    void restore(SnapshotHandle handle);
     
+    /**
+     * Step the dynamics of the spring cable actuators on several threads,
+     * after the models have notified their controllers. Only actuators
+     * whose cable is batched by the world and that have no children are
+     * stepped this way; the rest step with their models as before.
+     * Forces reach the bodies in the same order as in a serial step, so
+     * the results do not depend on the number of threads, as long as no
+     * controller reads a cable's state in the same step after that cable
+     * has stepped.
+     * @param[in] nThreads the number of threads; 1, the default, steps
+     * every actuator with its model; 0 means one per processor
+     */
+    void setActuatorThreads(std::size_t nThreads);
+
     /**
      * Returns a reference to the world
      */
@@ -162,6 +205,27 @@ private:
      * All pointers should be non-NULL.
      */
     std::vector<tgDataManager*> m_dataManagers;
+
+    /** A state saved by snapshot(). */
+    struct Snapshot
+    {
+        std::size_t nModels;
+        std::size_t nObstacles;
+        /** The world, then the models, then the obstacles. */
+        std::vector<double> state;
+    };
+
+    /** Indexed by SnapshotHandle. Cleared by teardown(). */
+    std::vector<Snapshot> m_snapshots;
+
+    /**
+     * Steps the actuators' dynamics if setActuatorThreads() asked for
+     * more than one thread, else NULL. Owned.
+     */
+    tgParallelActuatorStepper* m_pStepper;
+
+    /** Hand the models' actuators to m_pStepper, if there is one. */
+    void collectActuators();
 };
 
 #endif  // TG_SIMULATION_H
@@ -76,3 +76,24 @@ void tgSpringCable::setRestLength( const double newRestLength)
     
     m_restLength = newRestLength;
 }
+
+void tgSpringCable::saveState(std::vector<double>& state) const
+{
+    state.push_back(m_restLength);
+    state.push_back(m_prevLength);
+    state.push_back(m_velocity);
+    state.push_back(m_damping);
+}
+
+void tgSpringCable::restoreState(const std::vector<double>& state,
+                                 std::size_t& pos)
+{
+    if (pos + 4 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgSpringCable");
+    }
+    m_restLength = state[pos++];
+    m_prevLength = state[pos++];
+    m_velocity = state[pos++];
+    m_damping = state[pos++];
+}
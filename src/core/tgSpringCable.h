@@ -27,6 +27,7 @@
  */
 
 // The C++ Standard Library
+#include <cstddef>
 #include <vector>
 
 // Forward references
@@ -127,6 +128,33 @@ public:
      */
     virtual const std::vector<const tgSpringCableAnchor*> getAnchors() const = 0;
 
+    /**
+     * Whether step() only reads the bodies and queues its forces, rather
+     * than applying them, so that several cables can step on different
+     * threads at once.
+     * @return false in the default implementation
+     */
+    virtual bool canStepConcurrently() const
+    {
+        return false;
+    }
+
+    /**
+     * Append the rest length, previous length, velocity and damping,
+     * for tgSpringCableActuator::saveState
+     * @param[out] state the buffer to append to
+     */
+    virtual void saveState(std::vector<double>& state) const;
+
+    /**
+     * Read back the values appended by saveState
+     * @param[in] state the buffer written by saveState
+     * @param[in,out] pos the read position, advanced past this cable
+     * @throw std::invalid_argument if state is too short
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
+
 protected:
  
     /**
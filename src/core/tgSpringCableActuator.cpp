@@ -28,6 +28,7 @@
 #include "tgSpringCable.h"
 #include "tgWorld.h"
 // The C++ Standard Library
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
@@ -49,6 +50,9 @@ tgSpringCableActuator::Config::Config(double s,
   damping(d),
   pretension(p),
   hist(h),
+  histCapacity(0),
+  histDecimation(1),
+  histStats(false),
   maxTens(mf),
   targetVelocity(tVel),
   minActualLength(mnAL),
@@ -108,6 +112,10 @@ void tgSpringCableActuator::constructorAux()
     {
         throw std::invalid_argument("Minimum length is negative.");
     }
+    else if (m_config.histDecimation == 0)
+    {
+        throw std::invalid_argument("History decimation is zero.");
+    }
     else if (m_restLength < 0.0)
     {
         throw std::invalid_argument("Starting rest length is negative.");
@@ -122,7 +130,9 @@ tgSpringCableActuator::tgSpringCableActuator(tgSpringCable* springCable,
     m_pHistory(new SpringCableActuatorHistory()),
     m_restLength(springCable->getRestLength()),
     m_startLength(springCable->getActualLength()),
-    m_prevVelocity(0.0)
+    m_prevVelocity(0.0),
+    m_dynamicsDeferred(false),
+    m_historySteps(0)
 {
     constructorAux();
 
@@ -153,12 +163,117 @@ void tgSpringCableActuator::step(double dt)
     {
         throw std::invalid_argument("dt is not positive.");
     }
-    else
+    else if (!m_dynamicsDeferred)
     {   
-        tgModel::step(dt);
+        stepDynamics(dt);
     }
 }
 
+void tgSpringCableActuator::stepDynamics(double dt)
+{
+    tgModel::step(dt);
+}
+
+bool tgSpringCableActuator::canStepConcurrently() const
+{
+    return m_springCable->canStepConcurrently() && getDescendants().empty();
+}
+
+void tgSpringCableActuator::saveState(std::vector<double>& state) const
+{
+    state.push_back(m_restLength);
+    state.push_back(m_prevVelocity);
+    saveHistory(state);
+    m_springCable->saveState(state);
+    notifySaveState(state);
+    tgModel::saveState(state);
+}
+
+void tgSpringCableActuator::restoreState(const std::vector<double>& state,
+                                         std::size_t& pos)
+{
+    if (pos + 2 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgSpringCableActuator");
+    }
+    m_restLength = state[pos++];
+    m_prevVelocity = state[pos++];
+    restoreHistory(state, pos);
+    m_springCable->restoreState(state, pos);
+    notifyRestoreState(state, pos);
+    tgModel::restoreState(state, pos);
+
+    // Postcondition
+    assert(invariant());
+}
+
+void tgSpringCableActuator::saveHistory(std::vector<double>& state) const
+{
+    const SpringCableActuatorStats& stats = m_pHistory->stats;
+    state.push_back(static_cast<double>(m_historySteps));
+    state.push_back(static_cast<double>(stats.count));
+    state.push_back(stats.tensionSum);
+    state.push_back(stats.tensionSumSq);
+    state.push_back(stats.tensionMin);
+    state.push_back(stats.tensionMax);
+    state.push_back(stats.lengthMin);
+    state.push_back(stats.lengthMax);
+    state.push_back(stats.energySpent);
+    state.push_back(stats.prevTension);
+    state.push_back(stats.prevRestLength);
+    
+    // The sequences all have the same length
+    const SpringCableActuatorHistory& h = *m_pHistory;
+    const std::size_t n = h.tensionHistory.size();
+    assert(h.lastLengths.size() == n && h.lastVelocities.size() == n &&
+           h.dampingHistory.size() == n && h.restLengths.size() == n);
+    state.push_back(static_cast<double>(n));
+    state.insert(state.end(), h.lastLengths.begin(), h.lastLengths.end());
+    state.insert(state.end(), h.lastVelocities.begin(), h.lastVelocities.end());
+    state.insert(state.end(), h.dampingHistory.begin(), h.dampingHistory.end());
+    state.insert(state.end(), h.restLengths.begin(), h.restLengths.end());
+    state.insert(state.end(), h.tensionHistory.begin(), h.tensionHistory.end());
+}
+
+void tgSpringCableActuator::restoreHistory(const std::vector<double>& state,
+                                           std::size_t& pos)
+{
+    if (pos + 12 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgSpringCableActuator");
+    }
+    SpringCableActuatorStats& stats = m_pHistory->stats;
+    m_historySteps = static_cast<std::size_t>(state[pos++]);
+    stats.count = static_cast<std::size_t>(state[pos++]);
+    stats.tensionSum = state[pos++];
+    stats.tensionSumSq = state[pos++];
+    stats.tensionMin = state[pos++];
+    stats.tensionMax = state[pos++];
+    stats.lengthMin = state[pos++];
+    stats.lengthMax = state[pos++];
+    stats.energySpent = state[pos++];
+    stats.prevTension = state[pos++];
+    stats.prevRestLength = state[pos++];
+    
+    const std::size_t n = static_cast<std::size_t>(state[pos++]);
+    if (pos + 5 * n > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgSpringCableActuator");
+    }
+    SpringCableActuatorHistory& h = *m_pHistory;
+    std::vector<double>::const_iterator it = state.begin() + pos;
+    h.lastLengths.assign(it, it + n);
+    it += n;
+    h.lastVelocities.assign(it, it + n);
+    it += n;
+    h.dampingHistory.assign(it, it + n);
+    it += n;
+    h.restLengths.assign(it, it + n);
+    it += n;
+    h.tensionHistory.assign(it, it + n);
+    pos += 5 * n;
+}
+
 const double tgSpringCableActuator::getStartLength() const
 {
     return m_startLength;
@@ -189,6 +304,81 @@ const tgSpringCableActuator::SpringCableActuatorHistory& tgSpringCableActuator::
     return *m_pHistory;
 }
 
+tgSpringCableActuator::SpringCableActuatorStats::SpringCableActuatorStats() :
+    count(0),
+    tensionSum(0.0),
+    tensionSumSq(0.0),
+    tensionMin(0.0),
+    tensionMax(0.0),
+    lengthMin(0.0),
+    lengthMax(0.0),
+    energySpent(0.0),
+    prevTension(0.0),
+    prevRestLength(0.0)
+{
+}
+
+double tgSpringCableActuator::SpringCableActuatorStats::meanTension() const
+{
+    return count > 0 ? tensionSum / count : 0.0;
+}
+
+void tgSpringCableActuator::recordHistory(double length,
+                                          double velocity,
+                                          double damping,
+                                          double restLength,
+                                          double tension)
+{
+    if (m_config.hist || m_config.histStats)
+    {
+        SpringCableActuatorStats& stats = m_pHistory->stats;
+        if (stats.count == 0)
+        {
+            stats.tensionMin = stats.tensionMax = tension;
+            stats.lengthMin = stats.lengthMax = length;
+        }
+        else
+        {
+            // Only shortening the cable costs energy
+            double motorSpeed = restLength - stats.prevRestLength;
+            if (motorSpeed > 0.0)
+            {
+                motorSpeed = 0.0;
+            }
+            stats.energySpent += stats.prevTension * motorSpeed;
+            
+            stats.tensionMin = std::min(stats.tensionMin, tension);
+            stats.tensionMax = std::max(stats.tensionMax, tension);
+            stats.lengthMin = std::min(stats.lengthMin, length);
+            stats.lengthMax = std::max(stats.lengthMax, length);
+        }
+        stats.count++;
+        stats.tensionSum += tension;
+        stats.tensionSumSq += tension * tension;
+        stats.prevTension = tension;
+        stats.prevRestLength = restLength;
+    }
+    
+    if (m_config.hist && m_historySteps++ % m_config.histDecimation == 0)
+    {
+        SpringCableActuatorHistory& h = *m_pHistory;
+        if (m_config.histCapacity > 0 &&
+            h.tensionHistory.size() >= m_config.histCapacity)
+        {
+            h.lastLengths.pop_front();
+            h.lastVelocities.pop_front();
+            h.dampingHistory.pop_front();
+            h.restLengths.pop_front();
+            h.tensionHistory.pop_front();
+        }
+        h.lastLengths.push_back(length);
+        h.lastVelocities.push_back(velocity);
+        h.dampingHistory.push_back(damping);
+        h.restLengths.push_back(restLength);
+        h.tensionHistory.push_back(tension);
+    }
+}
+
 bool tgSpringCableActuator::invariant() const
 {
     return
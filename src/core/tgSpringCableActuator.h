@@ -32,7 +32,9 @@
 #include "tgControllable.h"
 #include "tgSubject.h"
 
+#include <cstddef>
 #include <deque> // For history
+#include <vector>
 // Forward declarations
 class tgWorld;
 class tgSpringCable;
@@ -105,6 +107,28 @@ public:
        * in deque objects. Useful for computing the energy of a trial.
        */
       bool hist;
+      
+      /**
+       * If hist is set and this is not zero, only the most recent
+       * histCapacity samples are kept, so the history stays bounded
+       * over long trials. Set directly; defaults to 0 (keep all).
+       */
+      std::size_t histCapacity;
+      
+      /**
+       * If hist is set, a sample is stored every histDecimation steps.
+       * Must be positive. Set directly; defaults to 1 (every step).
+       */
+      std::size_t histDecimation;
+      
+      /**
+       * Running aggregates of tension, length and energy are kept in
+       * SpringCableActuatorHistory::stats whenever hist is set. They
+       * cover every step, whatever histCapacity and histDecimation drop
+       * from the sequences. Set this to keep the aggregates without the
+       * sequences. Set directly; defaults to false.
+       */
+      bool histStats;
               
       // Motor model parameters
       /**
@@ -178,6 +202,42 @@ public:
       
     };
     
+    /**
+     * Running aggregates over every step, kept if Config::hist or
+     * Config::histStats is set. Minima and maxima are zero until the
+     * first step.
+     */
+    struct SpringCableActuatorStats
+    {
+        SpringCableActuatorStats();
+        
+        /** @return the mean tension, or zero before the first step */
+        double meanTension() const;
+        
+        /** Number of steps aggregated */
+        std::size_t count;
+        
+        double tensionSum;
+        double tensionSumSq;
+        double tensionMin;
+        double tensionMax;
+        
+        double lengthMin;
+        double lengthMax;
+        
+        /**
+         * Sum over steps of the previous step's tension times the
+         * change in rest length, counting only shortening, as the
+         * learning controllers compute it from tensionHistory and
+         * restLengths. Never positive.
+         */
+        double energySpent;
+        
+        /** The previous step's tension and rest length, for energySpent */
+        double prevTension;
+        double prevRestLength;
+    };
+    
     /** Encapsulate the history members. */
     struct SpringCableActuatorHistory
     {
@@ -195,6 +255,9 @@ public:
         
         /** Tension history. */
         std::deque<double> tensionHistory;
+        
+        /** Running aggregates, see Config::histStats */
+        SpringCableActuatorStats stats;
     };
 
     /** Deletes history and spring cable instantiation */
@@ -206,8 +269,62 @@ public:
     /** Just calls tgModel::teardown(world) - sets up any children */
     virtual void teardown();
     
-    /** Just calls tgModel::step(dt) - steps any children */
+    /**
+     * Just calls tgModel::step(dt) - steps any children - unless the
+     * dynamics are deferred
+     */
     virtual void step(double dt);
+
+    /**
+     * The part of step() that comes after notifying the observers: the
+     * motor and spring cable dynamics, history and children. Subclasses
+     * that override step() should call this from it unless
+     * dynamicsDeferred() is true.
+     * @param[in] dt, must be positive
+     */
+    virtual void stepDynamics(double dt);
+
+    /**
+     * Whether stepDynamics() only touches this actuator and queues the
+     * cable's forces, so several actuators can run it on different
+     * threads at once. Used by tgParallelActuatorStepper.
+     * @return true if the spring cable can step concurrently and this
+     * actuator has no children
+     */
+    bool canStepConcurrently() const;
+
+    /**
+     * Make step() leave stepDynamics() to the caller, which then runs it
+     * for every deferred actuator once the models have stepped.
+     * @param[in] defer true to defer
+     */
+    void deferDynamics(bool defer)
+    {
+        m_dynamicsDeferred = defer;
+    }
+
+    /** @return true if step() leaves stepDynamics() to the caller */
+    bool dynamicsDeferred() const
+    {
+        return m_dynamicsDeferred;
+    }
+
+    /**
+     * Appends the rest length, the previous velocity, the history, the
+     * state of the spring cable and the state of any observers, then the
+     * children.
+     * @param[out] state the buffer to append to
+     */
+    virtual void saveState(std::vector<double>& state) const;
+
+    /**
+     * Read back the values appended by saveState, in the same order
+     * @param[in] state the buffer written by saveState
+     * @param[in,out] pos the read position
+     * @throw std::invalid_argument if state is too short
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
     
     /**
      * Functions for interfacing with tgSpringCable
@@ -287,6 +404,24 @@ protected:
     
     /** All history sequences. */
     SpringCableActuatorHistory * const m_pHistory;
+    
+    /**
+     * Record one step's sample as m_config asks: in the sequences, with
+     * decimation and capacity applied, and in the running aggregates.
+     * Called by the subclasses' logHistory.
+     */
+    void recordHistory(double length, double velocity, double damping,
+                       double restLength, double tension);
+    
+    /**
+     * Append the history sequences and aggregates, so that a restored
+     * trial computes the same energy as one that was never interrupted.
+     * Costs five values per stored sample.
+     */
+    void saveHistory(std::vector<double>& state) const;
+    
+    /** Read back the values appended by saveHistory */
+    void restoreHistory(const std::vector<double>& state, std::size_t& pos);
 
     
      /**
@@ -314,6 +449,12 @@ protected:
     double m_prevVelocity;
 private:
 
+    /** True if step() leaves stepDynamics() to the caller */
+    bool m_dynamicsDeferred;
+    
+    /** Steps seen by recordHistory(), for Config::histDecimation */
+    std::size_t m_historySteps;
+
     /**
      * Helper function to perform what is in common to all constructor bodies.
      */
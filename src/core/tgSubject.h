@@ -77,6 +77,21 @@ public:
      * were attached.
      */
     void notifyTeardown();
+
+    /**
+     * Call tgObserver<T>::onSaveState() on all observers in the order in
+     * which they were attached.
+     * @param[out] state the buffer the observers append to
+     */
+    void notifySaveState(std::vector<double>& state) const;
+
+    /**
+     * Call tgObserver<T>::onRestoreState() on all observers in the order in
+     * which they were attached.
+     * @param[in] state the buffer written by notifySaveState()
+     * @param[in,out] pos the read position
+     */
+    void notifyRestoreState(const std::vector<double>& state, std::size_t& pos);
     
 private:
 
@@ -129,5 +144,34 @@ void tgSubject<Subject>::notifyTeardown()
         if (pObserver) { pObserver->onTeardown(static_cast<Subject&>(*this)); }
     }
 }
+
+template <typename Subject>
+void tgSubject<Subject>::notifySaveState(std::vector<double>& state) const
+{
+    const std::size_t n = m_observers.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const tgObserver<Subject>* const pObserver = m_observers[i];
+        if (pObserver)
+        {
+            pObserver->onSaveState(static_cast<const Subject&>(*this), state);
+        }
+    }
+}
+
+template <typename Subject>
+void tgSubject<Subject>::notifyRestoreState(const std::vector<double>& state,
+                                            std::size_t& pos)
+{
+    const std::size_t n = m_observers.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        tgObserver<Subject>* const pObserver = m_observers[i];
+        if (pObserver)
+        {
+            pObserver->onRestoreState(static_cast<Subject&>(*this), state, pos);
+        }
+    }
+}
 #endif  // TG_SUBJECT_H
 
@@ -0,0 +1,72 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTagRegistry.cpp
+ * @brief Contains the definitions of members of class tgTagRegistry
+ * $Id$
+ */
+
+// This module
+#include "tgTagRegistry.h"
+// The C++ Standard Library
+#include <map>
+// POSIX threads
+#include <pthread.h>
+
+namespace
+{
+    // Initialized statically, so it can be used before main()
+    pthread_mutex_t registryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+    typedef std::map<std::string, tgTagRegistry::Id> IdMap;
+
+    /**
+     * Constructed on first use and never destroyed, so that tgTags in
+     * static objects can use it at any time
+     */
+    IdMap& ids()
+    {
+        static IdMap* const pIds = new IdMap();
+        return *pIds;
+    }
+}
+
+tgTagRegistry::Id tgTagRegistry::intern(const std::string& tag)
+{
+    pthread_mutex_lock(&registryMutex);
+    IdMap& known = ids();
+    const Id id =
+        known.insert(std::make_pair(tag, static_cast<Id>(known.size()))).first->second;
+    pthread_mutex_unlock(&registryMutex);
+    return id;
+}
+
+bool tgTagRegistry::find(const std::string& tag, Id& id)
+{
+    pthread_mutex_lock(&registryMutex);
+    const IdMap& known = ids();
+    const IdMap::const_iterator it = known.find(tag);
+    const bool found = (it != known.end());
+    if (found)
+    {
+        id = it->second;
+    }
+    pthread_mutex_unlock(&registryMutex);
+    return found;
+}
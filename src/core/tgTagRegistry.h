@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TAG_REGISTRY_H
+#define TG_TAG_REGISTRY_H
+
+/**
+ * @file tgTagRegistry.h
+ * @brief Contains the definition of class tgTagRegistry
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <string>
+
+/**
+ * Gives every tag string used in the process a small integer id, so that
+ * tgTags can compare tags without comparing strings. Ids are handed out
+ * in the order tags are first seen and are never reused. Safe to call
+ * from several threads.
+ */
+class tgTagRegistry
+{
+public:
+
+    typedef unsigned int Id;
+
+    /**
+     * @param[in] tag a single tag
+     * @return the tag's id, giving it the next one if it has none yet
+     */
+    static Id intern(const std::string& tag);
+
+    /**
+     * Look a tag up without giving it an id. A tag with no id is not in
+     * any tgTags.
+     * @param[in] tag a single tag
+     * @param[out] id the tag's id, if it has one
+     * @return true if the tag has an id
+     */
+    static bool find(const std::string& tag, Id& id);
+
+private:
+
+    // Only static members
+    tgTagRegistry();
+};
+
+#endif  // TG_TAG_REGISTRY_H
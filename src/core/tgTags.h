@@ -29,12 +29,15 @@
 #include <deque>
 #include <set>
 #include <string>
+#include <vector>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 #include <sstream>
 #include <locale>         // std::locale, std::isalnum
 
 #include "tgException.h"
+#include "tgTagRegistry.h"
 
 struct tgTagException : public tgException
 {
@@ -58,18 +61,31 @@ public:
 
     bool contains(const tgTags& tags) const
     {
-        return contains(tags.getTags());
+        return std::includes(m_ids.begin(), m_ids.end(),
+                             tags.m_ids.begin(), tags.m_ids.end());
     }
         
-    bool containsAny(const std::string& space_separated_tags)
+    bool containsAny(const std::string& space_separated_tags) const
     {
         std::deque<std::string> tags = splitTags(space_separated_tags);
         return containsAny(tags);
     }
 
-    bool containsAny(const tgTags& tags) 
+    bool containsAny(const tgTags& tags) const
     {
-        return containsAny(tags.getTags());
+        // Both are sorted
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < m_ids.size() && j < tags.m_ids.size()) {
+            if (m_ids[i] < tags.m_ids[j]) {
+                i++;
+            } else if (tags.m_ids[j] < m_ids[i]) {
+                j++;
+            } else {
+                return true;
+            }
+        }
+        return false;
     }
 
     void append(const std::string& space_separated_tags)
@@ -79,7 +95,14 @@ public:
     
     void append(const tgTags& tags) 
     {
-        append(tags.getTags());
+        // Already valid
+        for(std::size_t i = 0; i < tags.m_tags.size(); i++) {
+            if(!containsId(tags.m_order[i])) {
+                m_tags.push_back(tags.m_tags[i]);
+                m_order.push_back(tags.m_order[i]);
+                insertId(tags.m_order[i]);
+            }
+        }
     }
     
     void prepend(const std::string& space_separated_tags)
@@ -89,7 +112,13 @@ public:
     
     void prepend(const tgTags& tags)
     {
-        prepend(tags.getTags());
+        for(std::size_t i = 0; i < tags.m_tags.size(); i++) {
+            if(!containsId(tags.m_order[i])) {
+                m_tags.push_front(tags.m_tags[i]);
+                m_order.push_front(tags.m_order[i]);
+                insertId(tags.m_order[i]);
+            }
+        }
     }
     
     void remove(const std::string& space_separated_tags)
@@ -99,7 +128,9 @@ public:
 
     void remove(const tgTags& tags)
     {
-        remove(tags.getTags());
+        for(std::size_t i = 0; i < tags.m_ids.size(); i++) {
+            removeId(tags.m_ids[i]);
+        }
     }
 
     const int size() const
@@ -187,14 +218,22 @@ public:
         return true;
     }
 
-    std::deque<std::string>& getTags()
+    /**
+     * The tags in the order they were added, for display. Read only, since
+     * the ids have to stay in step with them.
+     */
+    const std::deque<std::string>& getTags() const
     {
         return m_tags;
     }
 
-    const std::deque<std::string>& getTags() const
+    /**
+     * Return the tags' ids (see tgTagRegistry), sorted and without
+     * duplicates
+     */
+    const std::vector<tgTagRegistry::Id>& getIds() const
     {
-        return m_tags;
+        return m_ids;
     }
 
     /**
@@ -206,15 +245,11 @@ public:
     }
 
     /**
-     * Return a non-const reference to the tag that is indexed by the
+     * Return a const reference to the tag that is indexed by the
      * int key. It must be in m_tags.
      * @param[in] key the key of the tag to retrieve
      * @reeturn a const reference to the tag that is indexed by key
      */
-    std::string& operator[](int key) { 
-        return m_tags[key]; 
-    }
-    
     const std::string& operator[](int key) const { 
         return m_tags[key]; 
     }
@@ -222,15 +257,20 @@ public:
     /**
      * Check if we contain the same tags regardless of ordering
      */
-    bool operator==(const tgTags& rhs)
+    bool operator==(const tgTags& rhs) const
     {
-        return rhs.asSet() == asSet(); 
+        return rhs.m_ids == m_ids; 
     }
 
     tgTags& operator+=(const tgTags& rhs)
     {
-        const std::deque<std::string>& other = rhs.getTags();
-        m_tags.insert(m_tags.end(), other.begin(), other.end());
+        m_tags.insert(m_tags.end(), rhs.m_tags.begin(), rhs.m_tags.end());
+        m_order.insert(m_order.end(), rhs.m_order.begin(), rhs.m_order.end());
+        std::vector<tgTagRegistry::Id> ids;
+        std::set_union(m_ids.begin(), m_ids.end(),
+                       rhs.m_ids.begin(), rhs.m_ids.end(),
+                       std::back_inserter(ids));
+        m_ids.swap(ids);
         return *this;
     }
 
@@ -244,8 +284,11 @@ private:
         if(!isValid(tag)) {
             throw tgTagException("Invalid tag '" + tag + "' - tags must be alphanumeric and may not be castable to int.");
         }
-        if(!containsOne(tag)) {
+        const tgTagRegistry::Id id = tgTagRegistry::intern(tag);
+        if(!containsId(id)) {
             m_tags.push_back(tag);
+            m_order.push_back(id);
+            insertId(id);
         }
     }
     
@@ -257,8 +300,13 @@ private:
     }
     
     void prependOne(std::string tag) {
-        if(isValid(tag) && !containsOne(tag)) {
-            m_tags.push_front(tag);
+        if(isValid(tag)) {
+            const tgTagRegistry::Id id = tgTagRegistry::intern(tag);
+            if(!containsId(id)) {
+                m_tags.push_front(tag);
+                m_order.push_front(id);
+                insertId(id);
+            }
         }
     }
 
@@ -286,14 +334,48 @@ private:
     }
     
     /**
-     * Check whether we contain a tag that is known to be valid
+     * Check whether we contain a tag that is known to be valid. A tag that
+     * was never added to any tgTags has no id, and is in none.
      */
-    bool containsOne(std::string tag) const {
-        return (std::find(m_tags.begin(), m_tags.end(), tag) != m_tags.end());
+    bool containsOne(const std::string& tag) const {
+        tgTagRegistry::Id id;
+        return tgTagRegistry::find(tag, id) && containsId(id);
+    }
+
+    bool containsId(tgTagRegistry::Id id) const {
+        return std::binary_search(m_ids.begin(), m_ids.end(), id);
+    }
+
+    /** Add the id of a tag we do not contain yet */
+    void insertId(tgTagRegistry::Id id) {
+        m_ids.insert(std::lower_bound(m_ids.begin(), m_ids.end(), id), id);
     }
     
-    void removeOne(std::string tag) {
-        m_tags.erase(std::remove(m_tags.begin(), m_tags.end(), tag), m_tags.end());
+    void removeOne(const std::string& tag) {
+        tgTagRegistry::Id id;
+        if(tgTagRegistry::find(tag, id)) {
+            removeId(id);
+        }
+    }
+
+    void removeId(tgTagRegistry::Id id) {
+        const std::vector<tgTagRegistry::Id>::iterator it =
+            std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if(it == m_ids.end() || *it != id) {
+            return;
+        }
+        m_ids.erase(it);
+        // operator+=() may have added it more than once
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < m_order.size(); i++) {
+            if(m_order[i] != id) {
+                m_tags[kept] = m_tags[i];
+                m_order[kept] = m_order[i];
+                kept++;
+            }
+        }
+        m_tags.resize(kept);
+        m_order.resize(kept);
     }
     
     void remove(std::deque<std::string> tags) {
@@ -302,7 +384,14 @@ private:
         }
     }
     
+    /** The tags in the order they were added */
     std::deque<std::string> m_tags;
+
+    /** The id of each of m_tags */
+    std::deque<tgTagRegistry::Id> m_order;
+
+    /** The ids of m_tags, sorted and without duplicates */
+    std::vector<tgTagRegistry::Id> m_ids;
 };
 
 /**
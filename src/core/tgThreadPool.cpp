@@ -0,0 +1,270 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgThreadPool.cpp
+ * @brief Contains the definitions of members of class tgThreadPool
+ * $Id$
+ */
+
+// This module
+#include "tgThreadPool.h"
+// The C++ Standard Library
+#include <cassert>
+#include <exception>
+#include <stdexcept>
+// POSIX
+#include <unistd.h>
+
+tgThreadPool::tgThreadPool(std::size_t nThreads) :
+    m_queued(0),
+    m_pending(0),
+    m_nextWorker(0),
+    m_stopping(false),
+    m_failed(false)
+{
+    if (nThreads == 0)
+    {
+        nThreads = hardwareConcurrency();
+    }
+
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_workAvailable, NULL);
+    pthread_cond_init(&m_allDone, NULL);
+
+    // Create all the deques before any thread can try to steal from them
+    for (std::size_t i = 0; i < nThreads; i++)
+    {
+        Worker* const pWorker = new Worker();
+        pWorker->pPool = this;
+        pWorker->index = i;
+        pthread_mutex_init(&pWorker->mutex, NULL);
+        m_workers.push_back(pWorker);
+    }
+
+    for (std::size_t i = 0; i < nThreads; i++)
+    {
+        if (pthread_create(&m_workers[i]->thread, NULL,
+                           &tgThreadPool::workerMain, m_workers[i]) != 0)
+        {
+            // Stop the threads that did start, then clean up
+            pthread_mutex_lock(&m_mutex);
+            m_stopping = true;
+            pthread_cond_broadcast(&m_workAvailable);
+            pthread_mutex_unlock(&m_mutex);
+            for (std::size_t j = 0; j < i; j++)
+            {
+                pthread_join(m_workers[j]->thread, NULL);
+            }
+            for (std::size_t j = 0; j < nThreads; j++)
+            {
+                pthread_mutex_destroy(&m_workers[j]->mutex);
+                delete m_workers[j];
+            }
+            pthread_cond_destroy(&m_allDone);
+            pthread_cond_destroy(&m_workAvailable);
+            pthread_mutex_destroy(&m_mutex);
+            throw std::runtime_error("tgThreadPool could not create a thread");
+        }
+    }
+}
+
+tgThreadPool::~tgThreadPool()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (m_pending != 0)
+    {
+        pthread_cond_wait(&m_allDone, &m_mutex);
+    }
+    m_stopping = true;
+    pthread_cond_broadcast(&m_workAvailable);
+    pthread_mutex_unlock(&m_mutex);
+
+    for (std::size_t i = 0; i < m_workers.size(); i++)
+    {
+        pthread_join(m_workers[i]->thread, NULL);
+    }
+    for (std::size_t i = 0; i < m_workers.size(); i++)
+    {
+        pthread_mutex_destroy(&m_workers[i]->mutex);
+        delete m_workers[i];
+    }
+
+    pthread_cond_destroy(&m_allDone);
+    pthread_cond_destroy(&m_workAvailable);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+void tgThreadPool::submit(Task* pTask)
+{
+    if (pTask == NULL)
+    {
+        throw std::invalid_argument("NULL pointer to tgThreadPool::Task");
+    }
+
+    // Hold the pool mutex across the push so that a worker which takes
+    // the task immediately cannot decrement m_queued before it is counted
+    pthread_mutex_lock(&m_mutex);
+    Worker& worker = *m_workers[m_nextWorker];
+    m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+
+    pthread_mutex_lock(&worker.mutex);
+    worker.tasks.push_back(pTask);
+    pthread_mutex_unlock(&worker.mutex);
+
+    m_queued++;
+    m_pending++;
+    pthread_cond_signal(&m_workAvailable);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void tgThreadPool::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (m_pending != 0)
+    {
+        pthread_cond_wait(&m_allDone, &m_mutex);
+    }
+    const bool failed = m_failed;
+    const std::string error = m_error;
+    m_failed = false;
+    m_error.clear();
+    pthread_mutex_unlock(&m_mutex);
+
+    if (failed)
+    {
+        throw std::runtime_error(error);
+    }
+}
+
+std::size_t tgThreadPool::hardwareConcurrency()
+{
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? static_cast<std::size_t>(n) : 1;
+}
+
+void* tgThreadPool::workerMain(void* arg)
+{
+    Worker* const pWorker = static_cast<Worker*>(arg);
+    assert(pWorker != NULL);
+    pWorker->pPool->workerLoop(*pWorker);
+    return NULL;
+}
+
+void tgThreadPool::workerLoop(Worker& worker)
+{
+    while (true)
+    {
+        Task* const pTask = take(worker.index);
+        if (pTask != NULL)
+        {
+            pthread_mutex_lock(&m_mutex);
+            assert(m_queued > 0);
+            m_queued--;
+            pthread_mutex_unlock(&m_mutex);
+
+            execute(pTask);
+
+            pthread_mutex_lock(&m_mutex);
+            assert(m_pending > 0);
+            if (--m_pending == 0)
+            {
+                pthread_cond_broadcast(&m_allDone);
+            }
+            pthread_mutex_unlock(&m_mutex);
+        }
+        else
+        {
+            pthread_mutex_lock(&m_mutex);
+            while (m_queued == 0 && !m_stopping)
+            {
+                pthread_cond_wait(&m_workAvailable, &m_mutex);
+            }
+            const bool done = m_stopping && (m_queued == 0);
+            pthread_mutex_unlock(&m_mutex);
+            if (done)
+            {
+                return;
+            }
+        }
+    }
+}
+
+tgThreadPool::Task* tgThreadPool::take(std::size_t i)
+{
+    const std::size_t n = m_workers.size();
+
+    // Own deque first, newest task
+    Worker& own = *m_workers[i];
+    pthread_mutex_lock(&own.mutex);
+    if (!own.tasks.empty())
+    {
+        Task* const pTask = own.tasks.back();
+        own.tasks.pop_back();
+        pthread_mutex_unlock(&own.mutex);
+        return pTask;
+    }
+    pthread_mutex_unlock(&own.mutex);
+
+    // Then steal the oldest task from the next busy worker
+    for (std::size_t k = 1; k < n; k++)
+    {
+        Worker& victim = *m_workers[(i + k) % n];
+        pthread_mutex_lock(&victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            Task* const pTask = victim.tasks.front();
+            victim.tasks.pop_front();
+            pthread_mutex_unlock(&victim.mutex);
+            return pTask;
+        }
+        pthread_mutex_unlock(&victim.mutex);
+    }
+    return NULL;
+}
+
+void tgThreadPool::execute(Task* pTask)
+{
+    std::string error;
+    bool failed = false;
+    try
+    {
+        pTask->run();
+    }
+    catch (std::exception& e)
+    {
+        failed = true;
+        error = e.what();
+    }
+    catch (...)
+    {
+        failed = true;
+        error = "unknown exception in tgThreadPool task";
+    }
+
+    if (failed)
+    {
+        pthread_mutex_lock(&m_mutex);
+        if (!m_failed)
+        {
+            m_failed = true;
+            m_error = error;
+        }
+        pthread_mutex_unlock(&m_mutex);
+    }
+}
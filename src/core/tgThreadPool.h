@@ -0,0 +1,155 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_THREAD_POOL_H
+#define TG_THREAD_POOL_H
+
+/**
+ * @file tgThreadPool.h
+ * @brief Contains the definition of class tgThreadPool
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+// POSIX threads
+#include <pthread.h>
+
+/**
+ * A fixed-size pool of worker threads with one task deque per worker.
+ * A worker pops its own deque from the back and, when that is empty,
+ * steals from the front of the other workers' deques, so long and short
+ * tasks balance out without a central queue becoming a bottleneck.
+ * The pool does not take ownership of the tasks submitted to it.
+ */
+class tgThreadPool
+{
+public:
+
+    /**
+     * A unit of work. Subclass and implement run().
+     */
+    class Task
+    {
+    public:
+        virtual ~Task() { }
+
+        /**
+         * Do the work. Exceptions derived from std::exception are caught
+         * by the pool and reported by wait().
+         */
+        virtual void run() = 0;
+    };
+
+    /**
+     * Start the worker threads.
+     * @param[in] nThreads the number of worker threads; if zero, use
+     * hardwareConcurrency()
+     * @throw std::runtime_error if a thread cannot be created
+     */
+    tgThreadPool(std::size_t nThreads = 0);
+
+    /** Wait for pending tasks, then stop and join the workers. */
+    ~tgThreadPool();
+
+    /**
+     * Queue a task. Tasks are distributed round-robin over the workers'
+     * deques and may be stolen by any idle worker.
+     * @param[in] pTask the task to run; must outlive the call to wait()
+     * @throw std::invalid_argument if pTask is NULL
+     */
+    void submit(Task* pTask);
+
+    /**
+     * Block until every submitted task has run.
+     * @throw std::runtime_error carrying the message of the first task
+     * that threw since the previous call to wait()
+     */
+    void wait();
+
+    /** @return the number of worker threads */
+    std::size_t size() const { return m_workers.size(); }
+
+    /** @return the number of online processors, at least 1 */
+    static std::size_t hardwareConcurrency();
+
+private:
+
+    /** The per-thread state. */
+    struct Worker
+    {
+        tgThreadPool* pPool;
+        std::size_t index;
+        pthread_t thread;
+        pthread_mutex_t mutex;
+        std::deque<Task*> tasks;
+    };
+
+    /** pthread entry point; arg is a Worker* */
+    static void* workerMain(void* arg);
+
+    /** The loop run by each worker thread. */
+    void workerLoop(Worker& worker);
+
+    /**
+     * Take a task from the back of worker i's deque, or steal one from the
+     * front of another worker's deque.
+     * @return the task, or NULL if every deque was empty
+     */
+    Task* take(std::size_t i);
+
+    /** Run a task and record its failure, if any. */
+    void execute(Task* pTask);
+
+    // Not copyable
+    tgThreadPool(const tgThreadPool&);
+    tgThreadPool& operator=(const tgThreadPool&);
+
+private:
+
+    std::vector<Worker*> m_workers;
+
+    /** Guards the counters, flags and error below. */
+    pthread_mutex_t m_mutex;
+
+    /** Signalled when work is queued or the pool is stopping. */
+    pthread_cond_t m_workAvailable;
+
+    /** Signalled when m_pending reaches zero. */
+    pthread_cond_t m_allDone;
+
+    /** Tasks sitting in a deque, not yet taken by a worker. */
+    std::size_t m_queued;
+
+    /** Tasks submitted but not yet finished. */
+    std::size_t m_pending;
+
+    /** Round-robin cursor for submit(). */
+    std::size_t m_nextWorker;
+
+    bool m_stopping;
+
+    /** The first failure since the last wait(), if any. */
+    bool m_failed;
+    std::string m_error;
+};
+
+#endif  // TG_THREAD_POOL_H
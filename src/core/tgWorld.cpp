@@ -26,20 +26,47 @@
 // This module
 #include "tgWorld.h"
 // This application
+#include "tgThreadPool.h"
 #include "tgWorldBulletPhysicsImpl.h"
 #include "terrain/tgBoxGround.h"
 // The C++ Standard Library
 #include <cassert>
 #include <stdexcept>
 
-tgWorld::Config::Config(double g, double ws) :
+namespace
+{
+  /** @return the number of threads config asks for */
+  std::size_t threadCount(const tgWorld::Config& config)
+  {
+    return (config.threads == 0) ?
+      tgThreadPool::hardwareConcurrency() : config.threads;
+  }
+
+  /** @return a pool for a multithreaded world, or NULL */
+  tgThreadPool* createThreadPool(const tgWorld::Config& config)
+  {
+    const std::size_t nThreads = threadCount(config);
+    return (nThreads > 1) ? new tgThreadPool(nThreads) : NULL;
+  }
+}
+
+tgWorld::Config::Config(double g, double ws, SolverType s,
+                        BroadphaseType b, int iterations, std::size_t t) :
 gravity(g),
-worldSize(ws)
+worldSize(ws),
+solver(s),
+broadphase(b),
+solverIterations(iterations),
+threads(t)
 {
   if (ws <= 0.0)
   {
     throw std::invalid_argument("worldSize is not postive");
   }
+  else if (iterations <= 0)
+  {
+    throw std::invalid_argument("solverIterations is not positive");
+  }
 }
 
 /**
@@ -49,7 +76,9 @@ worldSize(ws)
 tgWorld::tgWorld() :
   m_config(),
   m_pGround(new tgBoxGround()),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_pThreadPool(createThreadPool(m_config)),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       m_pThreadPool))
 {
   // Postcondition
   assert(invariant());
@@ -62,7 +91,9 @@ tgWorld::tgWorld() :
 tgWorld::tgWorld(const tgWorld::Config& config) :
   m_config(config),
   m_pGround(new tgBoxGround()),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_pThreadPool(createThreadPool(m_config)),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       m_pThreadPool))
 {
   // Postcondition
   assert(invariant());
@@ -75,7 +106,9 @@ tgWorld::tgWorld(const tgWorld::Config& config) :
 tgWorld::tgWorld(const tgWorld::Config& config, tgGround* ground) :
   m_config(config),
   m_pGround(ground),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_pThreadPool(createThreadPool(m_config)),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       m_pThreadPool))
 {
   // Postcondition
   assert(invariant());
@@ -84,13 +117,15 @@ tgWorld::tgWorld(const tgWorld::Config& config, tgGround* ground) :
 tgWorld::~tgWorld()
 {
   delete m_pImpl;
+  delete m_pThreadPool;
   delete m_pGround;
 }
 
 void tgWorld::reset()
 {
   delete m_pImpl;
-  m_pImpl = new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround);
+  m_pImpl = new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                         m_pThreadPool);
   // Postcondition
   assert(invariant());
 }
@@ -99,6 +134,17 @@ void tgWorld::reset(const tgWorld::Config& config)
 {
   // Update the config
   m_config = config;
+  // Keep the threads unless their number changed
+  const std::size_t nThreads = threadCount(m_config);
+  const std::size_t nRunning = (m_pThreadPool == NULL) ? 1 : m_pThreadPool->size();
+  if (nThreads != nRunning)
+  {
+    delete m_pImpl;
+    m_pImpl = NULL;
+    delete m_pThreadPool;
+    m_pThreadPool = NULL;
+    m_pThreadPool = createThreadPool(m_config);
+  }
   // Reset as usual
   reset();
 
@@ -129,6 +175,24 @@ void tgWorld::step(double dt) const
   }
 }
 
+void tgWorld::applyQueuedForces() const
+{
+  m_pImpl->applyQueuedForces();
+}
+
+void tgWorld::saveState(std::vector<double>& state) const
+{
+  m_pImpl->saveState(state);
+}
+
+void tgWorld::restoreState(const std::vector<double>& state, std::size_t& pos)
+{
+  m_pImpl->restoreState(state, pos);
+
+  // Postcondition
+  assert(invariant());
+}
+
 // Add a function that returns the amount of gravity in the world.
 // This is useful for calculating the forces applied by rigid bodies
 // inside models (e.g., ForcePlateModel.)
@@ -26,9 +26,14 @@
  * $Id$
  */
 
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
 // Forward declarations
 class tgWorldImpl;
 class tgGround;
+class tgThreadPool;
 
 /**
  * Represents the world in which the Tensegrities operate, including
@@ -44,7 +49,40 @@ public:
    */
   struct Config
   {
-	Config(double g = 9.81, double ws = 1000);
+    /** The constraint solver used to resolve contacts and joints. */
+    enum SolverType
+    {
+      /**
+       * Bullet's MLCP solver with a Dantzig (direct) LCP solve. Most
+       * accurate, but cubic in the number of contacts. The default.
+       */
+      eDantzigMLCP,
+      /** Bullet's MLCP solver with a projected Gauss-Seidel LCP solve. */
+      ePGSMLCP,
+      /**
+       * btSequentialImpulseConstraintSolver. Cheapest per contact; its
+       * accuracy is set by solverIterations.
+       */
+      eSequentialImpulse
+    };
+
+    /** The broadphase used to find potentially colliding pairs. */
+    enum BroadphaseType
+    {
+      /**
+       * btAxisSweep3 with 16384 handles, bounded by worldSize.
+       * The default.
+       */
+      eAxisSweep3,
+      /** btDbvtBroadphase. Unbounded; ignores worldSize. */
+      eDbvt
+    };
+
+	Config(double g = 9.81, double ws = 1000,
+           SolverType s = eDantzigMLCP,
+           BroadphaseType b = eAxisSweep3,
+           int iterations = 10,
+           std::size_t t = 1);
     /**
      * Gravitational acceleration.
      * The units are application depenent.
@@ -56,6 +94,25 @@ public:
      * the length of one side of the detection cube. Must be positive.
      */
     double worldSize;
+    /** The constraint solver. */
+    SolverType solver;
+    /** The broadphase. */
+    BroadphaseType broadphase;
+    /**
+     * Solver iterations per step (btContactSolverInfo::m_numIterations).
+     * Used by the sequential impulse and PGS solvers, and by the MLCP
+     * solver when it falls back to sequential impulse. Must be positive.
+     */
+    int solverIterations;
+    /**
+     * Threads to spread each step over. One (the default) builds the
+     * usual single-threaded btSoftRigidDynamicsWorld; more builds a
+     * tgParallelDynamicsWorld, which gives the same results. Zero means
+     * one per processor. Bullet and NTRT must then be built with
+     * BT_NO_PROFILE. The threads are started once and kept through
+     * every reset() that keeps their number.
+     */
+    std::size_t threads;
   };
 
   /** Construct with the default configuration. */
@@ -100,6 +157,29 @@ public:
    */
   void step(double dt) const;
 
+  /**
+   * Append the dynamic state of every body in the world.
+   * Used by tgSimulation::snapshot().
+   * @param[out] state the buffer to append to
+   */
+  void saveState(std::vector<double>& state) const;
+
+  /**
+   * Put every body back in the state appended by saveState().
+   * Used by tgSimulation::restore().
+   * @param[in] state the buffer written by saveState()
+   * @param[in,out] pos the read position
+   * @throw std::runtime_error if the bodies in the world have changed
+   */
+  void restoreState(const std::vector<double>& state, std::size_t& pos);
+
+  /**
+   * Apply the forces the models queued during their step, such as those
+   * of batched tgBulletSpringCables. Called by tgSimulation::step() after
+   * the models step; step() also applies any that are left.
+   */
+  void applyQueuedForces() const;
+
   /**
    * Return a pointer to the implementation.
    * @return a pointer to the implementation; may be NULL.
@@ -130,6 +210,12 @@ private:
   /** Implementation of the ground, such as a box, hills or ramp */
   tgGround* m_pGround;
 
+  /**
+   * The threads a multithreaded world spreads its steps over, kept from
+   * one implementation to the next. NULL for a single-threaded world.
+   */
+  tgThreadPool* m_pThreadPool;
+
   /** The implementation of the tgWorld. */
   tgWorldImpl * m_pImpl;
 };
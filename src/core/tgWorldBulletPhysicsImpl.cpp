@@ -28,7 +28,10 @@
 #include "tgWorldBulletPhysicsImpl.h"
 // This application
 #include "tgWorld.h"
+#include "tgBulletSpringCableBatch.h"
 #include "tgCast.h"
+#include "tgParallelDynamicsWorld.h"
+#include "tgThreadPool.h"
 #include "terrain/tgBulletGround.h"
 #include "terrain/tgEmptyGround.h"
 // The Bullet Physics library
@@ -50,77 +53,152 @@
 #include "LinearMath/btTransform.h"
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btMatrix3x3.h"
+#include "BulletDynamics/ConstraintSolver/btConstraintSolver.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
 
 // Ghost objects
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
 
-#define MLCP_SOLVER
-
-#ifdef MLCP_SOLVER
-
 #include "BulletDynamics/MLCPSolvers/btDantzigSolver.h"
 #include "BulletDynamics/MLCPSolvers/btSolveProjectedGaussSeidel.h"
 #include "BulletDynamics/MLCPSolvers/btMLCPSolver.h"
 
-#endif //MLCP_SOLVER
-
 /**
  * Helper class to bundle objects that have the same life cycle, so they can be
- * constructed and destructed together.
+ * constructed and destructed together. The broadphase and solver are chosen
+ * by tgWorld::Config, with one solver per thread.
  */
 class IntermediateBuildProducts
 {
     public:
-        IntermediateBuildProducts(double worldSize) : 
-            corner1 (-worldSize,-worldSize, -worldSize),
-            corner2 (worldSize, worldSize, worldSize),
+        IntermediateBuildProducts(const tgWorld::Config& config,
+                                  std::size_t nThreads) : 
+            corner1 (-config.worldSize,-config.worldSize, -config.worldSize),
+            corner2 (config.worldSize, config.worldSize, config.worldSize),
             dispatcher(&collisionConfiguration),
             ghostCallback(),
-#ifndef   MLCP_SOLVER       
-	#if (1) // More acc broadphase - remeber the comma (consider doing ifndef)
-				broadphase(corner1, corner2, 16384)
-	#endif // Broadphase
-#else
-			broadphase(corner1, corner2, 16384),
-			solver(&mlcp)
-#endif //MLCP_SOLVER  
-			
+            broadphase(createBroadphase(config))
   {
-	  broadphase.getOverlappingPairCache()->setInternalGhostPairCallback(&ghostCallback);
+	  broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(&ghostCallback);
+
+      // The destructor does not run if the constructor throws
+      try
+      {
+          mlcps.reserve(nThreads);
+          solvers.reserve(nThreads);
+          for (std::size_t i = 0; i < nThreads; i++)
+          {
+              mlcps.push_back(createMLCPSolver(config));
+              solvers.push_back(createSolver(mlcps.back()));
+          }
+      }
+      catch (...)
+      {
+          deleteAll();
+          throw;
+      }
   }
+
+  ~IntermediateBuildProducts()
+  {
+      deleteAll();
+  }
+
   const btVector3 corner1;
   const btVector3 corner2;
   btSoftBodyRigidBodyCollisionConfiguration collisionConfiguration;
   btCollisionDispatcher dispatcher;
   btGhostPairCallback ghostCallback;
-#if (0) // Default broadphase
-        btDbvtBroadphase broadphase;
-#else
-        // More accurate broadphase:
-        btAxisSweep3 broadphase;
-#endif
-
-#ifdef MLCP_SOLVER
-		btDantzigSolver mlcp;
-        //btSolveProjectedGaussSeidel mlcp;
-		btMLCPSolver solver;
-#else
-		btSequentialImpulseConstraintSolver solver;
-#endif
-	
+  btBroadphaseInterface* const broadphase;
+  /** One per solver; NULL unless one of the MLCP solvers was chosen */
+  std::vector<btMLCPSolverInterface*> mlcps;
+  /** One per thread; a single-threaded world uses only the first */
+  std::vector<btConstraintSolver*> solvers;
+
+  private:
+
+  void deleteAll()
+  {
+      // Reverse order of creation. A failed constructor may have made
+      // one more MLCP solver than solvers.
+      for (std::size_t i = mlcps.size(); i > 0; i--)
+      {
+          if (i <= solvers.size())
+          {
+              delete solvers[i - 1];
+          }
+          delete mlcps[i - 1];
+      }
+      delete broadphase;
+  }
+
+  btBroadphaseInterface* createBroadphase(const tgWorld::Config& config) const
+  {
+      switch (config.broadphase)
+      {
+      case tgWorld::Config::eAxisSweep3:
+          // More accurate broadphase
+          return new btAxisSweep3(corner1, corner2, 16384);
+      case tgWorld::Config::eDbvt:
+          return new btDbvtBroadphase();
+      default:
+          throw std::invalid_argument("Unknown broadphase in tgWorld::Config");
+      }
+  }
+
+  static btMLCPSolverInterface* createMLCPSolver(const tgWorld::Config& config)
+  {
+      switch (config.solver)
+      {
+      case tgWorld::Config::eDantzigMLCP:
+          return new btDantzigSolver();
+      case tgWorld::Config::ePGSMLCP:
+          return new btSolveProjectedGaussSeidel();
+      case tgWorld::Config::eSequentialImpulse:
+          return NULL;
+      default:
+          throw std::invalid_argument("Unknown solver in tgWorld::Config");
+      }
+  }
+
+  static btConstraintSolver* createSolver(btMLCPSolverInterface* mlcp)
+  {
+      if (mlcp)
+      {
+          return new btMLCPSolver(mlcp);
+      }
+      else
+      {
+          return new btSequentialImpulseConstraintSolver();
+      }
+  }
+
+  // Not copyable
+  IntermediateBuildProducts(const IntermediateBuildProducts&);
+  IntermediateBuildProducts& operator=(const IntermediateBuildProducts&);
 };
 
 tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config,
-        tgBulletGround* ground) :
+        tgBulletGround* ground,
+        tgThreadPool* pThreadPool) :
     tgWorldImpl(config, ground),
-    m_pIntermediateBuildProducts(new IntermediateBuildProducts(config.worldSize)),
-    m_pDynamicsWorld(createDynamicsWorld())
+    m_pThreadPool(pThreadPool),
+    m_pIntermediateBuildProducts(new IntermediateBuildProducts(config,
+        (pThreadPool == NULL) ? 1 : pThreadPool->size())),
+    m_pDynamicsWorld(createDynamicsWorld()),
+    m_pCableBatch(new tgBulletSpringCableBatch())
 {
 
     // Gravitational acceleration is down on the Y axis
     const btVector3 gravityVector(0, -config.gravity, 0);
     m_pDynamicsWorld->setGravity(gravityVector);
+
+    // Bullet's default is 10
+    m_pDynamicsWorld->getSolverInfo().m_numIterations = config.solverIterations;
 	
 	if (!tgCast::cast<tgBulletGround, tgEmptyGround>(ground) && ground != NULL)
 	{
@@ -153,6 +231,10 @@ tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config
 
 tgWorldBulletPhysicsImpl::~tgWorldBulletPhysicsImpl()
 {
+    // The cables should have left it when their models were torn down
+    assert(m_pCableBatch->size() == 0);
+    delete m_pCableBatch;
+
     // Delete all the collision objects. The dynamics world must exist.
     // Delete in reverse order of creation.
     const size_t nco = m_pDynamicsWorld->getNumCollisionObjects();
@@ -189,20 +271,33 @@ tgWorldBulletPhysicsImpl::~tgWorldBulletPhysicsImpl()
 }
 
 /**
- * Create and return a new instance of a btSoftRigidDynamicsWorld.
+ * Create and return a new instance of a btSoftRigidDynamicsWorld, or of a
+ * tgParallelDynamicsWorld on the tgWorld's threads if it has any.
  * @return a pointer to a new instance of a btSoftRigidDynamicsWorld
  */
 btDynamicsWorld* tgWorldBulletPhysicsImpl::createDynamicsWorld() const
 {    
    
-  btSoftRigidDynamicsWorld* const result =
-    new btSoftRigidDynamicsWorld(&m_pIntermediateBuildProducts->dispatcher,
-                 &m_pIntermediateBuildProducts->broadphase,
-                 &m_pIntermediateBuildProducts->solver, 
+  const std::vector<btConstraintSolver*>& solvers =
+    m_pIntermediateBuildProducts->solvers;
+  btSoftRigidDynamicsWorld* result = NULL;
+  if (m_pThreadPool != NULL)
+  {
+    result =
+      new tgParallelDynamicsWorld(&m_pIntermediateBuildProducts->dispatcher,
+                 m_pIntermediateBuildProducts->broadphase,
+                 solvers,
+                 &m_pIntermediateBuildProducts->collisionConfiguration,
+                 *m_pThreadPool);
+  }
+  else
+  {
+    result =
+      new btSoftRigidDynamicsWorld(&m_pIntermediateBuildProducts->dispatcher,
+                 m_pIntermediateBuildProducts->broadphase,
+                 solvers[0], 
                  &m_pIntermediateBuildProducts->collisionConfiguration);
-#ifdef MLCPSOLVER	
-		result ->getSolverInfo().m_minimumSolverBatchSize = 1;//for direct solver it is better to have a small A matrix
-#endif	
+  }
   return result;
 }
 
@@ -214,8 +309,134 @@ void tgWorldBulletPhysicsImpl::step(double dt)
     const btScalar timeStep = dt;
     const int maxSubSteps = 1;
     const btScalar fixedTimeStep = dt;
+
+    // Normally done by tgSimulation::step; catches forces queued since
+    applyQueuedForces();
+
     m_pDynamicsWorld->stepSimulation(timeStep, maxSubSteps, fixedTimeStep);
 
+    // The cables find their lengths again on their next step, after any
+    // body the models move before then
+    m_pCableBatch->invalidate();
+
+    // Postcondition
+    assert(invariant());
+}
+
+void tgWorldBulletPhysicsImpl::saveState(std::vector<double>& state) const
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("saveState");
+#endif //BT_NO_PROFILE
+
+    const int nco = m_pDynamicsWorld->getNumCollisionObjects();
+    const btCollisionObjectArray& oa = m_pDynamicsWorld->getCollisionObjectArray();
+    state.push_back(nco);
+    for (int i = 0; i < nco; ++i)
+    {
+        const btCollisionObject* const pCollisionObject = oa[i];
+        const btTransform& transform = pCollisionObject->getWorldTransform();
+        const btMatrix3x3& basis = transform.getBasis();
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                state.push_back(basis[row][col]);
+            }
+        }
+        const btVector3& origin = transform.getOrigin();
+        state.push_back(origin.x());
+        state.push_back(origin.y());
+        state.push_back(origin.z());
+
+        const btRigidBody* const pRigidBody =
+            btRigidBody::upcast(pCollisionObject);
+        if (pRigidBody)
+        {
+            const btVector3& linear = pRigidBody->getLinearVelocity();
+            const btVector3& angular = pRigidBody->getAngularVelocity();
+            state.push_back(linear.x());
+            state.push_back(linear.y());
+            state.push_back(linear.z());
+            state.push_back(angular.x());
+            state.push_back(angular.y());
+            state.push_back(angular.z());
+            state.push_back(pRigidBody->getActivationState());
+            state.push_back(pRigidBody->getDeactivationTime());
+        }
+    }
+}
+
+void tgWorldBulletPhysicsImpl::restoreState(const std::vector<double>& state,
+                                            std::size_t& pos)
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("restoreState");
+#endif //BT_NO_PROFILE
+
+    const int nco = m_pDynamicsWorld->getNumCollisionObjects();
+    if (pos >= state.size() || static_cast<int>(state[pos]) != nco)
+    {
+        throw std::runtime_error("Collision objects have changed since the state was saved");
+    }
+    ++pos;
+
+    btCollisionObjectArray& oa = m_pDynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < nco; ++i)
+    {
+        btCollisionObject* const pCollisionObject = oa[i];
+        btRigidBody* const pRigidBody = btRigidBody::upcast(pCollisionObject);
+        const std::size_t n = pRigidBody ? 20 : 12;
+        if (pos + n > state.size())
+        {
+            throw std::runtime_error("Saved world state is too short");
+        }
+
+        const double* const p = &state[pos];
+        const btMatrix3x3 basis(p[0], p[1], p[2],
+                                p[3], p[4], p[5],
+                                p[6], p[7], p[8]);
+        const btTransform transform(basis, btVector3(p[9], p[10], p[11]));
+
+        if (pRigidBody)
+        {
+            pRigidBody->setCenterOfMassTransform(transform);
+            if (pRigidBody->getMotionState())
+            {
+                pRigidBody->getMotionState()->setWorldTransform(transform);
+            }
+            pRigidBody->setLinearVelocity(btVector3(p[12], p[13], p[14]));
+            pRigidBody->setAngularVelocity(btVector3(p[15], p[16], p[17]));
+            pRigidBody->clearForces();
+            pRigidBody->forceActivationState(static_cast<int>(p[18]));
+            pRigidBody->setDeactivationTime(p[19]);
+        }
+        else
+        {
+            pCollisionObject->setWorldTransform(transform);
+            pCollisionObject->setInterpolationWorldTransform(transform);
+        }
+        pos += n;
+
+        // Contacts cached for the old positions no longer apply
+        btBroadphaseProxy* const pProxy = pCollisionObject->getBroadphaseHandle();
+        if (pProxy)
+        {
+            m_pDynamicsWorld->getBroadphase()->getOverlappingPairCache()
+                ->cleanProxyFromPairs(pProxy, m_pDynamicsWorld->getDispatcher());
+        }
+    }
+
+    m_pDynamicsWorld->updateAabbs();
+    m_pCableBatch->invalidate();
+    // A multithreaded world has one solver per thread
+    const std::vector<btConstraintSolver*>& solvers =
+        m_pIntermediateBuildProducts->solvers;
+    for (std::size_t i = 0; i < solvers.size(); i++)
+    {
+        solvers[i]->reset();
+    }
+
     // Postcondition
     assert(invariant());
 }
@@ -260,8 +481,13 @@ void tgWorldBulletPhysicsImpl::deleteCollisionShape(btCollisionShape* pShape)
       assert(invariant());
 }
 
+void tgWorldBulletPhysicsImpl::applyQueuedForces()
+{
+    m_pCableBatch->applyImpulses();
+}
+
 bool tgWorldBulletPhysicsImpl::invariant() const
 {
-    return (m_pDynamicsWorld != 0);
+    return (m_pDynamicsWorld != 0) && (m_pCableBatch != 0);
 }
 
@@ -43,7 +43,9 @@ class IntermediateBuildProducts;
 class btBroadphaseInterface;
 class btDispatcher;
 class tgBulletGround;
+class tgBulletSpringCableBatch;
 class tgHillyGround;
+class tgThreadPool;
 
 /**
  * Concrete class derived from tgWorldImpl for Bullet Physics
@@ -59,9 +61,12 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
    * @param[in] ground - a container class that holds a rigid body and
    * collsion object for the ground. tgEmptyGround can be used to create
    * a ground free simulation
+   * @param[in] pThreadPool the threads to spread each step over, owned
+   * by the tgWorld; NULL for the single-threaded world
    */
   tgWorldBulletPhysicsImpl(const tgWorld::Config& config,
-                           tgBulletGround* ground);
+                           tgBulletGround* ground,
+                           tgThreadPool* pThreadPool = NULL);
 
   /** Clean up Bullet Physics state. */
   ~tgWorldBulletPhysicsImpl();
@@ -73,6 +78,28 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
    */
   virtual void step(double dt);
 
+  /**
+   * Append the number of collision objects, then the transform of each
+   * one, then the velocities and activation state of each rigid body.
+   * @param[out] state the buffer to append to
+   */
+  virtual void saveState(std::vector<double>& state) const;
+
+  /**
+   * Read back the state appended by saveState(), clear accumulated
+   * forces, and flush the cached broadphase pairs and solver state
+   * so the next step starts from the restored positions.
+   * @param[in] state the buffer written by saveState()
+   * @param[in,out] pos the read position
+   * @throw std::runtime_error if the number of collision objects has
+   * changed since the state was saved
+   */
+  virtual void restoreState(const std::vector<double>& state,
+                            std::size_t& pos);
+
+  /** Apply the impulses queued in the cable batch. */
+  virtual void applyQueuedForces();
+
   /**
    * Return a reference to the dynamics world.
    * @return a reference to the dynamics world
@@ -81,6 +108,15 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
   {
     return *m_pDynamicsWorld;
   }
+
+  /**
+   * Return a reference to the registry of batched tgBulletSpringCables.
+   * @return a reference to the cable batch
+   */
+  tgBulletSpringCableBatch& cableBatch() const
+  {
+    return *m_pCableBatch;
+  }
   
 	/**
 	 * Add a btCollisionShape the a collection for deletion upon
@@ -127,6 +163,9 @@ private:
 
  private:
     
+    /** Shared with tgParallelDynamicsWorld; not owned. May be NULL. */
+    tgThreadPool* const m_pThreadPool;
+
     /** Used to build the btSoftRigidDynamicsWorld. */
     IntermediateBuildProducts * const m_pIntermediateBuildProducts;
     
@@ -135,6 +174,12 @@ private:
     /** The Bullet Physics representation of the tgWorld. 
      */
    btDynamicsWorld* m_pDynamicsWorld;
+
+    /**
+     * The anchors and lengths of the two-anchor cables, found in one pass
+     * after each step. Owned.
+     */
+    tgBulletSpringCableBatch* const m_pCableBatch;
     
     /* 
      * A btAlignedObjectArray of collision shapes for easy reference. Does not affect
@@ -28,6 +28,9 @@
 
 // Solves a compiler error. See if we can make it a forward declaration again
 #include "tgWorld.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
 
 // Forward declarations
 class tgGround;
@@ -55,6 +58,27 @@ public:
    * must be positive
    */
   virtual void step(double dt) = 0;
+
+  /**
+   * Append the dynamic state of every body in the world.
+   * @param[out] state the buffer to append to
+   */
+  virtual void saveState(std::vector<double>& state) const = 0;
+
+  /**
+   * Read back the state appended by saveState(). The world must hold
+   * the same bodies, in the same order, as when it was saved.
+   * @param[in] state the buffer written by saveState()
+   * @param[in,out] pos the read position
+   */
+  virtual void restoreState(const std::vector<double>& state,
+                            std::size_t& pos) = 0;
+
+  /**
+   * Apply any forces the models queued during their step instead of
+   * applying them at once.
+   */
+  virtual void applyQueuedForces() = 0;
 };
 
 
@@ -0,0 +1,264 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppSolverBenchmark.cpp
+ * @brief Times the stock examples under every constraint solver and
+ * broadphase offered by tgWorld::Config, over a range of solver iterations
+ * $Id$
+ */
+
+// This application
+#include "examples/3_prism/PrismModel.h"
+#include "examples/SUPERball/T6Model.h"
+#include "models/obstacles/tgBlockField.h"
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgBulletUtil.h"
+#include "core/tgModel.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgWorld.h"
+// Bullet Physics
+#include "BulletCollision/BroadphaseCollision/btDispatcher.h"
+#include "BulletCollision/NarrowPhaseCollision/btPersistentManifold.h"
+#include "BulletDynamics/Dynamics/btDynamicsWorld.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+// POSIX
+#include <sys/time.h>
+
+namespace
+{
+    /** The scenes to time. */
+    enum Scene
+    {
+        ePrism,
+        eSUPERball,
+        eSUPERballBlockField,
+        eNumScenes
+    };
+
+    const char* const sceneNames[eNumScenes] =
+    {
+        "3_prism",
+        "SUPERball",
+        "SUPERball+tgBlockField"
+    };
+
+    const tgWorld::Config::SolverType solvers[] =
+    {
+        tgWorld::Config::eDantzigMLCP,
+        tgWorld::Config::ePGSMLCP,
+        tgWorld::Config::eSequentialImpulse
+    };
+
+    const char* const solverNames[] =
+    {
+        "DantzigMLCP",
+        "PGSMLCP",
+        "SequentialImpulse"
+    };
+
+    const tgWorld::Config::BroadphaseType broadphases[] =
+    {
+        tgWorld::Config::eAxisSweep3,
+        tgWorld::Config::eDbvt
+    };
+
+    const char* const broadphaseNames[] =
+    {
+        "AxisSweep3",
+        "Dbvt"
+    };
+
+    /**
+     * Values of tgWorld::Config::solverIterations, around Bullet's
+     * default of 10. The Dantzig solver uses them only when it falls
+     * back to sequential impulse.
+     */
+    const int solverIterations[] = { 5, 10, 20, 40 };
+
+    /** What one run of a scene measured. */
+    struct Result
+    {
+        /** Mean wall clock time of tgSimulation::step, in milliseconds */
+        double msPerStep;
+        /** Mean over steps of the mean contact penetration depth */
+        double meanPenetration;
+        /** Deepest contact penetration seen in any step */
+        double maxPenetration;
+    };
+
+    double wallClockSeconds()
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + tv.tv_usec * 1.0e-6;
+    }
+
+    /**
+     * The constraint error after a step: how far the solver let contacts
+     * penetrate. Returns the mean depth over all contact points and
+     * updates maxDepth.
+     */
+    double measurePenetration(btDynamicsWorld& dynamicsWorld,
+                              double& maxDepth)
+    {
+        btDispatcher* const pDispatcher = dynamicsWorld.getDispatcher();
+        const int nManifolds = pDispatcher->getNumManifolds();
+        double total = 0.0;
+        int nContacts = 0;
+        for (int i = 0; i < nManifolds; i++)
+        {
+            const btPersistentManifold* const pManifold =
+                pDispatcher->getManifoldByIndexInternal(i);
+            const int n = pManifold->getNumContacts();
+            for (int j = 0; j < n; j++)
+            {
+                const double depth =
+                    std::max(0.0, -pManifold->getContactPoint(j).getDistance());
+                total += depth;
+                maxDepth = std::max(maxDepth, depth);
+                nContacts++;
+            }
+        }
+        return (nContacts > 0) ? total / nContacts : 0.0;
+    }
+
+    Result runScene(Scene scene, const tgWorld::Config& config, int steps)
+    {
+        // tgBlockField places its blocks with rand()
+        srand(1);
+
+        // the world will delete this
+        tgBoxGround* const ground = new tgBoxGround();
+        tgWorld world(config, ground);
+
+        const double timestep_physics = 0.001; // seconds
+        const double timestep_graphics = 1.f/60.f; // seconds
+        tgSimView view(world, timestep_physics, timestep_graphics);
+        tgSimulation simulation(view);
+
+        if (scene == ePrism)
+        {
+            simulation.addModel(new PrismModel());
+        }
+        else
+        {
+            simulation.addModel(new T6Model());
+        }
+        if (scene == eSUPERballBlockField)
+        {
+            // A dense field under the drop point, so most rods hit blocks
+            tgBlockField::Config fieldConfig(btVector3(0.0, 0.0, 0.0),
+                                             0.5, 0.0,
+                                             btVector3(-20.0, 0.0, -20.0),
+                                             btVector3(20.0, 0.0, 20.0),
+                                             200, 3.0, 3.0, 3.0);
+            simulation.addObstacle(new tgBlockField(fieldConfig));
+        }
+
+        btDynamicsWorld& dynamicsWorld =
+            tgBulletUtil::worldToDynamicsWorld(world);
+
+        Result result;
+        result.maxPenetration = 0.0;
+        double stepTime = 0.0;
+        double penetrationSum = 0.0;
+        for (int i = 0; i < steps; i++)
+        {
+            const double start = wallClockSeconds();
+            simulation.step(timestep_physics);
+            stepTime += wallClockSeconds() - start;
+
+            penetrationSum += measurePenetration(dynamicsWorld,
+                                                 result.maxPenetration);
+        }
+        result.msPerStep = 1000.0 * stepTime / steps;
+        result.meanPenetration = penetrationSum / steps;
+        return result;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1], if present, is the number of steps per run
+ * @return 0, or 1 if the number of steps is not positive
+ */
+int main(int argc, char** argv)
+{
+    std::cout << "AppSolverBenchmark" << std::endl;
+
+    const int steps = (argc > 1) ? atoi(argv[1]) : 5000;
+    if (steps <= 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [steps]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left
+              << std::setw(24) << "scene"
+              << std::setw(20) << "solver"
+              << std::setw(12) << "broadphase"
+              << std::setw(12) << "iterations"
+              << std::setw(12) << "ms/step"
+              << std::setw(16) << "mean penetration"
+              << "max penetration" << std::endl;
+
+    for (int scene = 0; scene < eNumScenes; scene++)
+    {
+        // The prism is built in cm, SUPERball in dm
+        const double gravity = (scene == ePrism) ? 981.0 : 98.1;
+
+        for (std::size_t s = 0; s < sizeof(solvers) / sizeof(solvers[0]); s++)
+        {
+            for (std::size_t b = 0;
+                 b < sizeof(broadphases) / sizeof(broadphases[0]);
+                 b++)
+            {
+                for (std::size_t i = 0;
+                     i < sizeof(solverIterations) / sizeof(solverIterations[0]);
+                     i++)
+                {
+                    const tgWorld::Config config(gravity, 1000,
+                                                 solvers[s], broadphases[b],
+                                                 solverIterations[i]);
+                    const Result r =
+                        runScene(static_cast<Scene>(scene), config, steps);
+
+                    std::cout << std::left
+                              << std::setw(24) << sceneNames[scene]
+                              << std::setw(20) << solverNames[s]
+                              << std::setw(12) << broadphaseNames[b]
+                              << std::setw(12) << solverIterations[i]
+                              << std::setw(12) << r.msPerStep
+                              << std::setw(16) << r.meanPenetration
+                              << r.maxPenetration << std::endl;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGBenchmark.cpp
+ * @brief Times CPGEquations and CPGEquationsFB updates with the array
+ * engines against the node-by-node boost::odeint path they replaced, and
+ * checks that both give the same trajectories
+ * $Id$
+ */
+
+// This library
+#include "util/CPGEquations.h"
+#include "util/CPGEquationsFB.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+// POSIX
+#include <sys/time.h>
+
+namespace
+{
+    /** The odeint path, as CPGEquations integrated before */
+    template <typename Equations>
+    class ODEIntEquations : public Equations
+    {
+    public:
+        ODEIntEquations(int maxSteps) : Equations(maxSteps) { }
+
+    protected:
+        virtual void integrate(std::vector<double>& descCom, double dt)
+        {
+            this->integrateWithODEInt(descCom, dt);
+        }
+    };
+
+    double wallClockSeconds()
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + tv.tv_usec * 1.0e-6;
+    }
+
+    /**
+     * A ring of nodes, each coupled to its two neighbours on either side,
+     * like the spine controllers' CPGs. addNode is not virtual, so this
+     * takes the exact type.
+     */
+    template <typename Equations>
+    void buildRing(Equations& cpgs, int nodes, bool feedback)
+    {
+        std::vector<double> params(feedback ? 11 : 7);
+        params[0] = 0.5; // Frequency Offset
+        params[1] = 0.1; // Frequency Scale
+        params[2] = 1.0; // Radius Offset
+        params[3] = 0.1; // Radius Scale
+        params[4] = 20.0; // rConst
+        params[5] = 0.0; // dMin
+        params[6] = 5.0; // dMax
+        if (feedback)
+        {
+            params[7] = 2.0; // Initial frequency
+            params[8] = 0.1; // kFreq
+            params[9] = 0.1; // kAmp
+            params[10] = 0.1; // kPhase
+        }
+        for (int i = 0; i < nodes; i++)
+        {
+            cpgs.addNode(params);
+        }
+        for (int i = 0; i < nodes; i++)
+        {
+            std::vector<int> connections;
+            std::vector<double> weights;
+            std::vector<double> phases;
+            for (int d = -2; d <= 2; d++)
+            {
+                if (d != 0)
+                {
+                    connections.push_back((i + d + nodes) % nodes);
+                    weights.push_back(0.5);
+                    phases.push_back(0.4 * d);
+                }
+            }
+            cpgs.defineConnections(i, connections, weights, phases);
+        }
+    }
+
+    /**
+     * Run updates at the simulation's step size and report the time per
+     * update. Returns the node values at the end.
+     */
+    std::vector<double> run(CPGEquations& cpgs, int nodes, bool feedback,
+                            int steps, double& usPerUpdate)
+    {
+        const double dt = 0.001;
+        std::vector<double> commands(feedback ? 3 * nodes : nodes);
+        const double start = wallClockSeconds();
+        for (int s = 0; s < steps; s++)
+        {
+            // Commands that change over time, as feedback does
+            for (std::size_t i = 0; i < commands.size(); i++)
+            {
+                commands[i] = 1.0 + 0.5 * std::sin(0.001 * s + i);
+            }
+            cpgs.update(commands, dt);
+        }
+        usPerUpdate = 1.0e6 * (wallClockSeconds() - start) / steps;
+
+        std::vector<double> values(nodes);
+        for (int i = 0; i < nodes; i++)
+        {
+            values[i] = cpgs[i];
+        }
+        return values;
+    }
+
+    template <typename Equations>
+    void compare(const char* name, int nodes, int steps, bool feedback)
+    {
+        ODEIntEquations<Equations> before(1000);
+        Equations after(1000);
+        buildRing(before, nodes, feedback);
+        buildRing(after, nodes, feedback);
+
+        double usBefore = 0.0;
+        double usAfter = 0.0;
+        const std::vector<double> expected =
+            run(before, nodes, feedback, steps, usBefore);
+        const std::vector<double> actual =
+            run(after, nodes, feedback, steps, usAfter);
+
+        double maxDifference = 0.0;
+        for (int i = 0; i < nodes; i++)
+        {
+            maxDifference = std::max(maxDifference,
+                                     std::fabs(expected[i] - actual[i]));
+        }
+
+        std::cout << std::left
+                  << std::setw(16) << name
+                  << std::setw(8) << nodes
+                  << std::setw(14) << usBefore
+                  << std::setw(14) << usAfter
+                  << std::setw(10) << usBefore / usAfter
+                  << maxDifference << std::endl;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1], if present, is the number of updates per run
+ * @return 0
+ */
+int main(int argc, char** argv)
+{
+    std::cout << "CPGBenchmark" << std::endl;
+
+    const int steps = (argc > 1) ? atoi(argv[1]) : 20000;
+    if (steps <= 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " [updates]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left
+              << std::setw(16) << "equations"
+              << std::setw(8) << "nodes"
+              << std::setw(14) << "odeint us"
+              << std::setw(14) << "arrays us"
+              << std::setw(10) << "speedup"
+              << "max difference" << std::endl;
+
+    const int sizes[] = { 8, 24, 64 };
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        compare<CPGEquations>("CPGEquations", sizes[i], steps, false);
+        compare<CPGEquationsFB>("CPGEquationsFB", sizes[i], steps, true);
+    }
+
+    return 0;
+}
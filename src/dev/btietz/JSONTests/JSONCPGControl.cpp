@@ -40,6 +40,7 @@
 #include "examples/learningSpines/BaseSpineCPGControl.h"
 
 #include "helpers/FileHelpers.h"
+#include "dev/btietz/JSONTests/JSONConfigCache.h"
 
 #include "util/CPGEquations.h"
 #include "util/CPGNode.h"
@@ -167,17 +168,7 @@ void JSONCPGControl::onSetup(BaseSpineModelLearning& subject)
 	m_pCPGSys = new CPGEquations(200);
     //Initialize the Learning Adapters
 
-    Json::Value root; // will contains the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
+    const Json::Value& root = JSONConfigCache::instance().get(controlFilename);
     // Get the value of the member of root named 'encoding', return 'UTF-8' if there is no
     // such member.
     Json::Value nodeVals = root.get("nodeVals", "UTF-8");
@@ -331,31 +322,11 @@ void JSONCPGControl::onTeardown(BaseSpineModelLearning& subject)
     
         std::cout << "Dist travelled " << scores[0] << std::endl;
     
-    Json::Value root; // will contains the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
-    
-    Json::Value prevScores = root.get("scores", Json::nullValue);
-    
     Json::Value subScores;
     subScores["distance"] = scores[0];
     subScores["energy"] = totalEnergySpent;
     
-    prevScores.append(subScores);
-    root["scores"] = prevScores;
-    
-    ofstream payloadLog;
-    payloadLog.open(controlFilename.c_str(),ofstream::out);
-    
-    payloadLog << root << std::endl;
+    JSONConfigCache::instance().append(controlFilename, "scores", subScores);
     
     delete m_pCPGSys;
     m_pCPGSys = NULL;
@@ -0,0 +1,228 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file JSONConfigCache.cpp
+ * @brief Contains the definitions of members of class JSONConfigCache
+ * $Id$
+ */
+
+#include "JSONConfigCache.h"
+
+#include "helpers/FileHelpers.h"
+
+#include <json/json.h>
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+namespace
+{
+    /** Holds a mutex for the life of a scope */
+    class ScopedLock
+    {
+    public:
+        ScopedLock(pthread_mutex_t& mutex) : m_mutex(mutex)
+        {
+            pthread_mutex_lock(&m_mutex);
+        }
+
+        ~ScopedLock()
+        {
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+    private:
+        pthread_mutex_t& m_mutex;
+    };
+}
+
+JSONConfigCache& JSONConfigCache::instance()
+{
+    static JSONConfigCache cache;
+    return cache;
+}
+
+JSONConfigCache::JSONConfigCache() :
+    m_waiting(0),
+    m_flushInterval(100)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+}
+
+JSONConfigCache::~JSONConfigCache()
+{
+    try
+    {
+        flushAll();
+    }
+    catch (std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    pthread_mutex_destroy(&m_mutex);
+}
+
+const Json::Value& JSONConfigCache::get(const std::string& path)
+{
+    ScopedLock lock(m_mutex);
+    return load(path).root;
+}
+
+void JSONConfigCache::put(const std::string& path, const Json::Value& root)
+{
+    ScopedLock lock(m_mutex);
+
+    std::map<std::string, Entry>::iterator it = m_entries.find(path);
+    if (it == m_entries.end())
+    {
+        // Otherwise the next get() would see a changed file and parse it
+        it = m_entries.insert(std::make_pair(path, Entry())).first;
+        it->second.stamp = stampOf(path);
+    }
+    it->second.root = root;
+    it->second.dirty = true;
+    countPut();
+}
+
+void JSONConfigCache::append(const std::string& path,
+                             const std::string& key,
+                             const Json::Value& value)
+{
+    ScopedLock lock(m_mutex);
+
+    Entry& entry = load(path);
+    entry.root[key].append(value);
+    entry.dirty = true;
+    countPut();
+}
+
+void JSONConfigCache::flush(const std::string& path)
+{
+    ScopedLock lock(m_mutex);
+
+    std::map<std::string, Entry>::iterator it = m_entries.find(path);
+    if (it != m_entries.end() && it->second.dirty)
+    {
+        write(it->first, it->second);
+    }
+}
+
+void JSONConfigCache::flushAll()
+{
+    ScopedLock lock(m_mutex);
+    writeAll();
+}
+
+void JSONConfigCache::setFlushInterval(std::size_t puts)
+{
+    ScopedLock lock(m_mutex);
+    m_flushInterval = (puts == 0) ? 1 : puts;
+}
+
+JSONConfigCache::Entry& JSONConfigCache::load(const std::string& path)
+{
+    const Stamp stamp = stampOf(path);
+    std::map<std::string, Entry>::iterator it = m_entries.find(path);
+    if (it != m_entries.end() && it->second.stamp == stamp)
+    {
+        return it->second;
+    }
+
+    if (it != m_entries.end() && it->second.dirty)
+    {
+        std::cerr << "Warning: " << path << " was replaced, dropping the "
+            << "scores that were not yet written to it" << std::endl;
+    }
+
+    Json::Value root; // will contains the root value after parsing.
+    Json::Reader reader;
+
+    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(path.c_str()), root );
+    if ( !parsingSuccessful )
+    {
+        // report to the user the failure and their locations in the document.
+        std::cout << "Failed to parse configuration\n"
+            << reader.getFormattedErrorMessages();
+        throw std::invalid_argument("Bad filename for JSON");
+    }
+
+    Entry& entry = m_entries[path];
+    entry.root.swap(root);
+    entry.stamp = stamp;
+    entry.dirty = false;
+    return entry;
+}
+
+void JSONConfigCache::countPut()
+{
+    m_waiting++;
+    if (m_waiting >= m_flushInterval)
+    {
+        writeAll();
+    }
+}
+
+void JSONConfigCache::writeAll()
+{
+    for (std::map<std::string, Entry>::iterator it = m_entries.begin();
+         it != m_entries.end(); ++it)
+    {
+        if (it->second.dirty)
+        {
+            write(it->first, it->second);
+        }
+    }
+    m_waiting = 0;
+}
+
+JSONConfigCache::Stamp JSONConfigCache::stampOf(const std::string& path)
+{
+    Stamp stamp;
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0)
+    {
+        stamp.size = info.st_size;
+        stamp.seconds = info.st_mtime;
+#if defined(__APPLE__)
+        stamp.nanoseconds = info.st_mtimespec.tv_nsec;
+#else
+        stamp.nanoseconds = info.st_mtim.tv_nsec;
+#endif
+    }
+    return stamp;
+}
+
+void JSONConfigCache::write(const std::string& path, Entry& entry)
+{
+    std::ofstream payloadLog;
+    payloadLog.open(path.c_str(), std::ofstream::out);
+
+    payloadLog << entry.root << std::endl;
+    payloadLog.close();
+    if (!payloadLog)
+    {
+        throw std::runtime_error("Could not write " + path);
+    }
+
+    entry.stamp = stampOf(path);
+    entry.dirty = false;
+}
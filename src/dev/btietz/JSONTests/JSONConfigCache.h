@@ -0,0 +1,180 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef JSON_CONFIG_CACHE_H
+#define JSON_CONFIG_CACHE_H
+
+/**
+ * @file JSONConfigCache.h
+ * @brief Contains the definition of class JSONConfigCache
+ * $Id$
+ */
+
+#include <json/value.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <pthread.h>
+
+/**
+ * A process wide cache of the parsed JSON control files. The JSON
+ * controllers read their parameters in onSetup and add their scores in
+ * onTeardown, and tgSimulation::reset runs both every episode, so
+ * without the cache each episode parses the file twice and rewrites it
+ * once.
+ *
+ * A file is parsed again only when its size or modification time
+ * changes, so a learning script can still replace it between episodes.
+ * Code in the same process should replace it with put() instead, since
+ * two writes within the clock's resolution can leave both unchanged.
+ * Documents changed with put() or append() are written back every
+ * flushInterval puts, on flush(), and when the process exits. A crash loses the
+ * scores of at most flushInterval - 1 episodes.
+ *
+ * All members may be called from several threads.
+ */
+class JSONConfigCache
+{
+public:
+
+    /** @return the cache shared by every controller in the process */
+    static JSONConfigCache& instance();
+
+    /** Writes out every changed document. */
+    ~JSONConfigCache();
+
+    /**
+     * @param[in] path the file to read
+     * @return the parsed document, parsed again only if the file changed.
+     * Not a copy: it changes with put() and append() for the same file,
+     * so read what is needed before another thread may change the file.
+     * @throw std::invalid_argument if the file does not parse
+     */
+    const Json::Value& get(const std::string& path);
+
+    /**
+     * Replace the document for a file. It is written to the file once
+     * flushInterval puts are waiting; call flush() to write it now.
+     * Replacing a file through the cache, rather than writing it
+     * directly, means get() cannot miss the change when the file's size
+     * and modification time happen to stay the same.
+     * @param[in] path the file to write
+     * @param[in] root the whole document
+     */
+    void put(const std::string& path, const Json::Value& root);
+
+    /**
+     * Append a value to an array member of a file's document, such as
+     * its scores, without copying the rest of the document. Counts as a
+     * put.
+     * @param[in] path the file to write
+     * @param[in] key the member, created if missing
+     * @param[in] value the new last element
+     * @throw std::invalid_argument if the file does not parse
+     */
+    void append(const std::string& path,
+                const std::string& key,
+                const Json::Value& value);
+
+    /**
+     * Write out a document changed by put(), if it is waiting.
+     * @param[in] path the file to write
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void flush(const std::string& path);
+
+    /**
+     * Write out every changed document.
+     * @throw std::runtime_error if a file cannot be written
+     */
+    void flushAll();
+
+    /**
+     * @param[in] puts the number of puts to collect before writing; one
+     * writes every put through, as the controllers did before the cache
+     */
+    void setFlushInterval(std::size_t puts);
+
+private:
+
+    /** What the file looked like when last read or written */
+    struct Stamp
+    {
+        Stamp() : size(-1), seconds(0), nanoseconds(0) { }
+
+        bool operator==(const Stamp& other) const
+        {
+            return size == other.size && seconds == other.seconds &&
+                nanoseconds == other.nanoseconds;
+        }
+
+        long long size;
+        long long seconds;
+        long nanoseconds;
+    };
+
+    struct Entry
+    {
+        Entry() : dirty(false) { }
+
+        Json::Value root;
+        Stamp stamp;
+        bool dirty;
+    };
+
+    JSONConfigCache();
+
+    /**
+     * Parse the file if it is not cached or has changed. Call with the
+     * lock held.
+     * @return the file's entry
+     * @throw std::invalid_argument if the file does not parse
+     */
+    Entry& load(const std::string& path);
+
+    /** Write every changed document once enough puts are waiting */
+    void countPut();
+
+    /** Write every changed document. Call with the lock held. */
+    void writeAll();
+
+    /** @return the file's current stamp, with size -1 if it is missing */
+    static Stamp stampOf(const std::string& path);
+
+    /** Write the entry's document to the file. Call with the lock held. */
+    void write(const std::string& path, Entry& entry);
+
+    // Not copyable
+    JSONConfigCache(const JSONConfigCache&);
+    JSONConfigCache& operator=(const JSONConfigCache&);
+
+private:
+
+    std::map<std::string, Entry> m_entries;
+
+    /** Puts since the last write of all documents */
+    std::size_t m_waiting;
+
+    std::size_t m_flushInterval;
+
+    pthread_mutex_t m_mutex;
+};
+
+#endif  // JSON_CONFIG_CACHE_H
@@ -26,12 +26,22 @@
  */
 
 #include "AppQuadControl.h"
+#include "dev/btietz/JSONTests/JSONConfigCache.h"
 #include "dev/btietz/JSONTests/tgCPGJSONLogger.h"
+#include "helpers/FileHelpers.h"
+#include "learning/Worker/WorkerChannel.h"
+
+// JSON
+#include <json/json.h>
+
+// The C++ Standard Library
+#include <stdexcept>
 
 AppQuadControl::AppQuadControl(int argc, char** argv)
 {
     bSetup = false;
     use_graphics = false;
+    use_worker = false;
     add_controller = true;
     add_blocks = false;
     add_hills = false;
@@ -65,6 +75,19 @@ bool AppQuadControl::setup()
     else
         view = createView(world);         // For running multiple episodes
 
+    // A worker builds the simulation for each trial it is sent
+    simulation = NULL;
+    if (use_worker)
+    {
+        bSetup = true;
+        return bSetup;
+    }
+
+    return setupSimulation();
+}
+
+bool AppQuadControl::setupSimulation()
+{
     // Third create the simulation
     simulation = new tgSimulation(*view);
 
@@ -189,6 +212,8 @@ void AppQuadControl::handleOptions(int argc, char **argv)
         ("goal_angle,B", po::value<double>(&goalAngle), "Angle of starting rotation for goal box. Degrees. Default = 0")
         ("learning_controller,l", po::value<std::string>(&suffix), "Which learned controller to write to or use. Default = default")
 	("lower_path,P", po::value<std::string>(&lowerPath), "Which resources folder in which you want to store controllers. Default = default")
+        ("worker,W", po::bool_switch(&use_worker), "Stay alive and run the trials sent on stdin, or on the worker socket. Graphics off only")
+        ("worker_socket", po::value<std::string>(&workerSocket), "Unix socket to take trials from in worker mode. Default = stdin and stdout")
     ;
 
     po::variables_map vm;
@@ -202,6 +227,11 @@ void AppQuadControl::handleOptions(int argc, char **argv)
 
     po::notify(vm);
 
+    if (use_worker)
+    {
+        use_graphics = false;
+    }
+
     if (vm.count("phys_time"))
     {
         timestep_physics = 1/vm["phys_time"].as<double>();
@@ -259,26 +289,27 @@ tgModel* AppQuadControl::getBlocks()
     return myObstacle;
 }
 
-tgWorld* AppQuadControl::createWorld()
+tgBulletGround* AppQuadControl::createGround()
 {
-    const tgWorld::Config config(
-        981 // gravity, cm/sec^2
-    );
-    
-    tgBulletGround* ground;
-    
     if (add_hills)
     {
         const tgHillyGround::Config hillGroundConfig = getHillyConfig();
-        ground = new tgHillyGround(hillGroundConfig);
+        return new tgHillyGround(hillGroundConfig);
     }
     else
     {
         const tgBoxGround::Config groundConfig = getBoxConfig();
-        ground = new tgBoxGround(groundConfig);
+        return new tgBoxGround(groundConfig);
     }
+}
+
+tgWorld* AppQuadControl::createWorld()
+{
+    const tgWorld::Config config(
+        981 // gravity, cm/sec^2
+    );
     
-    return new tgWorld(config, ground);
+    return new tgWorld(config, createGround());
 }
 
 tgSimViewGraphics *AppQuadControl::createGraphicsView(tgWorld *world)
@@ -303,6 +334,11 @@ bool AppQuadControl::run()
         // Run until the user stops
         simulation->run();
     }
+    else if (use_worker)
+    {
+        // Run trials until the learning script closes the channel
+        runWorker();
+    }
     else
     {
         // or run for a specific number of steps
@@ -365,6 +401,92 @@ void AppQuadControl::simulate(tgSimulation *simulation)
     }
 }
 
+void AppQuadControl::runWorker()
+{
+    WorkerChannel channel(workerSocket);
+    std::string request;
+    while (channel.receive(request))
+    {
+        channel.send(runTrial(request));
+    }
+}
+
+std::string AppQuadControl::runTrial(const std::string& request)
+{
+    Json::Reader reader;
+    Json::FastWriter writer;
+    Json::Value trial;
+    Json::Value reply;
+
+    if (!reader.parse(request, trial))
+    {
+        reply["error"] = "Bad trial: " + reader.getFormattedErrorMessages();
+        return writer.write(reply);
+    }
+
+    // The same terrain options as the command line
+    const int steps = trial.get("steps", nSteps).asInt();
+    const bool hills = trial.get("hills", add_hills).asBool();
+    add_blocks = trial.get("blocks", add_blocks).asBool();
+    startAngle = trial.get("angle", startAngle).asDouble();
+    goalAngle = trial.get("goalAngle", goalAngle).asDouble();
+    if (hills != add_hills)
+    {
+        add_hills = hills;
+        world->reset(createGround());
+    }
+
+    // The controller reads its parameters from its file on setup, and
+    // adds its scores to the file on teardown
+    const std::string controlFilename =
+        (lowerPath != "" ? FileHelpers::getResourcePath(lowerPath) : "") + suffix;
+    // Through the cache, so that the controller cannot read the last
+    // trial's parameters if the file's size and time do not change
+    try
+    {
+        JSONConfigCache::instance().put(controlFilename, trial["controller"]);
+        JSONConfigCache::instance().flush(controlFilename);
+    }
+    catch (std::runtime_error e)
+    {
+        reply["error"] = "Cannot write " + controlFilename;
+        return writer.write(reply);
+    }
+
+    try
+    {
+        setupSimulation();
+        simulation->run(steps);
+    }
+    catch (std::runtime_error e)
+    {
+        // Nothing to do here, score will be set to -1
+    }
+    catch (std::invalid_argument e)
+    {
+        reply["error"] = e.what();
+    }
+    delete simulation;
+    simulation = NULL;
+
+    // The scores are still in the cache; write them out for the learning
+    // scripts and reply with the same value
+    if (!reply.isMember("error"))
+    {
+        try
+        {
+            JSONConfigCache::instance().flush(controlFilename);
+            reply = JSONConfigCache::instance().get(controlFilename);
+        }
+        catch (std::invalid_argument e)
+        {
+            reply = Json::Value();
+            reply["error"] = std::string("Bad scores: ") + e.what();
+        }
+    }
+    return writer.write(reply);
+}
+
 /**
  * The entry point.
  * @param[in] argc the number of command-line arguments
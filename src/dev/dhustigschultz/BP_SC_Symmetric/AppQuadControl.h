@@ -58,7 +58,7 @@ class AppQuadControl
 public:
     AppQuadControl(int argc, char** argv);
 
-    /** Setup the simulation */
+    /** Setup the world and view, and the simulation unless a worker */
     bool setup();
     /** Run the simulation */
     bool run();
@@ -67,12 +67,18 @@ private:
     /** Parse command line options */
     void handleOptions(int argc, char** argv);
 
+    /** Create the simulation, and add the model and obstacles */
+    bool setupSimulation();
+
     const tgHillyGround::Config getHillyConfig();
     
     const tgBoxGround::Config getBoxConfig();
     
     tgModel* getBlocks();
     
+    /** Create the ground selected by add_hills */
+    tgBulletGround* createGround();
+
     /** Create the tgWorld object */
     tgWorld *createWorld();
 
@@ -84,6 +90,22 @@ private:
 
     /** Run a series of episodes for nSteps each */
     void simulate(tgSimulation *simulation);
+
+    /**
+     * Serve trials over a WorkerChannel until it is closed, keeping the
+     * process and the world alive between them.
+     */
+    void runWorker();
+
+    /**
+     * Run one trial for the learning scripts.
+     * @param[in] request a JSON object: "controller" holds what would be
+     * the contents of the controller's file; "steps", "blocks", "hills",
+     * "angle" and "goalAngle" override the command line options
+     * @return the controller's file after the trial, with its scores, or
+     * an object with an "error" member
+     */
+    std::string runTrial(const std::string& request);
     
     
     // Keep these around for cleanup
@@ -92,6 +114,7 @@ private:
     tgSimulation* simulation;
 
     bool use_graphics;
+    bool use_worker;
     bool add_controller;
     bool add_blocks;
     bool add_hills;
@@ -111,6 +134,7 @@ private:
     
     std::string lowerPath; 
     std::string suffix;
+    std::string workerSocket;
     
     bool bSetup;
 };
@@ -39,6 +39,7 @@
 
 #include "dev/dhustigschultz/BigPuppy_SpineOnly_Stats/BaseQuadModelLearning.h"
 #include "helpers/FileHelpers.h"
+#include "dev/btietz/JSONTests/JSONConfigCache.h"
 
 #include "learning/AnnealEvolution/AnnealEvolution.h"
 #include "learning/Configuration/configuration.h"
@@ -122,17 +123,7 @@ void JSONMetricsFeedbackControl::onSetup(BaseQuadModelLearning& subject)
 {
     m_pCPGSys = new CPGEquationsFB(100);
 
-    Json::Value root; // will contains the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
+    const Json::Value& root = JSONConfigCache::instance().get(controlFilename);
     // Get the value of the member of root named 'encoding', return 'UTF-8' if there is no
     // such member.
     Json::Value nodeVals = root.get("nodeVals", "UTF-8");
@@ -191,21 +182,13 @@ void JSONMetricsFeedbackControl::onSetup(BaseQuadModelLearning& subject)
     
     //"metrics" is a new section of the controller's JSON file that is 
     //added in the getNewFile function in evolution_job_master.py 
-    Json::Value prevMetrics = root.get("metrics", Json::nullValue);
-
     Json::Value subMetrics;
     subMetrics["initial COM x"] = metrics[0];
     subMetrics["initial COM y"] = metrics[1];
     subMetrics["initial COM z"] = metrics[2];
     
-    prevMetrics.append(subMetrics);
-    root["metrics"] = prevMetrics;
+    JSONConfigCache::instance().append(controlFilename, "metrics", subMetrics);
     
-    ofstream payloadLog;
-    payloadLog.open(controlFilename.c_str(),ofstream::out);
-    
-    payloadLog << root << std::endl;
-
 #ifdef PRINT_METRICS
     //Just so we know how many vector rows we need:
     std::vector<tgSpringCableActuator* > tmpStrings = subject.find<tgSpringCableActuator> ("spine ");
@@ -356,21 +339,6 @@ void JSONMetricsFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     
     std::cout << "Dist travelled " << scores[0] << std::endl;
     
-    Json::Value root; // will contain the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
-    
-    Json::Value prevScores = root.get("scores", Json::nullValue);
-    Json::Value prevMetrics = root.get("metrics", Json::nullValue);
-    
     Json::Value subScores;
     subScores["distance"] = scores[0];
     subScores["energy"] = scores[1];
@@ -380,16 +348,8 @@ void JSONMetricsFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     subMetrics["final COM y"] = metrics[1];
     subMetrics["final COM z"] = metrics[2];
     
-    prevScores.append(subScores);
-    prevMetrics.append(subMetrics);
-
-    root["scores"] = prevScores;
-    root["metrics"] = prevMetrics;
-    
-    ofstream payloadLog;
-    payloadLog.open(controlFilename.c_str(),ofstream::out);
-    
-    payloadLog << root << std::endl;
+    JSONConfigCache::instance().append(controlFilename, "scores", subScores);
+    JSONConfigCache::instance().append(controlFilename, "metrics", subMetrics);
 
 #ifdef PRINT_METRICS
     printMetrics(subject);
@@ -39,6 +39,7 @@
 
 #include "dev/dhustigschultz/BigPuppy_SpineOnly_Stats/BaseQuadModelLearning.h"
 #include "helpers/FileHelpers.h"
+#include "dev/btietz/JSONTests/JSONConfigCache.h"
 
 #include "learning/AnnealEvolution/AnnealEvolution.h"
 #include "learning/Configuration/configuration.h"
@@ -129,17 +130,7 @@ void JSONSegmentsFeedbackControl::onSetup(BaseQuadModelLearning& subject)
 {
     m_pCPGSys = new CPGEquationsFB(5000);
 
-    Json::Value root; // will contains the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
+    const Json::Value& root = JSONConfigCache::instance().get(controlFilename);
     // Get the value of the member of root named 'encoding', return 'UTF-8' if there is no
     // such member.
     Json::Value nodeVals = root.get("nodeVals", "UTF-8");
@@ -208,20 +199,12 @@ void JSONSegmentsFeedbackControl::onSetup(BaseQuadModelLearning& subject)
     
     //"metrics" is a new section of the controller's JSON file that is 
     //added in the getNewFile function in evolution_job_master.py 
-    Json::Value prevMetrics = root.get("metrics", Json::nullValue);
-
     Json::Value subMetrics;
     subMetrics["initial COM x"] = metrics[0];
     subMetrics["initial COM y"] = metrics[1];
     subMetrics["initial COM z"] = metrics[2];
     
-    prevMetrics.append(subMetrics);
-    root["metrics"] = prevMetrics;
-    
-    ofstream payloadLog;
-    payloadLog.open(controlFilename.c_str(),ofstream::out);
-    
-    payloadLog << root << std::endl;
+    JSONConfigCache::instance().append(controlFilename, "metrics", subMetrics);
 }
 
 void JSONSegmentsFeedbackControl::onStep(BaseQuadModelLearning& subject, double dt)
@@ -436,21 +419,6 @@ void JSONSegmentsFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     
     std::cout << "Dist travelled " << scores[0] << std::endl;
     
-    Json::Value root; // will contain the root value after parsing.
-    Json::Reader reader;
-
-    bool parsingSuccessful = reader.parse( FileHelpers::getFileString(controlFilename.c_str()), root );
-    if ( !parsingSuccessful )
-    {
-        // report to the user the failure and their locations in the document.
-        std::cout << "Failed to parse configuration\n"
-            << reader.getFormattedErrorMessages();
-        throw std::invalid_argument("Bad filename for JSON");
-    }
-    
-    Json::Value prevScores = root.get("scores", Json::nullValue);
-    Json::Value prevMetrics = root.get("metrics", Json::nullValue);
-    
     Json::Value subScores;
     subScores["distance"] = scores[0];
     subScores["energy"] = scores[1];
@@ -460,17 +428,9 @@ void JSONSegmentsFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     subMetrics["final COM y"] = metrics[1];
     subMetrics["final COM z"] = metrics[2];
     
-    prevScores.append(subScores);
-    prevMetrics.append(subMetrics);
+    JSONConfigCache::instance().append(controlFilename, "scores", subScores);
+    JSONConfigCache::instance().append(controlFilename, "metrics", subMetrics);
 
-    root["scores"] = prevScores;
-    root["metrics"] = prevMetrics;
-    
-    ofstream payloadLog;
-    payloadLog.open(controlFilename.c_str(),ofstream::out);
-    
-    payloadLog << root << std::endl;
-    
     delete m_pCPGSys;
     m_pCPGSys = NULL;
     
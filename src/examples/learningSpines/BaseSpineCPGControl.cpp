@@ -310,20 +310,9 @@ void BaseSpineCPGControl::onTeardown(BaseSpineModelLearning& subject)
     
     for(int i=0; i<tmpStrings.size(); i++)
     {
-        tgSpringCableActuator::SpringCableActuatorHistory stringHist = tmpStrings[i]->getHistory();
-        
-        for(int j=1; j<stringHist.tensionHistory.size(); j++)
-        {
-            const double previousTension = stringHist.tensionHistory[j-1];
-            const double previousLength = stringHist.restLengths[j-1];
-            const double currentLength = stringHist.restLengths[j];
-            //TODO: examine this assumption - free spinning motor may require more power
-            double motorSpeed = (currentLength-previousLength);
-            if(motorSpeed > 0) // Vestigial code
-                motorSpeed = 0;
-            const double workDone = previousTension * motorSpeed;
-            totalEnergySpent += workDone;
-        }
+        // Aggregated over every step, unlike tensionHistory, which
+        // histCapacity and histDecimation may shorten
+        totalEnergySpent += tmpStrings[i]->getHistory().stats.energySpent;
     }
     
     scores.push_back(totalEnergySpent);
@@ -341,6 +330,33 @@ void BaseSpineCPGControl::onTeardown(BaseSpineModelLearning& subject)
 	m_allControllers.clear();
 }
 
+void BaseSpineCPGControl::onSaveState(const BaseSpineModelLearning& subject,
+                                      std::vector<double>& state) const
+{
+    state.push_back(m_updateTime);
+    state.push_back(bogus ? 1.0 : 0.0);
+    if (m_pCPGSys != NULL)
+    {
+        m_pCPGSys->saveState(state);
+    }
+}
+
+void BaseSpineCPGControl::onRestoreState(BaseSpineModelLearning& subject,
+                                         const std::vector<double>& state,
+                                         std::size_t& pos)
+{
+    if (pos + 2 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for BaseSpineCPGControl");
+    }
+    m_updateTime = state[pos++];
+    bogus = (state[pos++] != 0.0);
+    if (m_pCPGSys != NULL)
+    {
+        m_pCPGSys->restoreState(state, pos);
+    }
+}
+
 const double BaseSpineCPGControl::getCPGValue(std::size_t i) const
 {
 	// Error handling on input done in CPG_Equations
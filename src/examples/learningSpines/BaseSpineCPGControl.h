@@ -125,6 +125,21 @@ struct Config
     virtual void onSetup(BaseSpineModelLearning& subject);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
+    
+    /**
+     * Appends the time since the last CPG update, whether the trial has
+     * gone bogus and the state of the CPG nodes
+     */
+    virtual void onSaveState(const BaseSpineModelLearning& subject,
+                             std::vector<double>& state) const;
+    
+    /**
+     * Rolls the trial back to the state appended by onSaveState. The
+     * parameters and the initial conditions of the episode are kept.
+     */
+    virtual void onRestoreState(BaseSpineModelLearning& subject,
+                                const std::vector<double>& state,
+                                std::size_t& pos);
 
 	const double getCPGValue(std::size_t i) const;
 	
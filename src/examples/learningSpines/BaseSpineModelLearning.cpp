@@ -78,6 +78,21 @@ void BaseSpineModelLearning::step(double dt)
     tgModel::step(dt);  // Step any children
 }
 
+void BaseSpineModelLearning::saveState(std::vector<double>& state) const
+{
+    notifySaveState(state);
+    
+    tgModel::saveState(state);
+}
+
+void BaseSpineModelLearning::restoreState(const std::vector<double>& state,
+                                          std::size_t& pos)
+{
+    notifyRestoreState(state, pos);
+    
+    tgModel::restoreState(state, pos);
+}
+
 const std::vector<tgSpringCableActuator*>&
 BaseSpineModelLearning::getMuscles (const std::string& key) const
 {
@@ -60,6 +60,16 @@ public:
         
     virtual void step(double dt);
     
+    /** Lets the controllers save their state, then saves the children */
+    virtual void saveState(std::vector<double>& state) const;
+    
+    /**
+     * Lets the controllers restore their state, or start a new episode,
+     * then restores the children
+     */
+    virtual void restoreState(const std::vector<double>& state,
+                              std::size_t& pos);
+    
     virtual std::vector<double> getSegmentCOM(const int n) const;
     
     virtual btVector3 getSegmentCOMVector(const int n) const;
@@ -22,6 +22,7 @@
 #include "core/tgCast.h"
 #include "core/tgSpringCableActuator.h"
 #include "core/tgString.h"
+#include "tgcreator/tgBlueprint.h"
 #include "tgcreator/tgBuildSpec.h"
 #include "tgcreator/tgBasicActuatorInfo.h"
 #include "tgcreator/tgRodInfo.h"
@@ -44,12 +45,14 @@
  */
 
 TetraSpineLearningModel::TetraSpineLearningModel(size_t segments) : 
-    BaseSpineModelLearning(segments)
+    BaseSpineModelLearning(segments),
+    m_pBlueprint(NULL)
 {
 }
 
 TetraSpineLearningModel::~TetraSpineLearningModel()
 {
+    delete m_pBlueprint;
 }
 namespace
 {
@@ -148,55 +151,58 @@ namespace
 // There are things that do this for us (@todo: reference the things that do this for us)
 void TetraSpineLearningModel::setup(tgWorld& world)
 {
-    const double edge = 38.1;
-    const double height = tgUtil::round(std::sqrt(3.0)/2 * edge);
-    std::cout << "edge: " << edge << "; height: " << height << std::endl;
-
-    // Create the tetrahedra
-    tgStructure tetra;
-    addNodes(tetra, edge, height);
-    addPairs(tetra);
-
-    // Move the first one so we can create a longer snake.
-    // Or you could move the snake at the end, up to you. 
-    tetra.move(btVector3(0.0, 2.0, 100.0));
-
-    // Create our snake segments
-    tgStructure snake;
-    addSegments(snake, tetra, edge, m_segments);
-    addMuscles(snake);
-
-    // Create the build spec that uses tags to turn the structure into a real model
-    // Note: This needs to be high enough or things fly apart...
+    if (m_pBlueprint == NULL)
+    {
+        const double edge = 38.1;
+        const double height = tgUtil::round(std::sqrt(3.0)/2 * edge);
+        std::cout << "edge: " << edge << "; height: " << height << std::endl;
+
+        // Create the tetrahedra
+        tgStructure tetra;
+        addNodes(tetra, edge, height);
+        addPairs(tetra);
+
+        // Move the first one so we can create a longer snake.
+        // Or you could move the snake at the end, up to you. 
+        tetra.move(btVector3(0.0, 2.0, 100.0));
+
+        // Create our snake segments
+        tgStructure snake;
+        addSegments(snake, tetra, edge, m_segments);
+        addMuscles(snake);
+
+        // Create the build spec that uses tags to turn the structure into a real model
+        // Note: This needs to be high enough or things fly apart...
     
 #if (0) // Original parameters
-    const double density = 4.2 / 300.0;
-    const double radius  = 0.5;
-    const double friction = 0.5;
-    const tgRod::Config rodConfig(radius, density, friction);
-    tgBuildSpec spec;
-    spec.addBuilder("rod", new tgRodInfo(rodConfig));
+        const double density = 4.2 / 300.0;
+        const double radius  = 0.5;
+        const double friction = 0.5;
+        const tgRod::Config rodConfig(radius, density, friction);
+        tgBuildSpec spec;
+        spec.addBuilder("rod", new tgRodInfo(rodConfig));
     
-    /// @todo acceleration constraint was removed on 12/10/14 Replace with tgKinematicActuator as appropreate
-    tgSpringCableActuator::Config muscleConfig(1000, 100, 0, false, 7000, 24);
-    spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+        /// @todo acceleration constraint was removed on 12/10/14 Replace with tgKinematicActuator as appropreate
+        tgSpringCableActuator::Config muscleConfig(1000, 100, 0, false, 7000, 24);
+        spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
 #else // Params for In Won
-    const double density = .00311;
-    const double radius  = 0.635;
-    const double friction = 0.5;
-    const tgRod::Config rodConfig(radius, density, friction);
-    tgBuildSpec spec;
-    spec.addBuilder("rod", new tgRodInfo(rodConfig));
+        const double density = .00311;
+        const double radius  = 0.635;
+        const double friction = 0.5;
+        const tgRod::Config rodConfig(radius, density, friction);
+        tgBuildSpec spec;
+        spec.addBuilder("rod", new tgRodInfo(rodConfig));
     
-    /// @todo acceleration constraint was removed on 12/10/14 Replace with tgKinematicActuator as appropreate
-    tgSpringCableActuator::Config muscleConfig(10000, 10, false, 0, 7000, 7.0);
-    spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+        /// @todo acceleration constraint was removed on 12/10/14 Replace with tgKinematicActuator as appropreate
+        tgSpringCableActuator::Config muscleConfig(10000, 10, false, 0, 7000, 7.0);
+        spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
 #endif
-    // Create your structureInfo
-    tgStructureInfo structureInfo(snake, spec);
+        // Resolve the structure once; resets only rebuild it into the world
+        m_pBlueprint = new tgBlueprint(snake, spec);
+    }
 
-    // Use the structureInfo to build ourselves
-    structureInfo.buildInto(*this, world);
+    // Use the blueprint to build ourselves
+    m_pBlueprint->buildInto(*this, world);
 
     // We could now use tgCast::filter or similar to pull out the models (e.g. muscles)
     // that we want to control.    
@@ -205,7 +211,7 @@ void TetraSpineLearningModel::setup(tgWorld& world)
     mapMuscles(m_muscleMap, *this);
     
     #if (0)
-    trace(structureInfo, *this);
+    trace(m_pBlueprint->getStructureInfo(), *this);
     #endif
     
     // Actually setup the children
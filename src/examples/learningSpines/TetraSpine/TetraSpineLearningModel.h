@@ -33,6 +33,7 @@
 
 
 // Forward Declarations
+class tgBlueprint;
 class tgWorld;
 
 /**
@@ -54,6 +55,11 @@ public:
     
     virtual void step(const double dt);
 
+private:
+
+    /** The snake, resolved on the first setup and rebuilt after resets */
+    tgBlueprint* m_pBlueprint;
+
 };
 
 #endif
@@ -99,6 +99,27 @@ void tgCPGActuatorControl::onStep(tgSpringCableActuator& subject, double dt)
 	}
 }
 
+void tgCPGActuatorControl::onSaveState(const tgSpringCableActuator& subject,
+                                       std::vector<double>& state) const
+{
+    state.push_back(m_controlTime);
+    state.push_back(m_totalTime);
+    state.push_back(m_commandedTension);
+}
+
+void tgCPGActuatorControl::onRestoreState(tgSpringCableActuator& subject,
+                                          const std::vector<double>& state,
+                                          std::size_t& pos)
+{
+    if (pos + 3 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgCPGActuatorControl");
+    }
+    m_controlTime = state[pos++];
+    m_totalTime = state[pos++];
+    m_commandedTension = state[pos++];
+}
+
 void tgCPGActuatorControl::assignNodeNumber (CPGEquations& CPGSys, array_2D nodeParams)
 {
     // Ensure that this hasn't already been assigned
@@ -53,6 +53,17 @@ public:
     virtual void onAttach(tgSpringCableActuator& subject);
     
     virtual void onStep(tgSpringCableActuator& subject, double dt);
+    
+    /**
+     * Appends the control timers and the commanded tension
+     */
+    virtual void onSaveState(const tgSpringCableActuator& subject,
+                             std::vector<double>& state) const;
+    
+    /** Reads back the values appended by onSaveState */
+    virtual void onRestoreState(tgSpringCableActuator& subject,
+                                const std::vector<double>& state,
+                                std::size_t& pos);
 	
 	/**
      * Can call these any time, but they'll only have the intended effect
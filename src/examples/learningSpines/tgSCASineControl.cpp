@@ -93,6 +93,29 @@ void tgSCASineControl::onStep(tgSpringCableActuator& subject, double dt)
 
 }
 
+void tgSCASineControl::onSaveState(const tgSpringCableActuator& subject,
+                                   std::vector<double>& state) const
+{
+    state.push_back(m_controlTime);
+    state.push_back(m_totalTime);
+    state.push_back(m_commandedTension);
+    m_PIDController->saveState(state);
+}
+
+void tgSCASineControl::onRestoreState(tgSpringCableActuator& subject,
+                                      const std::vector<double>& state,
+                                      std::size_t& pos)
+{
+    if (pos + 3 > state.size())
+    {
+        throw std::invalid_argument("Saved state is too short for tgSCASineControl");
+    }
+    m_controlTime = state[pos++];
+    m_totalTime = state[pos++];
+    m_commandedTension = state[pos++];
+    m_PIDController->restoreState(state, pos);
+}
+
 void tgSCASineControl::updateTensionSetpoint(double newTension)
 {
     if (newTension >= 0.0)
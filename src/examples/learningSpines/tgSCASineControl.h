@@ -44,6 +44,17 @@ public:
     virtual void onAttach(tgSpringCableActuator& subject);
     
     virtual void onStep(tgSpringCableActuator& subject, double dt);
+    
+    /**
+     * Appends the control timers and the commanded tension and the PID controller's state
+     */
+    virtual void onSaveState(const tgSpringCableActuator& subject,
+                             std::vector<double>& state) const;
+    
+    /** Reads back the values appended by onSaveState */
+    virtual void onRestoreState(tgSpringCableActuator& subject,
+                                const std::vector<double>& state,
+                                std::size_t& pos);
 	
     void updateTensionSetpoint(double newTension);
     
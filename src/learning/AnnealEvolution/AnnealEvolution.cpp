@@ -37,6 +37,27 @@
 
 using namespace std;
 
+namespace
+{
+    /** Holds a mutex for the life of a scope */
+    class ScopedLock
+    {
+    public:
+        ScopedLock(pthread_mutex_t& mutex) : m_mutex(mutex)
+        {
+            pthread_mutex_lock(&m_mutex);
+        }
+
+        ~ScopedLock()
+        {
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+    private:
+        pthread_mutex_t& m_mutex;
+    };
+}
+
 #ifdef _WIN32
 
 //  Windows
@@ -60,6 +81,8 @@ Temp(1.0)
     currentTest=0;
     subTests = 0;
     generationNumber=0;
+    pendingTrials = 0;
+    pthread_mutex_init(&scoreMutex, NULL);
 	
 	if (path != "")
 	{
@@ -104,6 +127,8 @@ Temp(1.0)
             seededPop->loadFromFile(ss.str().c_str());
         }
     }
+    learningLog = new LearningLog(resourcePath + "logs/scores.csv");
+
     if(learning)
     {
         evolutionLog.open((resourcePath + "logs/evolution" + suffix + ".csv").c_str(),ios::out);
@@ -116,6 +141,9 @@ Temp(1.0)
 
 AnnealEvolution::~AnnealEvolution()
 {
+    pthread_mutex_destroy(&scoreMutex);
+    delete learningLog;
+
     // @todo - solve the invalid pointer that occurs here
     #if (0)
     for(std::size_t i = 0; i < populations.size(); i++)
@@ -168,10 +196,15 @@ void AnnealEvolution::orderAllPopulations()
     ofstream logfileLeader;
     for(std::size_t i=0;i<populations.size();i++)
     {
+        AnnealEvoMember* best = populations[i]->getMember(0);
+        if (!learningLog->checkpointNeeded(i, best->statelessParameters))
+        {
+            continue;
+        }
         stringstream ss;
         ss << resourcePath << "logs/bestParameters-" << suffix << "-" << i << ".nnw";
 
-        populations[i]->getMember(0)->saveToFile(ss.str().c_str());
+        best->saveToFile(ss.str().c_str());
     }
 }
 
@@ -184,29 +217,31 @@ double diffclock(clock_t clock1,clock_t clock2)
 }
 #endif
 
-vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
+int AnnealEvolution::testsPerGeneration() const
 {
-    int testsToDo=0;
     if(coevolution)
-        testsToDo=numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
+        return numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
     else
-        testsToDo=populationSize; //stop when we test each element once
+        return populationSize; //stop when we test each element once
+}
 
-    if(currentTest == testsToDo)
-    {
-        orderAllPopulations();
-        mutateEveryController();
-        Temp -= 0.0; // @todo - make this a parameter
-//        cout<<"mutated the populations"<<endl;
-        this->scoresOfTheGeneration.clear();
+void AnnealEvolution::advanceGeneration()
+{
+    orderAllPopulations();
+    mutateEveryController();
+    Temp -= 0.0; // @todo - make this a parameter
+//    cout<<"mutated the populations"<<endl;
+    this->scoresOfTheGeneration.clear();
 
-        if(coevolution)
-            currentTest=0;//Start from 0
-        else
-            currentTest=populationSize-numberOfElementsToMutate; //start from the mutated ones only (last x)
-    }
+    if(coevolution)
+        currentTest=0;//Start from 0
+    else
+        currentTest=populationSize-numberOfElementsToMutate; //start from the mutated ones only (last x)
+}
 
-    selectedControllers.clear();
+vector <AnnealEvoMember *> AnnealEvolution::selectControllers()
+{
+    vector <AnnealEvoMember *> controllers;
     for(std::size_t i=0;i<populations.size();i++)
     {
         int selectedOne=0;
@@ -216,7 +251,7 @@ vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
             selectedOne=currentTest; //select the same from each pool
 
 //      cout<<"selected: "<<selectedOne<<endl;
-        selectedControllers.push_back(populations.at(i)->getMember(selectedOne));
+        controllers.push_back(populations.at(i)->getMember(selectedOne));
     }
     
     subTests++;
@@ -228,10 +263,77 @@ vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
     }
 //  cout<<"currentTest:"<<currentTest<<endl;
 
+    return controllers;
+}
+
+vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
+{
+    ScopedLock lock(scoreMutex);
+    if (pendingTrials != 0)
+    {
+        throw std::runtime_error("Trials from nextGeneration are still unscored");
+    }
+
+    if(currentTest == testsPerGeneration())
+    {
+        advanceGeneration();
+    }
+
+    selectedControllers = selectControllers();
     return selectedControllers;
 }
 
+vector< vector <AnnealEvoMember *> > AnnealEvolution::nextGeneration()
+{
+    ScopedLock lock(scoreMutex);
+    if (pendingTrials != 0)
+    {
+        throw std::runtime_error("Trials from nextGeneration are still unscored");
+    }
+
+    const int testsToDo = testsPerGeneration();
+    if(currentTest == testsToDo)
+    {
+        advanceGeneration();
+    }
+
+    trialControllers.clear();
+    while(currentTest < testsToDo)
+    {
+        trialControllers.push_back(selectControllers());
+    }
+    trialScored.assign(trialControllers.size(), false);
+    pendingTrials = trialControllers.size();
+
+    return trialControllers;
+}
+
 void AnnealEvolution::updateScores(vector <double> multiscore)
+{
+    ScopedLock lock(scoreMutex);
+    scoreControllers(selectedControllers, multiscore);
+}
+
+void AnnealEvolution::updateScores(std::size_t trial, vector <double> multiscore)
+{
+    ScopedLock lock(scoreMutex);
+    if (trial >= trialControllers.size() || trialScored[trial])
+    {
+        throw std::invalid_argument("Trial is not awaiting a score");
+    }
+
+    scoreControllers(trialControllers[trial], multiscore);
+    trialScored[trial] = true;
+    pendingTrials--;
+
+    // Ready for the next call to nextGeneration
+    if (pendingTrials == 0 && currentTest == testsPerGeneration())
+    {
+        advanceGeneration();
+    }
+}
+
+void AnnealEvolution::scoreControllers(const vector <AnnealEvoMember *>& controllers, vector <double> multiscore)
 {
     if(multiscore.size()==2)
         this->scoresOfTheGeneration.push_back(multiscore);
@@ -240,13 +342,11 @@ void AnnealEvolution::updateScores(vector <double> multiscore)
     double score=1.0* multiscore[0] - 0.0 * multiscore[1];
     
     //Record it to the file
-    ofstream payloadLog;
-    payloadLog.open((resourcePath + "logs/scores.csv").c_str(),ios::app);
-    payloadLog<<multiscore[0]<<","<<multiscore[1];
+    vector<double> row(multiscore.begin(), multiscore.begin() + 2);
     
-    for(std::size_t oneElem=0;oneElem<selectedControllers.size();oneElem++)
+    for(std::size_t oneElem=0;oneElem<controllers.size();oneElem++)
     {
-        AnnealEvoMember * controllerPointer=selectedControllers.at(oneElem);
+        AnnealEvoMember * controllerPointer=controllers.at(oneElem);
 
         controllerPointer->pastScores.push_back(score);
         double prevScore=controllerPointer->maxScore;
@@ -261,14 +361,11 @@ void AnnealEvolution::updateScores(vector <double> multiscore)
             controllerPointer->maxScore1=multiscore[0];
             controllerPointer->maxScore2=multiscore[1];
         }
-        std::size_t n = controllerPointer->statelessParameters.size();
-        for (std::size_t i = 0; i < n; i++)
-        {
-            payloadLog << "," << controllerPointer->statelessParameters[i];
-        }
+        row.insert(row.end(),
+                   controllerPointer->statelessParameters.begin(),
+                   controllerPointer->statelessParameters.end());
     }
-
-    payloadLog<<endl;
-    payloadLog.close();
+    
+    learningLog->addRow(row);
     return;
 }
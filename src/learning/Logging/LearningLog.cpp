@@ -0,0 +1,104 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file LearningLog.cpp
+ * @brief Contains the definitions of members of class LearningLog
+ * $Id$
+ */
+
+// This module
+#include "LearningLog.h"
+// The C++ Standard Library
+#include <cerrno>
+#include <sstream>
+#include <stdexcept>
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+LearningLog::LearningLog(const std::string& scoresPath) :
+    m_scoresPath(scoresPath),
+    m_fd(-1)
+{
+}
+
+LearningLog::~LearningLog()
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+}
+
+void LearningLog::addRow(const std::vector<double>& values)
+{
+    if (m_fd < 0)
+    {
+        // Appends, as the file is shared by every run in the folder
+        m_fd = ::open(m_scoresPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666);
+        if (m_fd < 0)
+        {
+            throw std::runtime_error("Cannot open " + m_scoresPath);
+        }
+    }
+
+    std::ostringstream row;
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        if (i != 0)
+        {
+            row << ",";
+        }
+        row << values[i];
+    }
+    row << "\n";
+
+    // One write for the whole row, so that O_APPEND puts it at the end
+    // of the file in one piece, whatever other processes append
+    const std::string s = row.str();
+    ssize_t written;
+    do
+    {
+        written = ::write(m_fd, s.data(), s.size());
+    }
+    while (written < 0 && errno == EINTR);
+    if (written != static_cast<ssize_t>(s.size()))
+    {
+        throw std::runtime_error("Cannot write " + m_scoresPath);
+    }
+}
+
+bool LearningLog::checkpointNeeded(std::size_t population,
+                                   const std::vector<double>& params)
+{
+    if (population >= m_checkpoints.size())
+    {
+        m_checkpoints.resize(population + 1);
+        m_checkpointed.resize(population + 1, false);
+    }
+
+    if (!params.empty() && m_checkpointed[population] &&
+        m_checkpoints[population] == params)
+    {
+        return false;
+    }
+    m_checkpoints[population] = params;
+    m_checkpointed[population] = true;
+    return true;
+}
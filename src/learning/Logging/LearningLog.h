@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef LEARNING_LOG_H
+#define LEARNING_LOG_H
+
+/**
+ * @file LearningLog.h
+ * @brief Contains the definition of class LearningLog
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * The per-trial and per-generation output of the evolution classes.
+ * Score rows are appended to one CSV file, which is opened once per run
+ * instead of once per trial. Several learners or workers may share the
+ * file, so each row goes to the file in a single write on a descriptor
+ * opened for appending, and rows from different processes do not
+ * interleave. It also remembers the best parameters last checkpointed
+ * for each population, so that unchanged parameter files are not
+ * rewritten every generation.
+ */
+class LearningLog
+{
+public:
+
+    /**
+     * @param[in] scoresPath the CSV file that rows are appended to. It
+     * is opened when the first row is added.
+     */
+    explicit LearningLog(const std::string& scoresPath);
+
+    /** Closes the file. */
+    ~LearningLog();
+
+    /**
+     * Append one comma separated row, formatted as an std::ostream
+     * formats doubles by default. The row is handed to the operating
+     * system before this returns.
+     * @param[in] values the row
+     * @throw std::runtime_error if the file cannot be opened or written
+     */
+    void addRow(const std::vector<double>& values);
+
+    /**
+     * Decide whether a population's best parameters need saving.
+     * @param[in] population the index of the population
+     * @param[in] params the parameters of its best member. Empty
+     * parameters cannot be compared, so always need saving.
+     * @return true if params differ from the last ones passed for this
+     * population; they are then remembered
+     */
+    bool checkpointNeeded(std::size_t population,
+                          const std::vector<double>& params);
+
+private:
+
+    // Not copyable
+    LearningLog(const LearningLog&);
+    LearningLog& operator=(const LearningLog&);
+
+private:
+
+    const std::string m_scoresPath;
+
+    /** The file's descriptor, or -1 until the first row */
+    int m_fd;
+
+    /** The best parameters last checkpointed, by population */
+    std::vector<std::vector<double> > m_checkpoints;
+    std::vector<bool> m_checkpointed;
+};
+
+#endif  // LEARNING_LOG_H
@@ -37,6 +37,27 @@
 
 using namespace std;
 
+namespace
+{
+	/** Holds a mutex for the life of a scope */
+	class ScopedLock
+	{
+	public:
+		ScopedLock(pthread_mutex_t& mutex) : m_mutex(mutex)
+		{
+			pthread_mutex_lock(&m_mutex);
+		}
+
+		~ScopedLock()
+		{
+			pthread_mutex_unlock(&m_mutex);
+		}
+
+	private:
+		pthread_mutex_t& m_mutex;
+	};
+}
+
 #ifdef _WIN32
 
 //  Windows
@@ -57,7 +78,10 @@ NeuroEvolution::NeuroEvolution(std::string suff, std::string config, std::string
 suffix(suff)
 {
 	currentTest=0;
+	subTests=0;
 	generationNumber=0;
+	pendingTrials=0;
+	pthread_mutex_init(&scoreMutex, NULL);
 	if (path != "")
 	{
 		resourcePath = FileHelpers::getResourcePath(path);
@@ -108,6 +132,8 @@ suffix(suff)
             seededPop->loadFromFile(ss.str().c_str());
         }
     }
+    learningLog = new LearningLog(resourcePath + "logs/scores.csv");
+
     if(learning)
     {
 		evolutionLog.open((resourcePath + "logs/evolution"+suffix+".csv").c_str(),ios::out);
@@ -120,6 +146,9 @@ suffix(suff)
 
 NeuroEvolution::~NeuroEvolution()
 {
+	pthread_mutex_destroy(&scoreMutex);
+	delete learningLog;
+
 	// @todo - solve the invalid pointer that occurs here
 	#if (0)
 	for(std::size_t i = 0; i < populations.size(); i++)
@@ -178,9 +207,14 @@ void NeuroEvolution::orderAllPopulations()
 	ofstream logfileLeader;
 	for(std::size_t i=0;i<populations.size();i++)
 	{
+		NeuroEvoMember* best = populations[i]->getMember(0);
+		if (!learningLog->checkpointNeeded(i, best->statelessParameters))
+		{
+			continue;
+		}
 		stringstream ss;
 		ss << resourcePath <<"logs/bestParameters-"<<suffix<<"-"<<i<<".nnw";
-		populations[i]->getMember(0)->saveToFile(ss.str().c_str());
+		best->saveToFile(ss.str().c_str());
 	}
 }
 
@@ -191,35 +225,37 @@ double diffclock(clock_t clock1,clock_t clock2)
 	return diffms;
 }
 
-vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
+int NeuroEvolution::testsPerGeneration() const
 {
-	int testsToDo=0;
 	if(coevolution)
-		testsToDo=numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
+		return numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
 	else
-		testsToDo=populationSize; //stop when we test each element once
+		return populationSize; //stop when we test each element once
+}
 
-	if(currentTest == testsToDo)
+void NeuroEvolution::advanceGeneration()
+{
+	orderAllPopulations();
+	if (numberOfChildren == 0)
 	{
-		orderAllPopulations();
-        if (numberOfChildren == 0)
-        {
-            mutateEveryController();
-        }
-        else
-        {
-            combineAndMutate();
-        }
-		cout<<"mutated the populations"<<endl;
-		this->scoresOfTheGeneration.clear();
-
-		if(coevolution)
-			currentTest=0;//Start from 0
-		else
-			currentTest=populationSize - numberOfElementsToMutate - numberOfChildren; //start from the mutated ones only (last x)
+		mutateEveryController();
 	}
+	else
+	{
+		combineAndMutate();
+	}
+	cout<<"mutated the populations"<<endl;
+	this->scoresOfTheGeneration.clear();
+
+	if(coevolution)
+		currentTest=0;//Start from 0
+	else
+		currentTest=populationSize - numberOfElementsToMutate - numberOfChildren; //start from the mutated ones only (last x)
+}
 
-	selectedControllers.clear();
+vector <NeuroEvoMember *> NeuroEvolution::selectControllers()
+{
+	vector <NeuroEvoMember *> controllers;
 	for(std::size_t i=0;i<populations.size();i++)
 	{
 		int selectedOne=0;
@@ -229,7 +265,7 @@ vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
 			selectedOne=currentTest; //select the same from each pool
 
 //		cout<<"selected: "<<selectedOne<<endl;
-		selectedControllers.push_back(populations.at(i)->getMember(selectedOne));
+		controllers.push_back(populations.at(i)->getMember(selectedOne));
 	}
     subTests++;
     
@@ -240,19 +276,86 @@ vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
     }
 //	cout<<"currentTest:"<<currentTest<<endl;
 
+	return controllers;
+}
+
+vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
+{
+	ScopedLock lock(scoreMutex);
+	if (pendingTrials != 0)
+	{
+		throw std::runtime_error("Trials from nextGeneration are still unscored");
+	}
+
+	if(currentTest == testsPerGeneration())
+	{
+		advanceGeneration();
+	}
+
+	selectedControllers = selectControllers();
 	return selectedControllers;
 }
 
+vector< vector <NeuroEvoMember *> > NeuroEvolution::nextGeneration()
+{
+	ScopedLock lock(scoreMutex);
+	if (pendingTrials != 0)
+	{
+		throw std::runtime_error("Trials from nextGeneration are still unscored");
+	}
+
+	const int testsToDo = testsPerGeneration();
+	if(currentTest == testsToDo)
+	{
+		advanceGeneration();
+	}
+
+	trialControllers.clear();
+	while(currentTest < testsToDo)
+	{
+		trialControllers.push_back(selectControllers());
+	}
+	trialScored.assign(trialControllers.size(), false);
+	pendingTrials = trialControllers.size();
+
+	return trialControllers;
+}
+
 void NeuroEvolution::updateScores(vector <double> multiscore)
+{
+	ScopedLock lock(scoreMutex);
+	scoreControllers(selectedControllers, multiscore);
+}
+
+void NeuroEvolution::updateScores(std::size_t trial, vector <double> multiscore)
+{
+	ScopedLock lock(scoreMutex);
+	if (trial >= trialControllers.size() || trialScored[trial])
+	{
+		throw std::invalid_argument("Trial is not awaiting a score");
+	}
+
+	scoreControllers(trialControllers[trial], multiscore);
+	trialScored[trial] = true;
+	pendingTrials--;
+
+	// Ready for the next call to nextGeneration
+	if (pendingTrials == 0 && currentTest == testsPerGeneration())
+	{
+		advanceGeneration();
+	}
+}
+
+void NeuroEvolution::scoreControllers(const vector <NeuroEvoMember *>& controllers, vector <double> multiscore)
 {
 	if(multiscore.size()==2)
 		this->scoresOfTheGeneration.push_back(multiscore);
 	else
 		multiscore.push_back(-1.0);
 	double score=1.0* multiscore[0] - 0.0 * multiscore[1];
-	for(std::size_t oneElem=0;oneElem<selectedControllers.size();oneElem++)
+	for(std::size_t oneElem=0;oneElem<controllers.size();oneElem++)
 	{
-		NeuroEvoMember * controllerPointer=selectedControllers.at(oneElem);
+		NeuroEvoMember * controllerPointer=controllers.at(oneElem);
 
 		controllerPointer->pastScores.push_back(score);
 		double prevScore=controllerPointer->maxScore;
@@ -270,9 +373,7 @@ void NeuroEvolution::updateScores(vector <double> multiscore)
 	}
 
 	//Record it to the file
-	ofstream payloadLog;
-	payloadLog.open((resourcePath + "logs/scores.csv").c_str(),ios::app);
-	payloadLog<<multiscore[0]<<","<<multiscore[1]<<endl;
-	payloadLog.close();
+	vector<double> row(multiscore.begin(), multiscore.begin() + 2);
+	learningLog->addRow(row);
 	return;
 }
@@ -30,7 +30,10 @@
 
 #include "NeuroEvoPopulation.h"
 #include "NeuroEvoMember.h"
+#include "learning/Logging/LearningLog.h"
 #include <fstream>
+#include <vector>
+#include <pthread.h>
 
 class NeuroEvolution
 {
@@ -43,10 +46,37 @@ public:
 	void evaluatePopulation();
 	std::vector< NeuroEvoMember *> nextSetOfControllers();
 	void updateScores(std::vector<double> scores);
+
+	/**
+	 * Hand out every trial left in the current generation at once, so
+	 * they can be run in parallel, each on its own tgWorld and model.
+	 * Starts the next generation first if the current one is complete.
+	 * A member may appear in more than one trial (subtests, coevolution),
+	 * so a worker should run a copy of any member it steps.
+	 * @return the controllers of each trial, one per population
+	 * @throw std::runtime_error if trials of the last call are unscored
+	 */
+	std::vector< std::vector< NeuroEvoMember *> > nextGeneration();
+
+	/**
+	 * Score a trial handed out by nextGeneration(). May be called from
+	 * any thread. Scores are applied in the order they arrive, and the
+	 * generation advances once every trial is scored.
+	 * @param[in] trial the index of the trial in nextGeneration()'s result
+	 * @param[in] scores as for updateScores(scores)
+	 * @throw std::invalid_argument if the trial is unknown or scored
+	 */
+	void updateScores(std::size_t trial, std::vector<double> scores);
+
     const std::string suffix;
     /// @todo make this const if we decide to force everyone to put their logs in resources
     std::string resourcePath;
 private:
+	int testsPerGeneration() const;
+	void advanceGeneration();
+	std::vector< NeuroEvoMember *> selectControllers();
+	void scoreControllers(const std::vector< NeuroEvoMember *>& controllers, std::vector<double> multiscore);
+
 	int populationSize;
 	int numberOfControllers;
 	std::tr1::ranlux64_base_01 eng;
@@ -59,6 +89,8 @@ private:
     bool seeded;
 	bool coevolution;
 	std::ofstream evolutionLog;
+	/** The scores of every trial, and the best parameter checkpoints */
+	LearningLog* learningLog;
 	int currentTest;
 	int numberOfTestsBetweenGenerations;
 	int generationNumber;
@@ -66,6 +98,12 @@ private:
     int numberOfChildren;
     int numberOfSubtests;
     int subTests;
+    /** The trials of the last nextGeneration() call */
+    std::vector< std::vector< NeuroEvoMember *> > trialControllers;
+    std::vector<bool> trialScored;
+    std::size_t pendingTrials;
+    /** Guards the scores and the generation against parallel trials */
+    pthread_mutex_t scoreMutex;
 };
 
 #endif /* NEUROEVOLUTION_H_ */
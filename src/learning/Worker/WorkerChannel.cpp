@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file WorkerChannel.cpp
+ * @brief Contains the definitions of members of class WorkerChannel
+ * $Id$
+ */
+
+// This module
+#include "WorkerChannel.h"
+// The C++ Standard Library
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+// POSIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    const std::size_t headerSize = 4;
+
+    std::string errorText(const std::string& what)
+    {
+        return what + ": " + std::strerror(errno);
+    }
+}
+
+WorkerChannel::WorkerChannel(const std::string& socketPath) :
+    m_in(-1),
+    m_out(-1)
+{
+    if (!socketPath.empty())
+    {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            throw std::runtime_error("Worker socket path is too long");
+        }
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, socketPath.c_str());
+
+        m_in = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_in < 0)
+        {
+            throw std::runtime_error(errorText("Cannot create worker socket"));
+        }
+        if (connect(m_in, reinterpret_cast<sockaddr*>(&address),
+                    sizeof(address)) != 0)
+        {
+            const std::string message =
+                errorText("Cannot connect to " + socketPath);
+            close(m_in);
+            throw std::runtime_error(message);
+        }
+        m_out = m_in;
+    }
+    else
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+        m_in = STDIN_FILENO;
+        m_out = dup(STDOUT_FILENO);
+        if (m_out < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+        {
+            throw std::runtime_error(errorText("Cannot redirect stdout"));
+        }
+    }
+}
+
+WorkerChannel::~WorkerChannel()
+{
+    // Either the socket, or the saved stdout. stdin is left open.
+    close(m_out);
+}
+
+bool WorkerChannel::receive(std::string& message)
+{
+    unsigned char header[headerSize];
+    const std::size_t got =
+        readFully(reinterpret_cast<char*>(header), headerSize);
+    if (got == 0)
+    {
+        return false;
+    }
+    else if (got != headerSize)
+    {
+        throw std::runtime_error("Worker channel closed inside a message");
+    }
+
+    const std::size_t size = (static_cast<std::size_t>(header[0]) << 24) |
+                             (static_cast<std::size_t>(header[1]) << 16) |
+                             (static_cast<std::size_t>(header[2]) << 8) |
+                             static_cast<std::size_t>(header[3]);
+    if (size > maxMessageSize)
+    {
+        throw std::runtime_error("Worker message is too long");
+    }
+
+    message.resize(size);
+    if (size != 0 && readFully(&message[0], size) != size)
+    {
+        throw std::runtime_error("Worker channel closed inside a message");
+    }
+    return true;
+}
+
+void WorkerChannel::send(const std::string& message)
+{
+    const std::size_t size = message.size();
+    if (size > maxMessageSize)
+    {
+        throw std::runtime_error("Worker message is too long");
+    }
+
+    // One write for short replies, so they are not split into two packets
+    std::string frame(headerSize, '\0');
+    frame[0] = static_cast<char>((size >> 24) & 0xff);
+    frame[1] = static_cast<char>((size >> 16) & 0xff);
+    frame[2] = static_cast<char>((size >> 8) & 0xff);
+    frame[3] = static_cast<char>(size & 0xff);
+    frame += message;
+    writeFully(frame.data(), frame.size());
+}
+
+std::size_t WorkerChannel::readFully(char* buffer, std::size_t size)
+{
+    std::size_t done = 0;
+    while (done < size)
+    {
+        const ssize_t n = read(m_in, buffer + done, size - done);
+        if (n > 0)
+        {
+            done += n;
+        }
+        else if (n == 0)
+        {
+            break;
+        }
+        else if (errno != EINTR)
+        {
+            throw std::runtime_error(errorText("Cannot read worker message"));
+        }
+    }
+    return done;
+}
+
+void WorkerChannel::writeFully(const char* buffer, std::size_t size)
+{
+    std::size_t done = 0;
+    while (done < size)
+    {
+        const ssize_t n = write(m_out, buffer + done, size - done);
+        if (n >= 0)
+        {
+            done += n;
+        }
+        else if (errno != EINTR)
+        {
+            throw std::runtime_error(errorText("Cannot write worker message"));
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef WORKER_CHANNEL_H
+#define WORKER_CHANNEL_H
+
+/**
+ * @file WorkerChannel.h
+ * @brief Contains the definition of class WorkerChannel
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <string>
+
+/**
+ * The message stream between a learning app running as a persistent
+ * worker and the script that feeds it trials. Each message is a four
+ * byte length, most significant byte first, followed by that many bytes
+ * of payload. The learning apps send JSON payloads, but the channel
+ * does not look inside them.
+ *
+ * On stdin and stdout, the channel keeps the original stdout for its
+ * replies and points file descriptor 1 at stderr, so that the console
+ * output of models and controllers cannot corrupt the stream.
+ */
+class WorkerChannel
+{
+public:
+
+    /** The largest payload accepted, so a corrupt length fails fast. */
+    static const std::size_t maxMessageSize = 64 * 1024 * 1024;
+
+    /**
+     * Open the channel.
+     * @param[in] socketPath a Unix domain socket to connect to, or empty
+     * to use stdin and stdout
+     * @throw std::runtime_error if the socket cannot be connected or the
+     * file descriptors cannot be duplicated
+     */
+    explicit WorkerChannel(const std::string& socketPath = "");
+
+    /** Closes the socket, or the saved stdout. */
+    ~WorkerChannel();
+
+    /**
+     * Block until the next message arrives.
+     * @param[out] message the payload
+     * @return false if the other end closed the channel between messages
+     * @throw std::runtime_error on a read error, a message cut short or
+     * a length over maxMessageSize
+     */
+    bool receive(std::string& message);
+
+    /**
+     * Send one message.
+     * @param[in] message the payload
+     * @throw std::runtime_error on a write error or a message over
+     * maxMessageSize
+     */
+    void send(const std::string& message);
+
+private:
+
+    /**
+     * Read exactly size bytes.
+     * @return the number of bytes read, less than size only at the end
+     * of the stream
+     */
+    std::size_t readFully(char* buffer, std::size_t size);
+
+    void writeFully(const char* buffer, std::size_t size);
+
+    // Not copyable
+    WorkerChannel(const WorkerChannel&);
+    WorkerChannel& operator=(const WorkerChannel&);
+
+private:
+
+    int m_in;
+
+    /** The socket again, or the saved stdout */
+    int m_out;
+};
+
+#endif  // WORKER_CHANNEL_H
@@ -0,0 +1,233 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgAsyncLogWriter.cpp
+ * @brief Contains the implementation of class tgAsyncLogWriter.
+ * $Id$
+ */
+
+// This module
+#include "tgAsyncLogWriter.h"
+// Includes from the C++ standard library
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <stdexcept>
+// POSIX
+#include <time.h>
+
+namespace
+{
+  /** @return the absolute time the given number of seconds from now */
+  timespec deadlineAfter(double seconds)
+  {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    double whole;
+    const double fraction = std::modf(seconds, &whole);
+    deadline.tv_sec += static_cast<time_t>(whole);
+    deadline.tv_nsec += static_cast<long>(fraction * 1e9);
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+  }
+}
+
+tgAsyncLogWriter::tgAsyncLogWriter(const std::string& fileName,
+				   std::size_t blockSize,
+				   double flushInterval,
+				   bool append,
+				   Formatter* pFormatter) :
+  m_fileName(fileName),
+  m_blockSize(blockSize),
+  m_flushInterval(flushInterval),
+  m_file(NULL),
+  m_pFormatter(pFormatter),
+  m_flushesRequested(0),
+  m_flushesDone(0),
+  m_stopping(false),
+  m_closed(false),
+  m_failed(false)
+{
+  if (m_blockSize == 0) {
+    delete m_pFormatter;
+    throw std::invalid_argument("Block size must be positive.");
+  }
+  if (m_flushInterval <= 0.0) {
+    delete m_pFormatter;
+    throw std::invalid_argument("Flush interval must be positive.");
+  }
+
+  m_file = std::fopen(m_fileName.c_str(), append ? "a" : "w");
+  if (m_file == NULL) {
+    delete m_pFormatter;
+    throw std::runtime_error("Could not open " + m_fileName);
+  }
+  // The buffers here already gather the data into blocks; without this
+  // the stdio buffer would hold each block back until the next flush.
+  std::setvbuf(m_file, NULL, _IONBF, 0);
+
+  // Both buffers keep their storage, so steady logging does not allocate
+  m_front.reserve(m_blockSize);
+  m_back.reserve(m_blockSize);
+
+  pthread_mutex_init(&m_mutex, NULL);
+  pthread_cond_init(&m_work, NULL);
+  pthread_cond_init(&m_flushed, NULL);
+
+  if (pthread_create(&m_thread, NULL, &tgAsyncLogWriter::writerMain, this) != 0) {
+    pthread_cond_destroy(&m_flushed);
+    pthread_cond_destroy(&m_work);
+    pthread_mutex_destroy(&m_mutex);
+    std::fclose(m_file);
+    delete m_pFormatter;
+    throw std::runtime_error("Could not start the log writer thread.");
+  }
+}
+
+tgAsyncLogWriter::~tgAsyncLogWriter()
+{
+  shutdown();
+  pthread_cond_destroy(&m_flushed);
+  pthread_cond_destroy(&m_work);
+  pthread_mutex_destroy(&m_mutex);
+  delete m_pFormatter;
+}
+
+void tgAsyncLogWriter::write(const char* data, std::size_t n)
+{
+  pthread_mutex_lock(&m_mutex);
+  if (!m_closed) {
+    m_front.insert(m_front.end(), data, data + n);
+    if (m_front.size() >= m_blockSize) {
+      pthread_cond_signal(&m_work);
+    }
+  }
+  pthread_mutex_unlock(&m_mutex);
+}
+
+void tgAsyncLogWriter::flush()
+{
+  pthread_mutex_lock(&m_mutex);
+  if (!m_closed) {
+    const unsigned long ticket = ++m_flushesRequested;
+    pthread_cond_signal(&m_work);
+    while (m_flushesDone < ticket) {
+      pthread_cond_wait(&m_flushed, &m_mutex);
+    }
+  }
+  const bool failed = m_failed;
+  pthread_mutex_unlock(&m_mutex);
+
+  if (failed) {
+    throw std::runtime_error("Could not write to " + m_fileName);
+  }
+}
+
+void tgAsyncLogWriter::close()
+{
+  shutdown();
+  if (m_failed) {
+    throw std::runtime_error("Could not write to " + m_fileName);
+  }
+}
+
+void tgAsyncLogWriter::shutdown()
+{
+  pthread_mutex_lock(&m_mutex);
+  if (m_closed) {
+    pthread_mutex_unlock(&m_mutex);
+    return;
+  }
+  m_closed = true;
+  m_stopping = true;
+  pthread_cond_signal(&m_work);
+  pthread_mutex_unlock(&m_mutex);
+
+  // The thread writes out what is left before it exits
+  pthread_join(m_thread, NULL);
+  if (std::fclose(m_file) != 0) {
+    m_failed = true;
+  }
+  m_file = NULL;
+}
+
+void* tgAsyncLogWriter::writerMain(void* arg)
+{
+  static_cast<tgAsyncLogWriter*>(arg)->writerLoop();
+  return NULL;
+}
+
+void tgAsyncLogWriter::writerLoop()
+{
+  pthread_mutex_lock(&m_mutex);
+  while (true) {
+    // Wait for a full block, a flush, the end, or the interval to pass
+    // with something in the buffer
+    timespec deadline = deadlineAfter(m_flushInterval);
+    while (!m_stopping &&
+	   m_front.size() < m_blockSize &&
+	   m_flushesDone == m_flushesRequested) {
+      if (pthread_cond_timedwait(&m_work, &m_mutex, &deadline) == ETIMEDOUT) {
+	if (!m_front.empty()) {
+	  break;
+	}
+	// Nothing to write; start a new interval
+	deadline = deadlineAfter(m_flushInterval);
+      }
+    }
+
+    const unsigned long flushTarget = m_flushesRequested;
+    const bool stopping = m_stopping;
+    m_front.swap(m_back);
+    pthread_mutex_unlock(&m_mutex);
+
+    // The simulation thread keeps filling the other buffer meanwhile
+    bool ok = true;
+    if (!m_back.empty()) {
+      if (m_pFormatter != NULL) {
+	m_text.clear();
+	m_pFormatter->format(&m_back[0], m_back.size(), m_text);
+	m_back.swap(m_text);
+      }
+      if (!m_back.empty()) {
+	ok = std::fwrite(&m_back[0], 1, m_back.size(), m_file) == m_back.size();
+      }
+      m_back.clear();
+    }
+    if (stopping || flushTarget != m_flushesDone) {
+      ok = (std::fflush(m_file) == 0) && ok;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    if (!ok) {
+      m_failed = true;
+    }
+    if (m_flushesDone != flushTarget) {
+      m_flushesDone = flushTarget;
+      pthread_cond_broadcast(&m_flushed);
+    }
+    if (stopping && m_front.empty()) {
+      break;
+    }
+  }
+  pthread_mutex_unlock(&m_mutex);
+}
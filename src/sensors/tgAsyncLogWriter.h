@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_ASYNC_LOG_WRITER_H
+#define TG_ASYNC_LOG_WRITER_H
+
+/**
+ * @file tgAsyncLogWriter.h
+ * @brief Contains the definition of class tgAsyncLogWriter.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+// POSIX threads
+#include <pthread.h>
+
+/**
+ * tgAsyncLogWriter appends to a file from a background thread, so that
+ * loggers only pay for a copy into memory on the simulation thread.
+ * The file is held open for the life of the writer. Data goes into a
+ * front buffer; the writer thread swaps it with a back buffer and
+ * writes that out once the front buffer holds a block's worth of data,
+ * or once the flush interval has passed, whichever comes first.
+ * A Formatter can turn the data into text on the writer thread, so that
+ * loggers hand over raw values and do no formatting themselves.
+ */
+class tgAsyncLogWriter
+{
+ public:
+
+  /**
+   * Turns the bytes handed to write() into the bytes written to the
+   * file. Runs on the writer thread.
+   */
+  class Formatter
+  {
+  public:
+    virtual ~Formatter() { }
+
+    /**
+     * @param[in] data the bytes of one or more whole write() calls, in
+     * the order they were made
+     * @param[in] n the number of bytes
+     * @param[out] out what to write to the file; append to it
+     */
+    virtual void format(const char* data, std::size_t n,
+			std::vector<char>& out) = 0;
+  };
+
+  /**
+   * Open the file, truncating it unless asked to append, and start the
+   * writer thread.
+   * @param[in] fileName the path of the file to write
+   * @param[in] blockSize the number of bytes to collect before writing;
+   * must be positive
+   * @param[in] flushInterval the longest time in seconds that data
+   * waits in memory; must be positive
+   * @param[in] append true to add to the end of an existing file
+   * @param[in] pFormatter if not NULL, formats the data before it is
+   * written. The writer deletes it, also if construction fails.
+   * @throw std::invalid_argument if blockSize or flushInterval is not
+   * positive
+   * @throw std::runtime_error if the file cannot be opened or the thread
+   * cannot be started
+   */
+  tgAsyncLogWriter(const std::string& fileName,
+		   std::size_t blockSize = 1 << 20,
+		   double flushInterval = 1.0,
+		   bool append = false,
+		   Formatter* pFormatter = NULL);
+
+  /**
+   * Writes out whatever is still buffered and closes the file.
+   * Errors are not reported here; call close() to see them.
+   */
+  ~tgAsyncLogWriter();
+
+  /**
+   * Append bytes to the file. Only copies them into the front buffer.
+   * A Formatter sees the bytes of each call together.
+   * @param[in] data the bytes to append
+   * @param[in] n the number of bytes
+   */
+  void write(const char* data, std::size_t n);
+
+  /**
+   * Append a string to the file.
+   * @param[in] s the characters to append
+   */
+  void write(const std::string& s)
+  {
+    write(s.data(), s.size());
+  }
+
+  /**
+   * Block until everything written so far has been handed to the
+   * operating system.
+   * @throw std::runtime_error if a write to the file failed
+   */
+  void flush();
+
+  /**
+   * Write out the remaining data, stop the thread and close the file.
+   * Further calls to write() are ignored.
+   * @throw std::runtime_error if a write to the file failed
+   */
+  void close();
+
+  /** @return the path of the file being written */
+  const std::string& fileName() const { return m_fileName; }
+
+ private:
+
+  /** pthread entry point; arg is the tgAsyncLogWriter */
+  static void* writerMain(void* arg);
+
+  /** The loop run by the writer thread. */
+  void writerLoop();
+
+  /** Stop the thread and close the file, once. */
+  void shutdown();
+
+  // Not copyable
+  tgAsyncLogWriter(const tgAsyncLogWriter&);
+  tgAsyncLogWriter& operator=(const tgAsyncLogWriter&);
+
+ private:
+
+  const std::string m_fileName;
+  const std::size_t m_blockSize;
+  const double m_flushInterval;
+
+  std::FILE* m_file;
+  pthread_t m_thread;
+
+  /** NULL to write the data as it is */
+  Formatter* const m_pFormatter;
+
+  /** The Formatter's output, used only by the writer thread */
+  std::vector<char> m_text;
+
+  /** Guards everything below. */
+  pthread_mutex_t m_mutex;
+
+  /** Signalled when the writer thread has something to do. */
+  pthread_cond_t m_work;
+
+  /** Signalled when a requested flush has completed. */
+  pthread_cond_t m_flushed;
+
+  /** Filled by write(). */
+  std::vector<char> m_front;
+
+  /** Written out by the writer thread, outside the lock. */
+  std::vector<char> m_back;
+
+  /** Flushes asked for by flush(), and flushes completed. */
+  unsigned long m_flushesRequested;
+  unsigned long m_flushesDone;
+
+  bool m_stopping;
+  bool m_closed;
+  bool m_failed;
+};
+
+#endif // TG_ASYNC_LOG_WRITER_H
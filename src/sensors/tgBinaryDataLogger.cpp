@@ -0,0 +1,158 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryDataLogger.cpp
+ * @brief Contains the implementation of class tgBinaryDataLogger.
+ * $Id$
+ */
+
+// This module
+#include "tgBinaryDataLogger.h"
+// This application
+#include "tgBinaryLogWriter.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <time.h> // for the file name of the log file
+#include <cstdlib> // for getenv, converting ~ to $HOME.
+
+tgBinaryDataLogger::tgBinaryDataLogger(std::string fileNamePrefix,
+				       double timeInterval,
+				       std::size_t framesPerBlock) :
+  tgDataManager(),
+  m_fileNamePrefix(fileNamePrefix),
+  m_pWriter(NULL),
+  m_framesPerBlock(framesPerBlock),
+  m_totalTime(0.0),
+  m_timeInterval(timeInterval),
+  m_updateTime(0.0)
+{
+  if (m_fileNamePrefix == "") {
+    throw std::invalid_argument("File name cannot be the empty string. Please pass in a path to a file that can be opened.");
+  }
+  if (m_timeInterval < 0.0) {
+    throw std::invalid_argument("Time interval must be nonnegative. Negative time intervals do not make sense.");
+  }
+  if (m_framesPerBlock == 0) {
+    throw std::invalid_argument("Frames per block must be positive.");
+  }
+  // Expand a leading "~" to the home directory, as tgDataLogger2 does.
+  if (m_fileNamePrefix.at(0) == '~') {
+    std::string home = std::getenv("HOME");
+    m_fileNamePrefix.erase(0,1);
+    m_fileNamePrefix = home + m_fileNamePrefix;
+  }
+
+  // Postcondition
+  assert(invariant());
+}
+
+tgBinaryDataLogger::~tgBinaryDataLogger()
+{
+  delete m_pWriter;
+}
+
+void tgBinaryDataLogger::setup()
+{
+  // The parent creates the sensors.
+  tgDataManager::setup();
+
+  // Name the file after the current time, as tgDataLogger2 does.
+  time_t rawtime;
+  tm* currentTime;
+  const int fileTimeSize = 64;
+  char fileTime [fileTimeSize];
+  time (&rawtime);
+  currentTime = localtime(&rawtime);
+  strftime(fileTime, fileTimeSize, "%m%d%Y_%H%M%S", currentTime);
+  m_fileName = m_fileNamePrefix + "_" + fileTime + ".ntrtlog";
+
+  std::cout << "tgBinaryDataLogger will be saving data to the file: "
+	    << std::endl << m_fileName << std::endl;
+
+  // The same headings as tgDataLogger2, without the commas.
+  std::vector<std::string> headings(1, "time");
+  const std::vector<std::string> frameHeadings = getFrameHeadings();
+  headings.insert(headings.end(), frameHeadings.begin(), frameHeadings.end());
+
+  // A previous setup without a teardown leaves a writer behind.
+  delete m_pWriter;
+  m_pWriter = NULL;
+  try {
+    m_pWriter = new tgBinaryLogWriter(m_fileName, headings, m_framesPerBlock);
+  }
+  catch (const std::runtime_error&) {
+    throw std::runtime_error("Log file could not be opened. Usually, this is because the directory you specified does not exist. Check for spelling errors.");
+  }
+
+  m_frame.assign(m_frameSize + 1, 0.0);
+  m_totalTime = 0.0;
+  m_updateTime = 0.0;
+
+  // Postcondition
+  assert(invariant());
+}
+
+void tgBinaryDataLogger::teardown()
+{
+  tgDataManager::teardown();
+  if (m_pWriter != NULL) {
+    tgBinaryLogWriter* const pWriter = m_pWriter;
+    m_pWriter = NULL;
+    try {
+      pWriter->close();
+    }
+    catch (...) {
+      delete pWriter;
+      throw;
+    }
+    delete pWriter;
+  }
+  // Postcondition
+  assert(invariant());
+}
+
+void tgBinaryDataLogger::step(double dt)
+{
+  if (dt <= 0.0)
+  {
+    throw std::invalid_argument("dt is not positive");
+  }
+  m_totalTime += dt;
+  m_updateTime += dt;
+  if (m_updateTime >= m_timeInterval && m_pWriter != NULL) {
+    m_frame[0] = m_totalTime;
+    readSensorFrame(&m_frame[1]);
+    m_pWriter->append(&m_frame[0]);
+    m_updateTime = 0.0;
+  }
+
+  // Postcondition
+  assert(invariant());
+}
+
+std::string tgBinaryDataLogger::toString() const
+{
+  std::ostringstream os;
+  os << tgDataManager::toString()
+     << "This tgDataManager is a tgBinaryDataLogger. " << std::endl;
+  return os.str();
+}
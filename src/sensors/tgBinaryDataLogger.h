@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BINARY_DATA_LOGGER_H
+#define TG_BINARY_DATA_LOGGER_H
+
+/**
+ * @file tgBinaryDataLogger.h
+ * @brief Contains the definition of class tgBinaryDataLogger.
+ * $Id$
+ */
+
+// Includes from NTRTsim
+#include "tgDataManager.h"
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class tgBinaryLogWriter;
+
+/**
+ * tgBinaryDataLogger is a tgDataManager. It records the same data as
+ * tgDataLogger2, with the same headings, but writes it to a columnar
+ * binary file (see tgBinaryLogFormat) instead of a CSV file. The values
+ * are stored at full precision, the files are smaller and faster to
+ * write, and tgBinaryLogReader can read any time range of them without
+ * reading the rest. tgBinaryLogToCSV converts them to CSV.
+ */
+class tgBinaryDataLogger : public tgDataManager
+{
+ public:
+
+  /**
+   * @param[in] fileNamePrefix the path to the log file that will be
+   * written. The current time and ".ntrtlog" will be appended to it.
+   * @param[in] timeInterval the time interval for querying sensors. 0
+   * means that sensors will be queried at each call of step().
+   * @param[in] framesPerBlock the number of frames the file groups
+   * into a block
+   * @throw std::invalid_argument if the prefix is empty, the interval is
+   * negative, or framesPerBlock is zero
+   */
+  tgBinaryDataLogger(std::string fileNamePrefix, double timeInterval = 0.0,
+		     std::size_t framesPerBlock = 1024);
+
+  /**
+   * Closes the log file, if teardown was not called.
+   */
+  ~tgBinaryDataLogger();
+
+  /**
+   * Create the sensors, then open the log file and write its headings:
+   * "time", then each sensor's headings prefixed with the sensor's
+   * index, as in tgDataLogger2.
+   */
+  virtual void setup();
+
+  /**
+   * Write out the last block and close the log file.
+   */
+  virtual void teardown();
+
+  /**
+   * Read every sensor, if timeInterval has passed, and append the
+   * frame to the log.
+   * @param[in] dt a double, the amount of time since the last step.
+   */
+  virtual void step(double dt);
+
+  virtual std::string toString() const;
+
+ protected:
+
+  /** The name of the current log file, made in setup. */
+  std::string m_fileName;
+
+  /** The path passed to the constructor, with ~ expanded. */
+  std::string m_fileNamePrefix;
+
+  /** Created in setup, deleted in teardown. NULL otherwise. */
+  tgBinaryLogWriter* m_pWriter;
+
+  /** The time, then one sample of every sensor. Sized in setup. */
+  std::vector<double> m_frame;
+
+  std::size_t m_framesPerBlock;
+
+  /** The time since setup. */
+  double m_totalTime;
+
+  /** The time between sensor readings. */
+  double m_timeInterval;
+
+  /** The time since the last sensor reading. */
+  double m_updateTime;
+};
+
+#endif // TG_BINARY_DATA_LOGGER_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BINARY_LOG_FORMAT_H
+#define TG_BINARY_LOG_FORMAT_H
+
+/**
+ * @file tgBinaryLogFormat.h
+ * @brief Contains the definition of class tgBinaryLogFormat.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * The layout of the columnar binary log files written by
+ * tgBinaryLogWriter and read by tgBinaryLogReader. All numbers are in
+ * the byte order of the machine that wrote the file, which is recorded
+ * so that a reader can refuse a file it would misread.
+ *
+ * The file starts with a header:
+ * - 8 bytes: the magic string "NTRTBLOG"
+ * - uint32: the format version
+ * - uint32: the byte order mark, 0x01020304
+ * - uint64: the size of the header in bytes, a multiple of 8
+ * - uint64: the number of channels
+ * - uint64: the number of frames per block
+ * - for each channel, a uint32 length and then the heading's characters
+ * - zeros up to the size of the header
+ *
+ * The header is followed by blocks that are all the same size, so block
+ * k starts at headerBytes + k * blockBytes and any time range can be
+ * found without reading the blocks before it. Each block holds:
+ * - uint64: the number of frames in use, at most framesPerBlock; only
+ *   the last block may be partly used
+ * - uint64: reserved, zero
+ * - the values, one column after another: framesPerBlock float64
+ *   values of channel 0, then of channel 1, and so on. Unused rows are
+ *   zero.
+ */
+class tgBinaryLogFormat
+{
+ public:
+
+  /** The first eight bytes of every file. */
+  static const char* magic() { return "NTRTBLOG"; }
+
+  static const std::size_t magicBytes = 8;
+
+  static const uint32_t version = 1;
+
+  static const uint32_t byteOrderMark = 0x01020304;
+
+  /** The bytes of the fixed part of the header, before the headings. */
+  static const std::size_t fixedHeaderBytes = 40;
+
+  /** The bytes before the values in each block. */
+  static const std::size_t blockHeaderBytes = 16;
+
+  /**
+   * @param[in] channelCount the number of channels
+   * @param[in] framesPerBlock the number of frames per block
+   * @return the size of every block in bytes
+   */
+  static std::size_t blockBytes(std::size_t channelCount,
+				std::size_t framesPerBlock)
+  {
+    return blockHeaderBytes + channelCount * framesPerBlock * sizeof(double);
+  }
+};
+
+#endif // TG_BINARY_LOG_FORMAT_H
@@ -0,0 +1,240 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryLogReader.cpp
+ * @brief Contains the implementation of class tgBinaryLogReader.
+ * $Id$
+ */
+
+// This module
+#include "tgBinaryLogReader.h"
+// This application
+#include "tgBinaryLogFormat.h"
+// Includes from the C++ standard library
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+// POSIX, for mapping the file
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  /** Read a number at an offset into the mapping. */
+  template <typename T>
+  T readAt(const char* p, std::size_t offset)
+  {
+    T value;
+    std::memcpy(&value, p + offset, sizeof(T));
+    return value;
+  }
+}
+
+std::size_t tgBinaryLogReader::Column::size() const
+{
+  return m_pReader == NULL ? 0 : m_pReader->frameCount();
+}
+
+double tgBinaryLogReader::Column::operator[](std::size_t frame) const
+{
+  return m_pReader->value(frame, m_channel);
+}
+
+std::size_t tgBinaryLogReader::Column::blockCount() const
+{
+  return m_pReader == NULL ? 0 : m_pReader->blockCount();
+}
+
+const double* tgBinaryLogReader::Column::blockData(std::size_t block) const
+{
+  return m_pReader->blockColumn(block, m_channel);
+}
+
+std::size_t tgBinaryLogReader::Column::blockSize(std::size_t block) const
+{
+  return m_pReader->blockFrames(block);
+}
+
+tgBinaryLogReader::tgBinaryLogReader(const std::string& fileName) :
+  m_pMapping(NULL),
+  m_mappingBytes(0),
+  m_pBlocks(NULL),
+  m_framesPerBlock(0),
+  m_blockBytes(0),
+  m_blockHeaderBytes(tgBinaryLogFormat::blockHeaderBytes),
+  m_blockCount(0),
+  m_frameCount(0)
+{
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open binary log " + fileName);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not read the size of binary log " + fileName);
+  }
+  m_mappingBytes = info.st_size;
+  if (m_mappingBytes > 0) {
+    m_pMapping = mmap(NULL, m_mappingBytes, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  // The mapping stays valid once the file is closed
+  ::close(fd);
+  if (m_pMapping == MAP_FAILED || m_pMapping == NULL) {
+    m_pMapping = NULL;
+    throw std::runtime_error("Could not map binary log " + fileName);
+  }
+
+  try {
+    parse(fileName);
+  }
+  catch (...) {
+    unmap();
+    throw;
+  }
+}
+
+tgBinaryLogReader::~tgBinaryLogReader()
+{
+  unmap();
+}
+
+void tgBinaryLogReader::parse(const std::string& fileName)
+{
+  const char* const p = static_cast<const char*>(m_pMapping);
+  const std::string notALog = fileName + " is not a binary log: ";
+
+  if (m_mappingBytes < tgBinaryLogFormat::fixedHeaderBytes ||
+      std::memcmp(p, tgBinaryLogFormat::magic(),
+		  tgBinaryLogFormat::magicBytes) != 0) {
+    throw std::runtime_error(notALog + "no header");
+  }
+  if (readAt<uint32_t>(p, 8) != tgBinaryLogFormat::version) {
+    throw std::runtime_error(notALog + "unknown version");
+  }
+  if (readAt<uint32_t>(p, 12) != tgBinaryLogFormat::byteOrderMark) {
+    throw std::runtime_error(notALog + "written with another byte order");
+  }
+  const uint64_t headerBytes = readAt<uint64_t>(p, 16);
+  const uint64_t channelCount = readAt<uint64_t>(p, 24);
+  m_framesPerBlock = readAt<uint64_t>(p, 32);
+  if (headerBytes > m_mappingBytes || headerBytes % 8 != 0 ||
+      channelCount == 0 || m_framesPerBlock == 0) {
+    throw std::runtime_error(notALog + "bad header");
+  }
+
+  std::size_t offset = tgBinaryLogFormat::fixedHeaderBytes;
+  m_headings.reserve(channelCount);
+  for (uint64_t c = 0; c < channelCount; c++) {
+    if (offset + sizeof(uint32_t) > headerBytes) {
+      throw std::runtime_error(notALog + "headings do not fit the header");
+    }
+    const uint32_t length = readAt<uint32_t>(p, offset);
+    offset += sizeof(uint32_t);
+    if (offset + length > headerBytes) {
+      throw std::runtime_error(notALog + "headings do not fit the header");
+    }
+    m_headings.push_back(std::string(p + offset, length));
+    offset += length;
+  }
+
+  // Whole blocks only; a partly written one at the end is ignored
+  m_pBlocks = p + headerBytes;
+  m_blockBytes = tgBinaryLogFormat::blockBytes(channelCount, m_framesPerBlock);
+  m_blockCount = (m_mappingBytes - headerBytes) / m_blockBytes;
+  m_frameCount = 0;
+  for (std::size_t b = 0; b < m_blockCount; b++) {
+    const std::size_t frames = blockFrames(b);
+    if (frames > m_framesPerBlock) {
+      throw std::runtime_error(notALog + "bad block");
+    }
+    m_frameCount += frames;
+    // Only the last block may be partly used
+    if (frames < m_framesPerBlock) {
+      m_blockCount = b + 1;
+      break;
+    }
+  }
+}
+
+void tgBinaryLogReader::unmap()
+{
+  if (m_pMapping != NULL) {
+    munmap(m_pMapping, m_mappingBytes);
+    m_pMapping = NULL;
+    m_pBlocks = NULL;
+  }
+}
+
+std::size_t tgBinaryLogReader::channelIndex(const std::string& heading) const
+{
+  const std::vector<std::string>::const_iterator it =
+    std::find(m_headings.begin(), m_headings.end(), heading);
+  if (it == m_headings.end()) {
+    throw std::invalid_argument("No channel has the heading " + heading);
+  }
+  return it - m_headings.begin();
+}
+
+tgBinaryLogReader::Column tgBinaryLogReader::column(std::size_t channel) const
+{
+  if (channel >= channelCount()) {
+    throw std::out_of_range("No such channel in the binary log");
+  }
+  return Column(this, channel);
+}
+
+std::size_t tgBinaryLogReader::blockFrames(std::size_t block) const
+{
+  return readAt<uint64_t>(m_pBlocks, block * m_blockBytes);
+}
+
+std::size_t tgBinaryLogReader::lowerBound(double time,
+					  std::size_t timeChannel) const
+{
+  if (timeChannel >= channelCount()) {
+    throw std::out_of_range("No such channel in the binary log");
+  }
+  if (m_frameCount == 0) {
+    return 0;
+  }
+
+  // The last block whose first time is before the one sought; the range
+  // starts in it, or at the start of the block after it
+  std::size_t lo = 0;
+  std::size_t hi = m_blockCount;
+  while (hi - lo > 1) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (blockColumn(mid, timeChannel)[0] < time) {
+      lo = mid;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  const double* const times = blockColumn(lo, timeChannel);
+  const std::size_t frames = blockFrames(lo);
+  const std::size_t i = std::lower_bound(times, times + frames, time) - times;
+  return lo * m_framesPerBlock + i;
+}
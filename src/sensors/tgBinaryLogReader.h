@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BINARY_LOG_READER_H
+#define TG_BINARY_LOG_READER_H
+
+/**
+ * @file tgBinaryLogReader.h
+ * @brief Contains the definition of class tgBinaryLogReader.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * tgBinaryLogReader maps a file written by tgBinaryLogWriter into memory
+ * and gives access to its values without copying them. Only the pages
+ * that are actually read are loaded from the disk, so a time range can
+ * be looked at without reading the whole file.
+ *
+ * A file that was cut short, e.g. because the simulation crashed, is
+ * read up to its last complete block.
+ */
+class tgBinaryLogReader
+{
+ public:
+
+  /**
+   * The values of one channel, one stretch of consecutive values per
+   * block. Valid as long as the reader that made it.
+   */
+  class Column
+  {
+  public:
+
+    Column() : m_pReader(NULL), m_channel(0) { }
+
+    /** @return the number of frames */
+    std::size_t size() const;
+
+    /** @return the value in a frame, less than size() */
+    double operator[](std::size_t frame) const;
+
+    /** @return the number of blocks */
+    std::size_t blockCount() const;
+
+    /** @return the values in a block, blockSize(block) of them */
+    const double* blockData(std::size_t block) const;
+
+    /** @return the number of values in a block */
+    std::size_t blockSize(std::size_t block) const;
+
+  private:
+
+    friend class tgBinaryLogReader;
+
+    Column(const tgBinaryLogReader* pReader, std::size_t channel) :
+      m_pReader(pReader), m_channel(channel) { }
+
+    const tgBinaryLogReader* m_pReader;
+    std::size_t m_channel;
+  };
+
+  /**
+   * Map the file.
+   * @param[in] fileName the path of the file to read
+   * @throw std::runtime_error if the file cannot be mapped, or is not a
+   * binary log that this reader can read
+   */
+  explicit tgBinaryLogReader(const std::string& fileName);
+
+  /** Unmaps the file. */
+  ~tgBinaryLogReader();
+
+  /** @return the heading of every channel */
+  const std::vector<std::string>& headings() const { return m_headings; }
+
+  /** @return the number of channels */
+  std::size_t channelCount() const { return m_headings.size(); }
+
+  /**
+   * @param[in] heading the heading of a channel
+   * @return the channel's index
+   * @throw std::invalid_argument if no channel has the heading
+   */
+  std::size_t channelIndex(const std::string& heading) const;
+
+  /** @return the number of frames in the file */
+  std::size_t frameCount() const { return m_frameCount; }
+
+  /** @return the number of frames in each full block */
+  std::size_t framesPerBlock() const { return m_framesPerBlock; }
+
+  /** @return the number of complete blocks in the file */
+  std::size_t blockCount() const { return m_blockCount; }
+
+  /**
+   * @param[in] channel less than channelCount()
+   * @return a view of the channel's values
+   * @throw std::out_of_range if there is no such channel
+   */
+  Column column(std::size_t channel) const;
+
+  /**
+   * @param[in] frame less than frameCount()
+   * @param[in] channel less than channelCount()
+   * @return the value of a channel in a frame
+   */
+  double value(std::size_t frame, std::size_t channel) const
+  {
+    const std::size_t block = frame / m_framesPerBlock;
+    return blockColumn(block, channel)[frame - block * m_framesPerBlock];
+  }
+
+  /**
+   * Find the start of a time range, with a binary search over the
+   * blocks' first times and then within one block. Reads only a few
+   * pages of the file.
+   * @param[in] time the time to look for
+   * @param[in] timeChannel the channel holding the time, which must not
+   * decrease from one frame to the next
+   * @return the first frame whose time is at least the given one, or
+   * frameCount() if there is none
+   */
+  std::size_t lowerBound(double time, std::size_t timeChannel = 0) const;
+
+ private:
+
+  /** @return the values of a channel in a block */
+  const double* blockColumn(std::size_t block, std::size_t channel) const
+  {
+    return reinterpret_cast<const double*>(m_pBlocks + block * m_blockBytes
+					   + m_blockHeaderBytes)
+      + channel * m_framesPerBlock;
+  }
+
+  /** @return the number of frames used in a block */
+  std::size_t blockFrames(std::size_t block) const;
+
+  /** Read the header and count the blocks. */
+  void parse(const std::string& fileName);
+
+  /** Unmap the file, if it is mapped. */
+  void unmap();
+
+  // Not copyable
+  tgBinaryLogReader(const tgBinaryLogReader&);
+  tgBinaryLogReader& operator=(const tgBinaryLogReader&);
+
+ private:
+
+  /** The mapping of the whole file. */
+  void* m_pMapping;
+  std::size_t m_mappingBytes;
+
+  /** The start of the first block in the mapping. */
+  const char* m_pBlocks;
+
+  std::vector<std::string> m_headings;
+  std::size_t m_framesPerBlock;
+  std::size_t m_blockBytes;
+  std::size_t m_blockHeaderBytes;
+  std::size_t m_blockCount;
+  std::size_t m_frameCount;
+};
+
+#endif // TG_BINARY_LOG_READER_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryLogToCSV.cpp
+ * @brief Converts a log written by tgBinaryDataLogger to CSV.
+ * $Id$
+ *
+ * Usage: tgBinaryLogToCSV log.ntrtlog [out.csv] [--from t0] [--to t1]
+ *
+ * Writes the headings and then one line per frame, in the layout of
+ * tgDataLogger2's files, to out.csv or to the standard output. With
+ * --from and --to, only the frames whose time is in [t0, t1) are
+ * written, and only the blocks that hold them are read.
+ */
+
+// This application
+#include "tgBinaryLogReader.h"
+// Includes from the C++ standard library
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+  int usage()
+  {
+    std::cerr << "Usage: tgBinaryLogToCSV log.ntrtlog [out.csv]"
+	      << " [--from t0] [--to t1]" << std::endl;
+    return 2;
+  }
+
+  void writeCSV(const tgBinaryLogReader& log, std::size_t begin,
+		std::size_t end, std::ostream& out)
+  {
+    // Enough digits that the CSV holds the same values as the log
+    out.precision(std::numeric_limits<double>::digits10 + 2);
+
+    const std::vector<std::string>& headings = log.headings();
+    for (std::size_t c = 0; c < headings.size(); c++) {
+      out << headings[c] << ",";
+    }
+    out << '\n';
+
+    for (std::size_t f = begin; f < end; f++) {
+      for (std::size_t c = 0; c < log.channelCount(); c++) {
+	out << log.value(f, c) << ",";
+      }
+      out << '\n';
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string input;
+  std::string output;
+  double from = -std::numeric_limits<double>::infinity();
+  double to = std::numeric_limits<double>::infinity();
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+      from = std::atof(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--to") == 0 && i + 1 < argc) {
+      to = std::atof(argv[++i]);
+    }
+    else if (input.empty()) {
+      input = argv[i];
+    }
+    else if (output.empty()) {
+      output = argv[i];
+    }
+    else {
+      return usage();
+    }
+  }
+  if (input.empty()) {
+    return usage();
+  }
+
+  try {
+    const tgBinaryLogReader log(input);
+    const std::size_t begin = log.lowerBound(from);
+    const std::size_t end = std::max(begin, log.lowerBound(to));
+    if (output.empty()) {
+      writeCSV(log, begin, end, std::cout);
+    }
+    else {
+      std::ofstream out(output.c_str());
+      if (!out) {
+	std::cerr << "Could not open " << output << std::endl;
+	return 1;
+      }
+      writeCSV(log, begin, end, out);
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryLogWriter.cpp
+ * @brief Contains the implementation of class tgBinaryLogWriter.
+ * $Id$
+ */
+
+// This module
+#include "tgBinaryLogWriter.h"
+// This application
+#include "tgAsyncLogWriter.h"
+#include "tgBinaryLogFormat.h"
+// Includes from the C++ standard library
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace
+{
+  /** Append the bytes of a number to a buffer. */
+  template <typename T>
+  void appendBytes(std::vector<char>& buffer, T value)
+  {
+    const char* const p = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+  }
+}
+
+tgBinaryLogWriter::tgBinaryLogWriter(const std::string& fileName,
+				     const std::vector<std::string>& headings,
+				     std::size_t framesPerBlock) :
+  m_channelCount(headings.size()),
+  m_framesPerBlock(framesPerBlock),
+  m_pWriter(NULL),
+  m_frames(0)
+{
+  if (headings.empty()) {
+    throw std::invalid_argument("A binary log needs at least one channel.");
+  }
+  if (framesPerBlock == 0) {
+    throw std::invalid_argument("Frames per block must be positive.");
+  }
+
+  // Assemble the header, then pad it to a multiple of 8 bytes so the
+  // values in the blocks are aligned
+  std::vector<char> header(tgBinaryLogFormat::magic(),
+			   tgBinaryLogFormat::magic() + tgBinaryLogFormat::magicBytes);
+  appendBytes<uint32_t>(header, tgBinaryLogFormat::version);
+  appendBytes<uint32_t>(header, tgBinaryLogFormat::byteOrderMark);
+  // The header size, filled in below
+  appendBytes<uint64_t>(header, 0);
+  appendBytes<uint64_t>(header, m_channelCount);
+  appendBytes<uint64_t>(header, m_framesPerBlock);
+  assert(header.size() == tgBinaryLogFormat::fixedHeaderBytes);
+  for (std::size_t i = 0; i < headings.size(); i++) {
+    appendBytes<uint32_t>(header, headings[i].size());
+    header.insert(header.end(), headings[i].begin(), headings[i].end());
+  }
+  header.resize((header.size() + 7) / 8 * 8, 0);
+  const uint64_t headerBytes = header.size();
+  std::memcpy(&header[16], &headerBytes, sizeof(headerBytes));
+
+  // A few blocks at a time are written out by the background thread
+  const std::size_t blockBytes =
+    tgBinaryLogFormat::blockBytes(m_channelCount, m_framesPerBlock);
+  m_pWriter = new tgAsyncLogWriter(fileName,
+				   std::max<std::size_t>(blockBytes, 1 << 20));
+  m_pWriter->write(&header[0], header.size());
+
+  m_block.assign(m_channelCount * m_framesPerBlock, 0.0);
+}
+
+tgBinaryLogWriter::~tgBinaryLogWriter()
+{
+  try {
+    close();
+  }
+  catch (const std::runtime_error&) {
+    // Destructors do not report errors
+  }
+}
+
+void tgBinaryLogWriter::append(const double* frame)
+{
+  if (m_pWriter == NULL) {
+    return;
+  }
+  // Scatter the frame into the columns
+  double* const row = &m_block[m_frames];
+  for (std::size_t c = 0; c < m_channelCount; c++) {
+    row[c * m_framesPerBlock] = frame[c];
+  }
+  m_frames++;
+  if (m_frames == m_framesPerBlock) {
+    writeBlock();
+  }
+}
+
+void tgBinaryLogWriter::close()
+{
+  if (m_pWriter == NULL) {
+    return;
+  }
+  if (m_frames > 0) {
+    // Zero the unused rows, so a file's contents depend only on its frames
+    for (std::size_t c = 0; c < m_channelCount; c++) {
+      double* const column = &m_block[c * m_framesPerBlock];
+      std::fill(column + m_frames, column + m_framesPerBlock, 0.0);
+    }
+    writeBlock();
+  }
+
+  tgAsyncLogWriter* const pWriter = m_pWriter;
+  m_pWriter = NULL;
+  try {
+    pWriter->close();
+  }
+  catch (...) {
+    delete pWriter;
+    throw;
+  }
+  delete pWriter;
+}
+
+void tgBinaryLogWriter::writeBlock()
+{
+  const uint64_t blockHeader[2] = { m_frames, 0 };
+  m_pWriter->write(reinterpret_cast<const char*>(blockHeader),
+		   sizeof(blockHeader));
+  m_pWriter->write(reinterpret_cast<const char*>(&m_block[0]),
+		   m_block.size() * sizeof(double));
+  m_frames = 0;
+}
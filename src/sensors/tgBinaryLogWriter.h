@@ -0,0 +1,105 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BINARY_LOG_WRITER_H
+#define TG_BINARY_LOG_WRITER_H
+
+/**
+ * @file tgBinaryLogWriter.h
+ * @brief Contains the definition of class tgBinaryLogWriter.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class tgAsyncLogWriter;
+
+/**
+ * tgBinaryLogWriter writes frames of doubles to a file in the columnar
+ * format described by tgBinaryLogFormat. Frames are gathered into a
+ * block in memory; each full block is handed to a tgAsyncLogWriter, so
+ * appending a frame only copies it.
+ */
+class tgBinaryLogWriter
+{
+ public:
+
+  /**
+   * Create the file and write its header.
+   * @param[in] fileName the path of the file to write
+   * @param[in] headings one heading per channel; must not be empty
+   * @param[in] framesPerBlock the number of frames per block; must be
+   * positive
+   * @throw std::invalid_argument if headings is empty or framesPerBlock
+   * is zero
+   * @throw std::runtime_error if the file cannot be opened
+   */
+  tgBinaryLogWriter(const std::string& fileName,
+		    const std::vector<std::string>& headings,
+		    std::size_t framesPerBlock = 1024);
+
+  /**
+   * Calls close(), but does not report errors.
+   */
+  ~tgBinaryLogWriter();
+
+  /**
+   * Append one frame.
+   * @param[in] frame channelCount() values, in the order of the headings
+   */
+  void append(const double* frame);
+
+  /**
+   * Write the last, partly filled block and close the file.
+   * Further calls to append() are ignored.
+   * @throw std::runtime_error if a write to the file failed
+   */
+  void close();
+
+  /** @return the number of values in each frame */
+  std::size_t channelCount() const { return m_channelCount; }
+
+ private:
+
+  /** Hand the current block to the writer and start a new one. */
+  void writeBlock();
+
+  // Not copyable
+  tgBinaryLogWriter(const tgBinaryLogWriter&);
+  tgBinaryLogWriter& operator=(const tgBinaryLogWriter&);
+
+ private:
+
+  const std::size_t m_channelCount;
+  const std::size_t m_framesPerBlock;
+
+  /** NULL once closed. Owned. */
+  tgAsyncLogWriter* m_pWriter;
+
+  /** The current block's values, column by column. */
+  std::vector<double> m_block;
+
+  /** The number of frames in the current block. */
+  std::size_t m_frames;
+};
+
+#endif // TG_BINARY_LOG_WRITER_H
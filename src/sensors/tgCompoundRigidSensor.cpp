@@ -222,65 +222,43 @@ std::vector<std::string> tgCompoundRigidSensor::getSensorDataHeadings() {
   return headings;
 }
 
+/**
+ * This sensor returns the XYZ position of the center of mass, the
+ * yaw, pitch and roll, and the mass.
+ */
+std::size_t tgCompoundRigidSensor::getChannelCount() const {
+  return 7;
+}
+
 /**
  * The method that collects the actual data from this compound rigid body.
  */
-std::vector<std::string> tgCompoundRigidSensor::getSensorData() {
+void tgCompoundRigidSensor::readInto(double* out) {
   // Note that this method uses m_rigids directly, no need to deal
   // with the parent class' pointer to m_pSens.
-  
-  // The floats (btScalars?) need to be converted to strings
-  // via a stringstream.
-  std::stringstream ss;
-
-  // The list of sensor data that will be returned:
-  std::vector<std::string> sensordata;
 
   // Get the position and orientation of this compound body.
   // Call the helper functions
   btVector3 com = getCenterOfMass();
   btVector3 orient = getOrientation();
-  
-  // com[0]
-  ss << com[0];
-  sensordata.push_back( ss.str() );
-  // Reset the stream.
-  ss.str("");
-  
-  // com[1]
-  ss << com[1];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // com[2]
-  ss << com[2];
-  sensordata.push_back( ss.str() );
-  ss.str("");
 
-  // yaw
-  ss << orient[0];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-
-  // pitch
-  ss << orient[1];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-
-  // roll
-  ss << orient[2];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  
-  //sensordata.push_back( "" );
-  //sensordata.push_back( "" );
-  //sensordata.push_back( "" );
+  out[0] = com[0];
+  out[1] = com[1];
+  out[2] = com[2];
+  // yaw, pitch, roll
+  out[3] = orient[0];
+  out[4] = orient[1];
+  out[5] = orient[2];
+  out[6] = getMass();
+}
 
-  // mass
-  ss << getMass();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  
-  return sensordata;
+/**
+ * The same data as readInto, as strings.
+ */
+std::vector<std::string> tgCompoundRigidSensor::getSensorData() {
+  double values[7];
+  readInto(values);
+  return formatSensorData(values, 7);
 }
 
 //end.
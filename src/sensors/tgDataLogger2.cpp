@@ -26,16 +26,57 @@
 // This module
 #include "tgDataLogger2.h"
 // This application
+#include "tgAsyncLogWriter.h"
 #include "tgSensor.h"
 // The C++ Standard Library
 #include <stdexcept>
 #include <cassert>
+#include <cstdio> // for formatting the values on the writer thread
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <vector> // for managing descendants of tgSenseables.
 #include <time.h> // for the file name of the log file
 #include <sstream> // for converting a size_t to a string.
 #include <cstdlib> // for getenv, converting ~ to $HOME.
 
+namespace
+{
+  /**
+   * Turns rows of doubles into lines of comma-separated values, on the
+   * log writer's thread. Every value is followed by a comma, as in the
+   * heading, and is formatted as an ostream would by default.
+   */
+  class CSVRowFormatter : public tgAsyncLogWriter::Formatter
+  {
+  public:
+    CSVRowFormatter(std::size_t rowLength) :
+      m_rowLength(rowLength)
+    {
+    }
+
+    virtual void format(const char* data, std::size_t n,
+			std::vector<char>& out)
+    {
+      // Each write() is a whole row, so every block starts a row
+      const std::size_t count = n / sizeof(double);
+      char text[32];
+      for (std::size_t i = 0; i < count; i++) {
+	double value;
+	std::memcpy(&value, data + i * sizeof(double), sizeof(double));
+	const int length = std::snprintf(text, sizeof(text), "%g,", value);
+	out.insert(out.end(), text, text + length);
+	if ((i + 1) % m_rowLength == 0) {
+	  out.push_back('\n');
+	}
+      }
+    }
+
+  private:
+    const std::size_t m_rowLength;
+  };
+}
+
 /**
  * The constructor for this class only assigns the filename prefix.
  * The actual filename is created in setup.
@@ -46,6 +87,7 @@
 tgDataLogger2::tgDataLogger2(std::string fileNamePrefix, double timeInterval) :
   tgDataManager(),
   m_fileNamePrefix(fileNamePrefix),
+  m_pWriter(NULL),
   m_timeInterval(timeInterval)
 {
   // A quick check on the passed-in string: it must not be the empty
@@ -84,19 +126,20 @@ tgDataLogger2::tgDataLogger2(std::string fileNamePrefix, double timeInterval) :
  * lets the simulator compile, but then complains when it's called.
  * DO NOT USE THIS ONE: use the one with the string passed in!
  */
-tgDataLogger2::tgDataLogger2()
+tgDataLogger2::tgDataLogger2() :
+  m_pWriter(NULL)
 {
   throw std::invalid_argument("Cannot create a tgDataLogger2 without a path to the log file! Please use the constructor that takes a string.");
 }
 
 /**
- * The destructor should not have to do anything.
  * Closing the log file is handled by teardown(), and the parent class
- * handles deletion of the sensors and sensor infos.
+ * handles deletion of the sensors and sensor infos. In case teardown was
+ * never called, close the file here, writing out what is still buffered.
  */
 tgDataLogger2::~tgDataLogger2()
 {
-  // TO-DO: should we double-check and close the tgOutput filestream here too?
+  delete m_pWriter;
 }
 
 /**
@@ -104,7 +147,8 @@ tgDataLogger2::~tgDataLogger2()
  * (1) create the full filename, based on the current time from the operating system,
  * (2) create the sensors based on the sensor infos that have been added and 
  *     the senseable objects that have also been added,
- * (3) opens the log file and writes a heading line (then closes the file.)
+ * (3) opens the log file and writes a heading line. The file stays open
+ *     until teardown, written by a background thread.
  */
 void tgDataLogger2::setup()
 {
@@ -131,40 +175,54 @@ void tgDataLogger2::setup()
   std::cout << "tgDataLogger2 will be saving data to the file: " << std::endl
 	    << m_fileName << std::endl;
 
-  // Attempt to open the log file
-  tgOutput.open(m_fileName.c_str());
-  if (!tgOutput.is_open()) {
+  // A previous setup without a teardown leaves a writer behind; close
+  // that file first.
+  delete m_pWriter;
+  m_pWriter = NULL;
+
+  // Attempt to open the log file, and write the heading before the
+  // writer starts appending rows to it.
+  std::ofstream header(m_fileName.c_str());
+  if (!header.is_open()) {
     throw std::runtime_error("Log file could not be opened. Usually, this is because the directory you specified does not exist. Check for spelling errors.");
   }
 
   // Output a first line of the header.
-  tgOutput << "tgDataLogger2 started logging at time " << fileTime << ", with "
-	   << m_sensors.size() << " sensors on " << m_senseables.size()
-	   << " senseable objects." << std::endl;
+  header << "tgDataLogger2 started logging at time " << fileTime << ", with "
+	 << m_sensors.size() << " sensors on " << m_senseables.size()
+	 << " senseable objects." << std::endl;
 
   // The first column of data will be "time", the m_totalTime since beginning
   // of the simulation.
-  tgOutput << "time,";
-
-  // Iterate. For each sensor, output its header.
-  // Prepend each label with the sensor number, which we choose to be the index in
-  // the vector of sensors. NOTE that this means the sensors vector CANNOT
-  // BE CHANGED, otherwise the data will not be aligned properly.
-  for (std::size_t i=0; i < m_sensors.size(); i++) {
-    // Get the vector of sensor data headings from this sensor
-    std::vector<std::string> headings = m_sensors[i]->getSensorDataHeadings();
-    // Iterate and output each heading
-    for (std::size_t j=0; j < headings.size(); j++) {
-      // Prepend with the sensor number and an underscore.
-      // Also, end with a comma, since this is a comma-separated-value log file.
-      tgOutput << i << "_" << headings[j] << ",";
-    }
+  header << "time,";
+
+  // Then each sensor's headings, labelled with the sensor number, in the
+  // order readSensorFrame writes the values. NOTE that this means the
+  // sensors vector CANNOT BE CHANGED, otherwise the data will not be
+  // aligned properly.
+  const std::vector<std::string> headings = getFrameHeadings();
+  for (std::size_t i=0; i < headings.size(); i++) {
+    // End with a comma, since this is a comma-separated-value log file.
+    header << headings[i] << ",";
   }
   // End with a new line.
-  tgOutput << std::endl;
+  header << std::endl;
+  header.close();
+  if (header.fail()) {
+    throw std::runtime_error("Could not write to " + m_fileName);
+  }
+
+  // Room for the time and one reading of every sensor
+  m_row.assign(1 + m_frameSize, 0.0);
 
-  // Done! Close the output for now, will be re-opened during step.
-  tgOutput.close();
+  // The writer formats the rows of data from its own thread.
+  try {
+    m_pWriter = new tgAsyncLogWriter(m_fileName, 1 << 20, 1.0, true,
+				     new CSVRowFormatter(m_row.size()));
+  }
+  catch (const std::runtime_error&) {
+    throw std::runtime_error("Log file could not be opened. Usually, this is because the directory you specified does not exist. Check for spelling errors.");
+  }
 
   // Initialize/reset the values of the time variables.
   m_totalTime = 0.0;
@@ -181,8 +239,19 @@ void tgDataLogger2::teardown()
 {
   // Call the parent's teardown method! This is important!
   tgDataManager::teardown();
-  // Close the log file.
-  tgOutput.close();
+  // Write out anything still buffered and close the log file.
+  if (m_pWriter != NULL) {
+    tgAsyncLogWriter* const pWriter = m_pWriter;
+    m_pWriter = NULL;
+    try {
+      pWriter->close();
+    }
+    catch (...) {
+      delete pWriter;
+      throw;
+    }
+    delete pWriter;
+  }
   // Postcondition
   assert(invariant());
 }
@@ -191,7 +260,8 @@ void tgDataLogger2::teardown()
  * The step method is where data is actually collected!
  * This data logger will do two things here:
  * (1) iterate through all the sensors, collect their data, 
- * (2) write that line of data to the log file (then close the log again.)
+ * (2) hand the values to the writer, which formats them as a line of
+ *     the log file and appends it from its own thread.
  */
 void tgDataLogger2::step(double dt) 
 {
@@ -207,23 +277,19 @@ void tgDataLogger2::step(double dt)
     m_updateTime += dt;
     // Then, if enough time has elapsed between the previous sensor reading,
     if (m_updateTime >= m_timeInterval) {
-      // Open the log file for writing, appending and not overwriting.
-      tgOutput.open(m_fileName.c_str(), std::ios::app);
-      // Then output the time.
-      tgOutput << m_totalTime << ",";
-      // Collect the data and output it to the file!
-      for (size_t i=0; i < m_sensors.size(); i++) {
-	// Get the vector of sensor data from this sensor
-	std::vector<std::string> sensordata = m_sensors[i]->getSensorData();
-	// Iterate and output each data sample
-	for (std::size_t j=0; j < sensordata.size(); j++) {
-	  // Include a comma, since this is a comma-separated-value log file.
-	  tgOutput << sensordata[j] << ",";
-	}
+      // First, the time.
+      m_row[0] = m_totalTime;
+      // Collect the data from all the sensors at once, in the same order
+      // as the headings.
+      if (m_row.size() > 1) {
+	readSensorFrame(&m_row[1]);
+      }
+      // The writer only copies the values; it formats them as a line of
+      // the file from its own thread.
+      if (m_pWriter != NULL) {
+	m_pWriter->write(reinterpret_cast<const char*>(&m_row[0]),
+			 m_row.size() * sizeof(double));
       }
-      tgOutput << std::endl;
-      // Close the output, to be re-opened next step.
-      tgOutput.close();
       // Now that the sensors have been read, reset the counter.
       m_updateTime = 0.0;
     }
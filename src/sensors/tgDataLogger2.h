@@ -29,7 +29,10 @@
 // Includes from NTRTsim
 #include "tgDataManager.h"
 // Includes from the C++ standard library
-#include <fstream> // for writing to a file
+#include <vector>
+
+// Forward declarations
+class tgAsyncLogWriter;
 
 /**
  * tgDataLogger2 is a tgDataManager. It records data from sensors and outputs
@@ -71,15 +74,16 @@ class tgDataLogger2 : public tgDataManager
   virtual void setup();
 
   /**
-   * The teardown function closes the log file.
+   * The teardown function writes out any buffered data and closes the log file.
    * TO-DO: should this class also teardown the sensors, or should we let
    * the superclass handle it??
    */
   virtual void teardown();
 
   /**
-   * The step function for tgDataLogger2 will open the log file for output,
-   * write a line of sensor data, then close the log file.
+   * The step function for tgDataLogger2 will read a line of sensor data
+   * and hand it to the background writer, which formats it and writes it
+   * to the log file.
    * Declared virtual here just in case any classes inherit from this.
    * @param[in] dt a double, the amount of time since the last step. 
    */
@@ -112,9 +116,17 @@ class tgDataLogger2 : public tgDataManager
   std::string m_fileNamePrefix;
 
   /**
-   * A file stream, based on m_fileName.
+   * Writes to the file m_fileName from a background thread, so the
+   * simulation does not wait for the disk. Created in setup, deleted
+   * (which flushes and closes the file) in teardown. NULL otherwise.
+   */
+  tgAsyncLogWriter* m_pWriter;
+
+  /**
+   * The time followed by one sample of every sensor, read with
+   * readSensorFrame. Sized in setup, so that step does not allocate.
    */
-  std::ofstream tgOutput;
+  std::vector<double> m_row;
 
   /**
    * Keep track of the total time that the simulation has run.
@@ -32,13 +32,15 @@
 // The C++ Standard Library
 //#include <stdio.h> // for sprintf
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <cassert>
 
 /**
  * Nothing to do, in this abstract base class.
  */
-tgDataManager::tgDataManager()
+tgDataManager::tgDataManager() :
+  m_frameSize(0)
 {
   // Postcondition
   assert(invariant());
@@ -134,6 +136,12 @@ void tgDataManager::setup()
       addSensorsHelper(descendants[k]);
     }
   }
+
+  // Count the channels, so subclasses can size their frames now.
+  m_frameSize = 0;
+  for (std::size_t i = 0; i < m_sensors.size(); i++) {
+    m_frameSize += m_sensors[i]->getChannelCount();
+  }
   
   // Postcondition
   assert(invariant());
@@ -160,6 +168,7 @@ void tgDataManager::teardown()
   // Clear the list so that the destructor for this class doesn't have to
   // do anything.
   m_sensors.clear();
+  m_frameSize = 0;
 
   // Don't touch the list of senseable objects.
   // These tgModels are not re-created when teardown is called (I think?),
@@ -171,6 +180,35 @@ void tgDataManager::teardown()
   assert(m_sensors.empty());
 }
 
+/**
+ * Each sensor writes its channels right after the previous sensor's.
+ */
+void tgDataManager::readSensorFrame(double* frame) const
+{
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < m_sensors.size(); i++) {
+    m_sensors[i]->readInto(frame + offset);
+    offset += m_sensors[i]->getChannelCount();
+  }
+  assert(offset == m_frameSize);
+}
+
+std::vector<std::string> tgDataManager::getFrameHeadings() const
+{
+  std::vector<std::string> headings;
+  headings.reserve(m_frameSize);
+  for (std::size_t i = 0; i < m_sensors.size(); i++) {
+    const std::vector<std::string> sensorHeadings =
+      m_sensors[i]->getSensorDataHeadings();
+    for (std::size_t j = 0; j < sensorHeadings.size(); j++) {
+      std::ostringstream heading;
+      heading << i << "_" << sensorHeadings[j];
+      headings.push_back(heading.str());
+    }
+  }
+  return headings;
+}
+
 /**
  * The step method is where data is actually collected!
  * This base class won't do anything, but subclasses will re-implement this method.
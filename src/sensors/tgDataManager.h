@@ -29,6 +29,7 @@
 // This application
 #include "core/tgSenseable.h" //not sure why this needs to be included vs. just declared...
 // The C++ Standard Library
+#include <cstddef>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -123,6 +124,26 @@ protected:
      */
     std::vector<tgSensor*> m_sensors;
 
+    /**
+     * The total number of channels of all the sensors, counted during setup.
+     * This is the size of the frame that readSensorFrame fills.
+     */
+    std::size_t m_frameSize;
+
+    /**
+     * Read every sensor, in the order of m_sensors, into one contiguous
+     * frame, without allocating.
+     * @param[out] frame a buffer with room for m_frameSize values
+     */
+    void readSensorFrame(double* frame) const;
+
+    /**
+     * The headings of the values readSensorFrame writes: each sensor's
+     * headings, prefixed with the sensor's index and an underscore.
+     * @return m_frameSize headings
+     */
+    std::vector<std::string> getFrameHeadings() const;
+
     /**
      * Data managers also have a list of the sensor infos that
      * have been passed in to it.
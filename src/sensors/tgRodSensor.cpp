@@ -115,10 +115,18 @@ std::vector<std::string> tgRodSensor::getSensorDataHeadings() {
   return headings;
 }
 
+/**
+ * This sensor returns the XYZ position of the center of mass, the
+ * orientation, and the mass.
+ */
+std::size_t tgRodSensor::getChannelCount() const {
+  return 7;
+}
+
 /**
  * The method that collects the actual data from this tgRod.
  */
-std::vector<std::string> tgRodSensor::getSensorData() {
+void tgRodSensor::readInto(double* out) {
   // Similar to getSensorDataHeading, cast the a pointer to a tgRod right now.
   tgRod* m_pRod = tgCast::cast<tgSenseable, tgRod>(m_pSens);
   // Check: if the cast failed, this will return 0.
@@ -129,58 +137,22 @@ std::vector<std::string> tgRodSensor::getSensorData() {
   btVector3 orient = m_pRod->orientation();
   // Note that the 'orientation' method also returns a btVector3.
 
-  // The list of sensor data that will be returned:
-  std::vector<std::string> sensordata;
+  out[0] = com[0];
+  out[1] = com[1];
+  out[2] = com[2];
+  out[3] = orient[0];
+  out[4] = orient[1];
+  out[5] = orient[2];
+  out[6] = m_pRod->mass();
+}
 
-  /**
-   * The original version of this section of code, which 
-   * output one string, looked like:
-   * std::stringstream sensordata;
-   * sensordata << com[0] << ","
-   *	     << com[1] << ","
-   *	     << com[2] << ","
-   *	     << orient[0] << ","
-   *	     << orient[1] << ","
-   *	     << orient[2] << ","
-   *	     << m_pRod->mass() << ",";
-   */
-  
-  // The floats (btScalars?) need to be converted to strings
-  // via a stringstream.
-  std::stringstream ss;
-
-  // com[0]
-  ss << com[0];
-  sensordata.push_back( ss.str() );
-  // Reset the stream.
-  ss.str("");
-  
-  // com[1]
-  ss << com[1];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // com[2]
-  ss << com[2];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // orient[0]
-  ss << orient[0];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // orient[1]
-  ss << orient[1];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // orient[2]
-  ss << orient[2];
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  // mass
-  ss << m_pRod->mass();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  
-  return sensordata;
+/**
+ * The same data as readInto, as strings.
+ */
+std::vector<std::string> tgRodSensor::getSensorData() {
+  double values[7];
+  readInto(values);
+  return formatSensorData(values, 7);
 }
 
 //end.
@@ -29,10 +29,12 @@
 #include "core/tgSenseable.h"
 
 // Includes from the c++ standard library:
+#include <sstream>
 #include <stdexcept>
 
 /**
- * This cpp file only implements the constructor for tgSensor.
+ * This cpp file implements the constructor for tgSensor, and a helper
+ * for the subclasses.
  * Note that tgSensor is an abstract class with two pure virtual member
  * functions, so you cannot instantiate a tgSensor.
  * However, a constructor is provided here for ease of managing pointers
@@ -54,4 +56,23 @@ tgSensor::~tgSensor()
   // likely a tgModel, which is handled by other classes.
 }
 
+/**
+ * Each value goes through a stringstream with the default formatting,
+ * as the sensors have always done.
+ */
+std::vector<std::string> tgSensor::formatSensorData(const double* values,
+						    std::size_t n)
+{
+  std::vector<std::string> sensordata;
+  sensordata.reserve(n);
+  std::stringstream ss;
+  for (std::size_t i = 0; i < n; i++) {
+    ss << values[i];
+    sensordata.push_back( ss.str() );
+    // Reset the stream.
+    ss.str("");
+  }
+  return sensordata;
+}
+
 //end.
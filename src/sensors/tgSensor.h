@@ -31,6 +31,7 @@
 class tgSenseable;
 
 // From the C++ standard library:
+#include <cstddef> // for size_t
 #include <iostream> //for strings
 #include <vector> // for returning lists of strings
 
@@ -89,8 +90,38 @@ public:
    */
   virtual std::vector<std::string> getSensorData() = 0;
 
+  /**
+   * The number of values this sensor returns, one per heading.
+   * This is fixed when the sensor is created, so that callers can
+   * size their buffers once, during setup.
+   * @return the number of elements of getSensorDataHeadings(), getSensorData(),
+   * and the values written by readInto().
+   */
+  virtual std::size_t getChannelCount() const = 0;
+
+  /**
+   * Return the data from this class as numbers, written directly into a
+   * buffer owned by the caller. This is the same data as getSensorData,
+   * but nothing is allocated or formatted.
+   * @param[out] out a buffer with room for getChannelCount() values,
+   * which are written in the same order as the headings.
+   */
+  virtual void readInto(double* out) = 0;
+
   // TO-DO: should any of this be const?
 
+protected:
+
+  /**
+   * Format numbers the way getSensorData returns them, so that subclasses
+   * can implement getSensorData with readInto.
+   * @param[in] values the values to format
+   * @param[in] n the number of values
+   * @return one string per value
+   */
+  static std::vector<std::string> formatSensorData(const double* values,
+						   std::size_t n);
+
 protected:
 
   /**
@@ -109,10 +109,17 @@ std::vector<std::string> tgSpringCableActuatorSensor::getSensorDataHeadings() {
   return headings;
 }
 
+/**
+ * This sensor returns a rest length, current length, and tension.
+ */
+std::size_t tgSpringCableActuatorSensor::getChannelCount() const {
+  return 3;
+}
+
 /**
  * The method that collects the actual data from this tgSpringCableActuator.
  */
-std::vector<std::string> tgSpringCableActuatorSensor::getSensorData() {
+void tgSpringCableActuatorSensor::readInto(double* out) {
   // Similar to getSensorDataHeading, cast the a pointer
   // to a tgSpringCableActuator right now.
   tgSpringCableActuator* m_pSCA =
@@ -122,29 +129,18 @@ std::vector<std::string> tgSpringCableActuatorSensor::getSensorData() {
   // to a tgSpringCableActuator!!!
   assert( m_pSCA != 0);
 
-  // The list of sensor data that will be returned:
-  std::vector<std::string> sensordata;
-
-  // The floats doubles need to be converted to strings via a stringstream.
-  std::stringstream ss;
-
-  // rest length
-  ss << m_pSCA->getRestLength();
-  sensordata.push_back( ss.str() );
-  // Reset the stream.
-  ss.str("");
-
-  // current length
-  ss << m_pSCA->getCurrentLength();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-
-  // tension
-  ss << m_pSCA->getTension();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  
-  return sensordata;
+  out[0] = m_pSCA->getRestLength();
+  out[1] = m_pSCA->getCurrentLength();
+  out[2] = m_pSCA->getTension();
+}
+
+/**
+ * The same data as readInto, as strings.
+ */
+std::vector<std::string> tgSpringCableActuatorSensor::getSensorData() {
+  double values[3];
+  readInto(values);
+  return formatSensorData(values, 3);
 }
 
 //end.
@@ -56,6 +56,8 @@ public:
    */
   virtual std::vector<std::string> getSensorDataHeadings();
   virtual std::vector<std::string> getSensorData();
+  virtual std::size_t getChannelCount() const;
+  virtual void readInto(double* out);
 
 };
 
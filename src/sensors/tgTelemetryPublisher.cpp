@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTelemetryPublisher.cpp
+ * @brief Contains the implementation of class tgTelemetryPublisher.
+ * $Id$
+ */
+
+// This module
+#include "tgTelemetryPublisher.h"
+// This application
+#include "tgTelemetryRing.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <cassert>
+#include <sstream>
+
+tgTelemetryPublisher::tgTelemetryPublisher(std::string ringName,
+					   double timeInterval,
+					   std::size_t capacity) :
+  tgDataManager(),
+  m_ringName(ringName),
+  m_capacity(capacity),
+  m_pRing(NULL),
+  m_totalTime(0.0),
+  m_timeInterval(timeInterval),
+  m_updateTime(0.0)
+{
+  if (m_ringName == "") {
+    throw std::invalid_argument("Ring name cannot be the empty string.");
+  }
+  if (m_timeInterval < 0.0) {
+    throw std::invalid_argument("Time interval must be nonnegative. Negative time intervals do not make sense.");
+  }
+  if (m_capacity == 0) {
+    throw std::invalid_argument("Ring capacity must be positive.");
+  }
+
+  // Postcondition
+  assert(invariant());
+}
+
+tgTelemetryPublisher::~tgTelemetryPublisher()
+{
+  delete m_pRing;
+}
+
+void tgTelemetryPublisher::setup()
+{
+  // The parent creates the sensors.
+  tgDataManager::setup();
+
+  std::vector<std::string> headings(1, "time");
+  const std::vector<std::string> frameHeadings = getFrameHeadings();
+  headings.insert(headings.end(), frameHeadings.begin(), frameHeadings.end());
+
+  // A previous setup without a teardown leaves a ring behind.
+  delete m_pRing;
+  m_pRing = NULL;
+  m_pRing = new tgTelemetryRing(m_ringName, headings, m_capacity);
+
+  m_frame.assign(m_frameSize + 1, 0.0);
+  m_totalTime = 0.0;
+  m_updateTime = 0.0;
+
+  // Postcondition
+  assert(invariant());
+}
+
+void tgTelemetryPublisher::teardown()
+{
+  tgDataManager::teardown();
+  delete m_pRing;
+  m_pRing = NULL;
+  // Postcondition
+  assert(invariant());
+}
+
+void tgTelemetryPublisher::step(double dt)
+{
+  if (dt <= 0.0)
+  {
+    throw std::invalid_argument("dt is not positive");
+  }
+  m_totalTime += dt;
+  m_updateTime += dt;
+  if (m_updateTime >= m_timeInterval && m_pRing != NULL) {
+    m_frame[0] = m_totalTime;
+    readSensorFrame(&m_frame[1]);
+    m_pRing->publish(&m_frame[0]);
+    m_updateTime = 0.0;
+  }
+
+  // Postcondition
+  assert(invariant());
+}
+
+std::string tgTelemetryPublisher::toString() const
+{
+  std::ostringstream os;
+  os << tgDataManager::toString()
+     << "This tgDataManager is a tgTelemetryPublisher. " << std::endl;
+  return os.str();
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TELEMETRY_PUBLISHER_H
+#define TG_TELEMETRY_PUBLISHER_H
+
+/**
+ * @file tgTelemetryPublisher.h
+ * @brief Contains the definition of class tgTelemetryPublisher.
+ * $Id$
+ */
+
+// Includes from NTRTsim
+#include "tgDataManager.h"
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class tgTelemetryRing;
+
+/**
+ * tgTelemetryPublisher is a tgDataManager. It publishes the same frames
+ * as tgDataLogger2, with the same headings, into a tgTelemetryRing in
+ * shared memory instead of a file. Other processes can follow a run
+ * live with tgTelemetryRingReader, e.g. with tgTelemetryTail, without
+ * the simulation waiting for them or for a disk.
+ */
+class tgTelemetryPublisher : public tgDataManager
+{
+ public:
+
+  /**
+   * @param[in] ringName the name of the shared memory object, e.g.
+   * "/ntrt_telemetry"
+   * @param[in] timeInterval the time interval for querying sensors. 0
+   * means that sensors will be queried at each call of step().
+   * @param[in] capacity the number of frames the ring holds
+   * @throw std::invalid_argument if the name is empty, the interval is
+   * negative, or capacity is zero
+   */
+  tgTelemetryPublisher(std::string ringName, double timeInterval = 0.0,
+		       std::size_t capacity = 4096);
+
+  /**
+   * Closes the ring, if teardown was not called.
+   */
+  ~tgTelemetryPublisher();
+
+  /**
+   * Create the sensors, then create the ring. Readers of the ring of a
+   * previous setup see it closed.
+   */
+  virtual void setup();
+
+  /**
+   * Close the ring.
+   */
+  virtual void teardown();
+
+  /**
+   * Read every sensor, if timeInterval has passed, and publish the frame.
+   * @param[in] dt a double, the amount of time since the last step.
+   */
+  virtual void step(double dt);
+
+  virtual std::string toString() const;
+
+ protected:
+
+  std::string m_ringName;
+
+  std::size_t m_capacity;
+
+  /** Created in setup, deleted in teardown. NULL otherwise. */
+  tgTelemetryRing* m_pRing;
+
+  /** The time, then one sample of every sensor. Sized in setup. */
+  std::vector<double> m_frame;
+
+  /** The time since setup. */
+  double m_totalTime;
+
+  /** The time between sensor readings. */
+  double m_timeInterval;
+
+  /** The time since the last sensor reading. */
+  double m_updateTime;
+};
+
+#endif // TG_TELEMETRY_PUBLISHER_H
@@ -0,0 +1,137 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTelemetryRing.cpp
+ * @brief Contains the implementation of class tgTelemetryRing.
+ * $Id$
+ */
+
+// This module
+#include "tgTelemetryRing.h"
+// This application
+#include "tgTelemetryRingFormat.h"
+// Includes from the C++ standard library
+#include <cstring>
+#include <stdexcept>
+// POSIX, for the shared memory
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+tgTelemetryRing::tgTelemetryRing(const std::string& name,
+				 const std::vector<std::string>& headings,
+				 std::size_t capacity) :
+  m_name(name),
+  m_channelCount(headings.size()),
+  m_capacity(capacity),
+  m_pMapping(NULL),
+  m_mappingBytes(0),
+  m_pSlots(NULL),
+  m_slotBytes(tgTelemetryRingFormat::slotBytes(headings.size())),
+  m_published(0)
+{
+  if (headings.empty()) {
+    throw std::invalid_argument("A telemetry ring needs at least one channel.");
+  }
+  if (capacity == 0) {
+    throw std::invalid_argument("Telemetry ring capacity must be positive.");
+  }
+  if (m_name.empty() || m_name[0] != '/') {
+    m_name = "/" + m_name;
+  }
+
+  std::size_t headerBytes = sizeof(tgTelemetryRingFormat::Header);
+  for (std::size_t i = 0; i < headings.size(); i++) {
+    headerBytes += sizeof(uint32_t) + headings[i].size();
+  }
+  headerBytes = (headerBytes + 7) / 8 * 8;
+  m_mappingBytes = headerBytes + m_capacity * m_slotBytes;
+
+  // Readers of an earlier ring keep their mapping of the old object
+  shm_unlink(m_name.c_str());
+  const int fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Could not create shared memory " + m_name);
+  }
+  if (ftruncate(fd, m_mappingBytes) != 0) {
+    close(fd);
+    shm_unlink(m_name.c_str());
+    throw std::runtime_error("Could not size shared memory " + m_name);
+  }
+  m_pMapping = mmap(NULL, m_mappingBytes, PROT_READ | PROT_WRITE,
+		    MAP_SHARED, fd, 0);
+  close(fd);
+  if (m_pMapping == MAP_FAILED) {
+    m_pMapping = NULL;
+    shm_unlink(m_name.c_str());
+    throw std::runtime_error("Could not map shared memory " + m_name);
+  }
+
+  // A new object is zero filled, so every slot is empty
+  char* const p = static_cast<char*>(m_pMapping);
+  tgTelemetryRingFormat::Header* const pHeader =
+    reinterpret_cast<tgTelemetryRingFormat::Header*>(p);
+  pHeader->version = tgTelemetryRingFormat::version;
+  pHeader->headerBytes = headerBytes;
+  pHeader->channelCount = m_channelCount;
+  pHeader->capacity = m_capacity;
+  std::size_t offset = sizeof(tgTelemetryRingFormat::Header);
+  for (std::size_t i = 0; i < headings.size(); i++) {
+    const uint32_t length = headings[i].size();
+    std::memcpy(p + offset, &length, sizeof(length));
+    offset += sizeof(length);
+    std::memcpy(p + offset, headings[i].data(), length);
+    offset += length;
+  }
+  m_pSlots = p + headerBytes;
+
+  // Readers check the magic string last
+  tgTelemetryRingFormat::fence();
+  std::memcpy(pHeader->magic, tgTelemetryRingFormat::magic(),
+	      sizeof(pHeader->magic));
+}
+
+tgTelemetryRing::~tgTelemetryRing()
+{
+  tgTelemetryRingFormat::Header* const pHeader =
+    static_cast<tgTelemetryRingFormat::Header*>(m_pMapping);
+  tgTelemetryRingFormat::fence();
+  pHeader->closed = 1;
+  munmap(m_pMapping, m_mappingBytes);
+  shm_unlink(m_name.c_str());
+}
+
+void tgTelemetryRing::publish(const double* frame)
+{
+  char* const pSlot = m_pSlots + (m_published % m_capacity) * m_slotBytes;
+  volatile uint64_t* const pSequence =
+    reinterpret_cast<volatile uint64_t*>(pSlot);
+
+  *pSequence = tgTelemetryRingFormat::writing;
+  tgTelemetryRingFormat::fence();
+  std::memcpy(pSlot + sizeof(uint64_t), frame,
+	      m_channelCount * sizeof(double));
+  tgTelemetryRingFormat::fence();
+  // Sequence numbers start at 1, so an empty slot holds no frame
+  *pSequence = m_published + 1;
+  m_published++;
+  tgTelemetryRingFormat::fence();
+  static_cast<tgTelemetryRingFormat::Header*>(m_pMapping)->published =
+    m_published;
+}
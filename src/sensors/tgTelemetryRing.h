@@ -0,0 +1,101 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TELEMETRY_RING_H
+#define TG_TELEMETRY_RING_H
+
+/**
+ * @file tgTelemetryRing.h
+ * @brief Contains the definition of class tgTelemetryRing.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * tgTelemetryRing publishes frames of doubles into a ring buffer in
+ * POSIX shared memory (see tgTelemetryRingFormat), for other processes
+ * to follow with tgTelemetryRingReader. Publishing a frame copies it and
+ * never waits: readers that fall a whole ring behind lose frames instead
+ * of slowing the writer.
+ */
+class tgTelemetryRing
+{
+ public:
+
+  /**
+   * Create the shared memory object, replacing any left by an earlier
+   * run with the same name.
+   * @param[in] name the object's name; a leading "/" is added if missing
+   * @param[in] headings one heading per channel; must not be empty
+   * @param[in] capacity the number of frames the ring holds; must be
+   * positive
+   * @throw std::invalid_argument if headings is empty or capacity is zero
+   * @throw std::runtime_error if the object cannot be created
+   */
+  tgTelemetryRing(const std::string& name,
+		  const std::vector<std::string>& headings,
+		  std::size_t capacity = 4096);
+
+  /**
+   * Mark the ring as closed, so readers know to stop or to attach again,
+   * and remove the object's name. Readers keep their mapping.
+   */
+  ~tgTelemetryRing();
+
+  /**
+   * Publish one frame.
+   * @param[in] frame channelCount() values, in the order of the headings
+   */
+  void publish(const double* frame);
+
+  /** @return the number of values in each frame */
+  std::size_t channelCount() const { return m_channelCount; }
+
+  /** @return the object's name, with the leading "/" */
+  const std::string& name() const { return m_name; }
+
+ private:
+
+  // Not copyable
+  tgTelemetryRing(const tgTelemetryRing&);
+  tgTelemetryRing& operator=(const tgTelemetryRing&);
+
+ private:
+
+  std::string m_name;
+  const std::size_t m_channelCount;
+  const std::size_t m_capacity;
+
+  void* m_pMapping;
+  std::size_t m_mappingBytes;
+
+  /** The first slot in the mapping. */
+  char* m_pSlots;
+
+  std::size_t m_slotBytes;
+
+  /** The number of frames published. */
+  uint64_t m_published;
+};
+
+#endif // TG_TELEMETRY_RING_H
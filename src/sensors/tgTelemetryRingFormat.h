@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TELEMETRY_RING_FORMAT_H
+#define TG_TELEMETRY_RING_FORMAT_H
+
+/**
+ * @file tgTelemetryRingFormat.h
+ * @brief Contains the definition of class tgTelemetryRingFormat.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * The layout of the POSIX shared memory object that tgTelemetryRing
+ * publishes frames into and tgTelemetryRingReader follows. The object
+ * holds:
+ * - a Header,
+ * - the headings, each as a uint32 length and then its characters,
+ *   padded with zeros to a multiple of 8 bytes,
+ * - capacity slots, each a uint64 sequence number and then
+ *   channelCount float64 values.
+ *
+ * There is one writer, which never waits for the readers. Frame n goes
+ * into slot n % capacity. The writer marks the slot as being written,
+ * copies the frame, marks the slot as holding frame n, and then counts
+ * the frame as published. A reader copies a slot and then checks that
+ * the slot held the frame it wanted both before and after the copy; if
+ * not, the writer has lapped the reader and the frame is lost.
+ */
+class tgTelemetryRingFormat
+{
+ public:
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;
+    uint64_t channelCount;
+    uint64_t capacity;
+    /** The number of frames published so far. */
+    volatile uint64_t published;
+    /** Nonzero once the writer has closed the ring. */
+    volatile uint64_t closed;
+  };
+
+  /** The sequence number of a slot that is being written. */
+  static const uint64_t writing = ~static_cast<uint64_t>(0);
+
+  /** The first eight bytes of the object. */
+  static const char* magic() { return "NTRTRING"; }
+
+  static const uint32_t version = 1;
+
+  /**
+   * @return the size in bytes of a slot
+   */
+  static std::size_t slotBytes(std::size_t channelCount)
+  {
+    return sizeof(uint64_t) + channelCount * sizeof(double);
+  }
+
+  /**
+   * Order the memory accesses before it before those after it, for the
+   * compiler and the processor.
+   */
+  static void fence() { __sync_synchronize(); }
+};
+
+#endif // TG_TELEMETRY_RING_FORMAT_H
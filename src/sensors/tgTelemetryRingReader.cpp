@@ -0,0 +1,195 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTelemetryRingReader.cpp
+ * @brief Contains the implementation of class tgTelemetryRingReader.
+ * $Id$
+ */
+
+// This module
+#include "tgTelemetryRingReader.h"
+// This application
+#include "tgTelemetryRingFormat.h"
+// Includes from the C++ standard library
+#include <cstring>
+#include <stdexcept>
+// POSIX, for the shared memory
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  const tgTelemetryRingFormat::Header& header(const void* pMapping)
+  {
+    return *static_cast<const tgTelemetryRingFormat::Header*>(pMapping);
+  }
+}
+
+tgTelemetryRingReader::tgTelemetryRingReader(const std::string& name) :
+  m_pMapping(NULL),
+  m_mappingBytes(0),
+  m_pSlots(NULL),
+  m_slotBytes(0),
+  m_capacity(0),
+  m_next(0),
+  m_dropped(0)
+{
+  const std::string path = (!name.empty() && name[0] == '/') ? name : "/" + name;
+  const int fd = shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error("No telemetry ring named " + path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not read the size of telemetry ring " + path);
+  }
+  m_mappingBytes = info.st_size;
+  if (m_mappingBytes >= sizeof(tgTelemetryRingFormat::Header)) {
+    m_pMapping = mmap(NULL, m_mappingBytes, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (m_pMapping == MAP_FAILED || m_pMapping == NULL) {
+    m_pMapping = NULL;
+    throw std::runtime_error("Could not map telemetry ring " + path);
+  }
+
+  try {
+    parse(path);
+  }
+  catch (...) {
+    munmap(m_pMapping, m_mappingBytes);
+    m_pMapping = NULL;
+    throw;
+  }
+
+  const uint64_t n = published();
+  m_next = n > m_capacity ? n - m_capacity : 0;
+}
+
+void tgTelemetryRingReader::parse(const std::string& path)
+{
+  // The writer sets the magic string once the rest of the header is in
+  // place
+  const tgTelemetryRingFormat::Header& h = header(m_pMapping);
+  const bool ready = std::memcmp(h.magic, tgTelemetryRingFormat::magic(),
+				 sizeof(h.magic)) == 0;
+  tgTelemetryRingFormat::fence();
+  if (!ready || h.version != tgTelemetryRingFormat::version) {
+    throw std::runtime_error(path + " is not a ready telemetry ring");
+  }
+
+  // The sizes come from another process; check them against the mapping
+  // before using them
+  const std::string badRing = path + " is not a telemetry ring: ";
+  if (h.headerBytes < sizeof(tgTelemetryRingFormat::Header) ||
+      h.headerBytes % 8 != 0 || h.headerBytes > m_mappingBytes ||
+      h.channelCount == 0 || h.capacity == 0 ||
+      h.channelCount > (h.headerBytes - sizeof(tgTelemetryRingFormat::Header))
+		       / sizeof(uint32_t)) {
+    throw std::runtime_error(badRing + "bad header");
+  }
+  const std::size_t slotBytes = tgTelemetryRingFormat::slotBytes(h.channelCount);
+  if ((m_mappingBytes - h.headerBytes) % slotBytes != 0 ||
+      (m_mappingBytes - h.headerBytes) / slotBytes != h.capacity) {
+    throw std::runtime_error(badRing + "slots do not fit the object");
+  }
+
+  const char* const p = static_cast<const char*>(m_pMapping);
+  std::size_t offset = sizeof(tgTelemetryRingFormat::Header);
+  m_headings.reserve(h.channelCount);
+  for (uint64_t c = 0; c < h.channelCount; c++) {
+    if (offset + sizeof(uint32_t) > h.headerBytes) {
+      throw std::runtime_error(badRing + "headings do not fit the header");
+    }
+    uint32_t length;
+    std::memcpy(&length, p + offset, sizeof(length));
+    offset += sizeof(length);
+    if (length > h.headerBytes - offset) {
+      throw std::runtime_error(badRing + "headings do not fit the header");
+    }
+    m_headings.push_back(std::string(p + offset, length));
+    offset += length;
+  }
+  m_pSlots = p + h.headerBytes;
+  m_slotBytes = slotBytes;
+  m_capacity = h.capacity;
+}
+
+tgTelemetryRingReader::~tgTelemetryRingReader()
+{
+  munmap(m_pMapping, m_mappingBytes);
+}
+
+uint64_t tgTelemetryRingReader::published() const
+{
+  const uint64_t n = header(m_pMapping).published;
+  tgTelemetryRingFormat::fence();
+  return n;
+}
+
+bool tgTelemetryRingReader::closed() const
+{
+  return header(m_pMapping).closed != 0;
+}
+
+bool tgTelemetryRingReader::readNext(double* frame)
+{
+  for (;;) {
+    const uint64_t n = published();
+    if (m_next >= n) {
+      return false;
+    }
+    // Skip what the writer has already overwritten
+    const uint64_t oldest = n > m_capacity ? n - m_capacity : 0;
+    if (m_next < oldest) {
+      m_dropped += oldest - m_next;
+      m_next = oldest;
+    }
+    if (read(m_next, frame)) {
+      m_next++;
+      return true;
+    }
+    // Lapped during the copy; it is gone
+    m_dropped++;
+    m_next++;
+  }
+}
+
+void tgTelemetryRingReader::skipToLatest()
+{
+  m_next = published();
+}
+
+bool tgTelemetryRingReader::read(uint64_t n, double* frame) const
+{
+  const char* const pSlot = m_pSlots + (n % m_capacity) * m_slotBytes;
+  const volatile uint64_t* const pSequence =
+    reinterpret_cast<const volatile uint64_t*>(pSlot);
+
+  const uint64_t before = *pSequence;
+  tgTelemetryRingFormat::fence();
+  std::memcpy(frame, pSlot + sizeof(uint64_t),
+	      m_headings.size() * sizeof(double));
+  tgTelemetryRingFormat::fence();
+  const uint64_t after = *pSequence;
+  return before == n + 1 && after == n + 1;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TELEMETRY_RING_READER_H
+#define TG_TELEMETRY_RING_READER_H
+
+/**
+ * @file tgTelemetryRingReader.h
+ * @brief Contains the definition of class tgTelemetryRingReader.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * tgTelemetryRingReader attaches to a ring published by tgTelemetryRing,
+ * possibly in another process, and follows its frames. Any number of
+ * readers may follow one ring. Reading never blocks the writer; a reader
+ * that falls more than a ring behind skips the frames it lost, and
+ * counts them.
+ */
+class tgTelemetryRingReader
+{
+ public:
+
+  /**
+   * Attach to a ring. The reader starts at the oldest frame still in it.
+   * @param[in] name the ring's name; a leading "/" is added if missing
+   * @throw std::runtime_error if there is no such ring, it is not
+   * ready yet, or its header is malformed
+   */
+  explicit tgTelemetryRingReader(const std::string& name);
+
+  /** Detaches from the ring. */
+  ~tgTelemetryRingReader();
+
+  /** @return the heading of every channel */
+  const std::vector<std::string>& headings() const { return m_headings; }
+
+  /** @return the number of values in each frame */
+  std::size_t channelCount() const { return m_headings.size(); }
+
+  /** @return the number of frames the ring holds */
+  std::size_t capacity() const { return m_capacity; }
+
+  /** @return the number of frames the writer has published */
+  uint64_t published() const;
+
+  /**
+   * @return true once the writer has closed the ring. A new ring with the
+   * same name may have been created since; attach again to follow it.
+   */
+  bool closed() const;
+
+  /**
+   * Copy the next frame, if one has been published, and move past it.
+   * @param[out] frame room for channelCount() values
+   * @return true if a frame was copied, false if there is no new one
+   */
+  bool readNext(double* frame);
+
+  /**
+   * Skip to the newest frames: the next readNext() returns the next
+   * frame to be published.
+   */
+  void skipToLatest();
+
+  /** @return the number of the frame the next readNext() returns */
+  uint64_t position() const { return m_next; }
+
+  /** @return the number of frames skipped because the writer lapped them */
+  uint64_t dropped() const { return m_dropped; }
+
+ private:
+
+  /**
+   * Check the header against the size of the mapping and read the
+   * headings.
+   * @throw std::runtime_error if the ring is not ready or the header
+   * does not fit the mapping
+   */
+  void parse(const std::string& path);
+
+  /**
+   * Copy one frame, if it is still in the ring.
+   * @return false if it has been, or is being, overwritten
+   */
+  bool read(uint64_t n, double* frame) const;
+
+  // Not copyable
+  tgTelemetryRingReader(const tgTelemetryRingReader&);
+  tgTelemetryRingReader& operator=(const tgTelemetryRingReader&);
+
+ private:
+
+  void* m_pMapping;
+  std::size_t m_mappingBytes;
+
+  /** The first slot in the mapping. */
+  const char* m_pSlots;
+
+  std::size_t m_slotBytes;
+  std::size_t m_capacity;
+  std::vector<std::string> m_headings;
+
+  /** The number of the next frame to read. */
+  uint64_t m_next;
+
+  uint64_t m_dropped;
+};
+
+#endif // TG_TELEMETRY_RING_READER_H
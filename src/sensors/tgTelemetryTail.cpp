@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTelemetryTail.cpp
+ * @brief Follows a ring published by tgTelemetryPublisher.
+ * $Id$
+ *
+ * Usage: tgTelemetryTail /ring_name [--every n] [--latest]
+ *
+ * Prints the headings and then every nth frame as a CSV line, as the
+ * frames are published. With --latest, starts at the next frame instead
+ * of the oldest one still in the ring. When the ring is closed, e.g.
+ * because the simulation was reset, attaches to the new one. Lost frames
+ * are reported on the standard error.
+ */
+
+// This application
+#include "tgTelemetryRingReader.h"
+// Includes from the C++ standard library
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX, for usleep
+#include <unistd.h>
+
+namespace
+{
+  /** How long to wait when there are no new frames, in microseconds. */
+  const useconds_t pollInterval = 2000;
+
+  int usage()
+  {
+    std::cerr << "Usage: tgTelemetryTail /ring_name [--every n] [--latest]"
+	      << std::endl;
+    return 2;
+  }
+
+  /** Follow one ring until it is closed. */
+  void follow(tgTelemetryRingReader& ring, unsigned long every, bool latest)
+  {
+    if (latest) {
+      ring.skipToLatest();
+    }
+    const std::vector<std::string>& headings = ring.headings();
+    for (std::size_t c = 0; c < headings.size(); c++) {
+      std::cout << headings[c] << ",";
+    }
+    std::cout << std::endl;
+
+    std::vector<double> frame(ring.channelCount());
+    uint64_t reported = 0;
+    for (;;) {
+      if (!ring.readNext(&frame[0])) {
+	// Frames published before the close are still read
+	if (ring.closed() && ring.position() >= ring.published()) {
+	  return;
+	}
+	std::cout.flush();
+	usleep(pollInterval);
+	continue;
+      }
+      if (ring.dropped() != reported) {
+	std::cerr << "tgTelemetryTail: lost " << ring.dropped() - reported
+		  << " frames" << std::endl;
+	reported = ring.dropped();
+      }
+      // Number frames by their position in the ring, so --every stays
+      // in step with the simulation when frames are lost
+      const uint64_t n = ring.position() - 1;
+      if (n % every != 0) {
+	continue;
+      }
+      for (std::size_t c = 0; c < frame.size(); c++) {
+	std::cout << frame[c] << ",";
+      }
+      std::cout << '\n';
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string name;
+  unsigned long every = 1;
+  bool latest = false;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+      every = std::strtoul(argv[++i], NULL, 10);
+    }
+    else if (std::strcmp(argv[i], "--latest") == 0) {
+      latest = true;
+    }
+    else if (name.empty()) {
+      name = argv[i];
+    }
+    else {
+      return usage();
+    }
+  }
+  if (name.empty() || every == 0) {
+    return usage();
+  }
+
+  std::cout.precision(std::numeric_limits<double>::digits10 + 2);
+  for (;;) {
+    try {
+      tgTelemetryRingReader ring(name);
+      if (!ring.closed()) {
+	follow(ring, every, latest);
+	// Only the first ring starts at the latest frame
+	latest = false;
+      }
+    }
+    catch (const std::runtime_error&) {
+      // Not created yet, or being replaced
+    }
+    usleep(pollInterval);
+  }
+  return 0;
+}
@@ -28,6 +28,7 @@
 
 #include "core/tgBulletSpringCable.h"
 #include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgWorldBulletPhysicsImpl.h"
 
 tgBasicActuatorInfo::tgBasicActuatorInfo(const tgBasicActuator::Config& config) : 
 m_config(config),
@@ -53,7 +54,7 @@ tgConnectorInfo* tgBasicActuatorInfo::createConnectorInfo(const tgPair& pair)
 void tgBasicActuatorInfo::initConnector(tgWorld& world)
 {
     // Note: tgBulletSpringCable holds pointers to things in the world, but it doesn't actually have any in-world representation.
-    m_bulletSpringCable = createTgBulletSpringCable();
+    m_bulletSpringCable = createTgBulletSpringCable(world);
 }
 
 tgModel* tgBasicActuatorInfo::createModel(tgWorld& world)
@@ -74,7 +75,7 @@ double tgBasicActuatorInfo::getMass()
 }
 
 
-tgBulletSpringCable* tgBasicActuatorInfo::createTgBulletSpringCable()
+tgBulletSpringCable* tgBasicActuatorInfo::createTgBulletSpringCable(tgWorld& world)
 {
      
     // @todo: need to check somewhere that the rigid bodies have been set...
@@ -121,6 +122,12 @@ tgBulletSpringCable* tgBasicActuatorInfo::createTgBulletSpringCable()
     tgBulletSpringCableAnchor* anchor2 = new tgBulletSpringCableAnchor(toBody, to);
     anchorList.push_back(anchor2);
 	
-    return new tgBulletSpringCable(anchorList, m_config.stiffness, m_config.damping, m_config.pretension);
+    // The world finds the lengths and applies the forces of all two-anchor
+    // cables together
+    tgWorldBulletPhysicsImpl& bulletWorld =
+      (tgWorldBulletPhysicsImpl&)world.implementation();
+
+    return new tgBulletSpringCable(anchorList, m_config.stiffness, m_config.damping, m_config.pretension,
+                                   &bulletWorld.cableBatch());
 }
     
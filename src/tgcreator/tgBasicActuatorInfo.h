@@ -81,7 +81,7 @@ public:
 
 protected:    
     
-    tgBulletSpringCable* createTgBulletSpringCable();
+    tgBulletSpringCable* createTgBulletSpringCable(tgWorld& world);
     tgBulletSpringCable* m_bulletSpringCable;
 private:
     
@@ -0,0 +1,150 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBlueprint.cpp
+ * @brief Implementation of class tgBlueprint
+ * $Id$
+ */
+
+// This module
+#include "tgBlueprint.h"
+// This library
+#include "tgConnectorInfo.h"
+#include "tgRigidInfo.h"
+#include "tgStructureInfo.h"
+#include "core/tgModel.h"
+// The C++ Standard Library
+#include <cassert>
+
+tgBlueprint::tgBlueprint(tgStructure& structure, tgBuildSpec& buildSpec) :
+    m_pStructureInfo(new tgStructureInfo(structure, buildSpec))
+{
+    m_pStructureInfo->resolve();
+
+    m_modelTags.push_back(m_pStructureInfo->getTags());
+    addParts(*m_pStructureInfo, 0);
+
+    m_worldRigids = m_rigids;
+    const std::vector<tgRigidInfo*>& compounded = m_pStructureInfo->m_compounded;
+    for (std::size_t i = 0; i < compounded.size(); i++)
+    {
+        // A rigid in a group of its own is in m_rigids already
+        if (compounded[i]->getRigidInfoGroup() != compounded[i])
+        {
+            m_worldRigids.push_back(compounded[i]);
+        }
+    }
+}
+
+tgBlueprint::~tgBlueprint()
+{
+    delete m_pStructureInfo;
+}
+
+void tgBlueprint::addParts(const tgStructureInfo& structureInfo,
+                           std::size_t model)
+{
+    const std::vector<tgRigidInfo*>& rigids = structureInfo.getRigids();
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        assert(rigids[i] != NULL);
+        const Part part = { rigids[i], NULL, model };
+        m_parts.push_back(part);
+        m_rigids.push_back(rigids[i]);
+    }
+
+    const std::vector<tgConnectorInfo*>& connectors =
+        structureInfo.getConnectors();
+    for (std::size_t i = 0; i < connectors.size(); i++)
+    {
+        assert(connectors[i] != NULL);
+        const Part part = { NULL, connectors[i], model };
+        m_parts.push_back(part);
+        m_connectors.push_back(connectors[i]);
+    }
+
+    const std::vector<tgStructureInfo*>& children =
+        structureInfo.getChildren();
+    for (std::size_t i = 0; i < children.size(); i++)
+    {
+        assert(children[i] != NULL);
+        const Part part = { NULL, NULL, model };
+        m_parts.push_back(part);
+        const std::size_t childModel = m_modelTags.size();
+        m_modelTags.push_back(children[i]->getTags());
+        addParts(*children[i], childModel);
+    }
+}
+
+void tgBlueprint::buildInto(tgModel& model, tgWorld& world)
+{
+    // The previous world deleted its shapes and bodies when it was reset
+    for (std::size_t i = 0; i < m_worldRigids.size(); i++)
+    {
+        m_worldRigids[i]->forgetWorld();
+    }
+
+    // As tgStructureInfo::buildInto: all bodies, then all connectors,
+    // then the models
+    for (std::size_t i = 0; i < m_rigids.size(); i++)
+    {
+        m_rigids[i]->initRigidBody(world);
+    }
+    for (std::size_t i = 0; i < m_connectors.size(); i++)
+    {
+        m_connectors[i]->initConnector(world);
+    }
+
+    std::vector<tgModel*> models;
+    models.reserve(m_modelTags.size());
+    models.push_back(&model);
+    for (std::size_t i = 0; i < m_parts.size(); i++)
+    {
+        const Part& part = m_parts[i];
+        tgModel* pModel = NULL;
+        if (part.pRigidInfo != NULL)
+        {
+            pModel = part.pRigidInfo->createModel(world);
+            if (pModel != NULL)
+            {
+                pModel->setTags(part.pRigidInfo->getTags());
+            }
+        }
+        else if (part.pConnectorInfo != NULL)
+        {
+            pModel = part.pConnectorInfo->createModel(world);
+            if (pModel != NULL)
+            {
+                pModel->setTags(part.pConnectorInfo->getTags());
+            }
+        }
+        else
+        {
+            pModel = new tgModel(m_modelTags[models.size()]);
+            models.push_back(pModel);
+        }
+
+        if (pModel != NULL)
+        {
+            models[part.model]->addChild(pModel);
+        }
+    }
+
+    model.setTags(m_modelTags[0]);
+}
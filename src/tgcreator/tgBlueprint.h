@@ -0,0 +1,132 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BLUEPRINT_H
+#define TG_BLUEPRINT_H
+
+/**
+ * @file tgBlueprint.h
+ * @brief Definition of class tgBlueprint
+ * $Id$
+ */
+
+// NTRT Core library
+#include "core/tgTags.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgBuildSpec;
+class tgConnectorInfo;
+class tgModel;
+class tgRigidInfo;
+class tgStructure;
+class tgStructureInfo;
+class tgWorld;
+
+/**
+ * A structure resolved once, to be built into a model many times.
+ *
+ * tgStructureInfo::buildInto matches the structure against the build
+ * spec, auto-compounds the rigids and attaches the connectors every time
+ * it is called, and none of that depends on the world. A model that
+ * builds the same structure at every setup can keep a tgBlueprint
+ * instead: the constructor does that work, and lays the resulting rigid
+ * and connector infos out in flat arrays in the order buildInto would
+ * visit them. buildInto() then only creates the Bullet objects and the
+ * tgModels from those arrays, so each reset costs the instantiation
+ * alone.
+ *
+ * The models built are the same as those of tgStructureInfo::buildInto,
+ * in the same order.
+ */
+class tgBlueprint
+{
+public:
+
+    /**
+     * Resolve the structure. Neither argument is used afterwards, so
+     * they may be locals of the caller.
+     * @param[in] structure the structure to build
+     * @param[in] buildSpec the builders for its nodes and pairs
+     */
+    tgBlueprint(tgStructure& structure, tgBuildSpec& buildSpec);
+
+    ~tgBlueprint();
+
+    /**
+     * Create the rigid bodies and connectors in the world, and add them
+     * to model as tgStructureInfo::buildInto does. The world the
+     * previous call built into must have been reset since, as its
+     * bodies are forgotten.
+     * @param[in,out] model the model to add the parts to
+     * @param[in] world the world to create the parts in
+     */
+    void buildInto(tgModel& model, tgWorld& world);
+
+    /** @return the resolved structure, e.g. for tracing */
+    const tgStructureInfo& getStructureInfo() const
+    {
+        return *m_pStructureInfo;
+    }
+
+private:
+
+    /**
+     * One model to create in buildInto(). Exactly one of the pointers is
+     * set, or neither for a tgModel standing for a substructure.
+     */
+    struct Part
+    {
+        tgRigidInfo* pRigidInfo;
+        tgConnectorInfo* pConnectorInfo;
+        /** The model to add this to, as an index into m_modelTags */
+        std::size_t model;
+    };
+
+    /** Append the parts of structureInfo, to be added to model. */
+    void addParts(const tgStructureInfo& structureInfo, std::size_t model);
+
+    // Not copyable
+    tgBlueprint(const tgBlueprint&);
+    tgBlueprint& operator=(const tgBlueprint&);
+
+private:
+
+    /** Owns the infos that the arrays point to. */
+    tgStructureInfo* m_pStructureInfo;
+
+    /** The rigids whose bodies are created, in order. */
+    std::vector<tgRigidInfo*> m_rigids;
+
+    /** The rigids that hold a world's objects, the compounds included */
+    std::vector<tgRigidInfo*> m_worldRigids;
+
+    std::vector<tgConnectorInfo*> m_connectors;
+
+    std::vector<Part> m_parts;
+
+    /**
+     * The tags of the model built into, then of the model of each
+     * substructure, in the order of their parts.
+     */
+    std::vector<tgTags> m_modelTags;
+};
+
+#endif  // TG_BLUEPRINT_H
@@ -65,10 +65,110 @@ void tgBuildSpec::addBuilder(std::string tag_search, tgRigidInfo* infoFactory)
     
     //m_infoFactorys.push_back(tgBuildSpec::Entry(tgTagSearch(tag_search), infoFactory)); // @todo: make this work
     m_rigidAgents.push_back(new RigidAgent(tag_search, infoFactory));
+    m_rigidSearches.push_back(compileSearch(tag_search));
 }
 
 void tgBuildSpec::addBuilder(std::string tag_search, tgConnectorInfo* infoFactory)
 {
     m_connectorAgents.push_back(new ConnectorAgent(tag_search, infoFactory));
+    m_connectorSearches.push_back(compileSearch(tag_search));
+}
+
+tgBuildSpec::Matcher tgBuildSpec::matcher(const tgTags& inherited) const
+{
+    return Matcher(*this, inherited);
+}
+
+std::vector<std::size_t> tgBuildSpec::compileSearch(const std::string& tag_search)
+{
+    const tgTags search(tag_search);
+    const std::vector<tgTagRegistry::Id>& ids = search.getIds();
+    std::vector<std::size_t> bits;
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        // New tags get the next bit
+        const std::size_t bit =
+            m_tagBits.insert(std::make_pair(ids[i], m_tagBits.size())).first->second;
+        bits.push_back(bit);
+    }
+    return bits;
+}
+
+tgBuildSpec::Matcher::Matcher(const tgBuildSpec& buildSpec,
+                              const tgTags& inherited) :
+    m_buildSpec(buildSpec)
+{
+    // A search matches when the candidate has every tag it needs. Tags
+    // the structure has are not needed (see tgTagSearch::remove())
+    const TagSet have = toTagSet(inherited);
+    const std::size_t nTags = m_buildSpec.m_tagBits.size();
+
+    for (std::size_t i = 0; i < m_buildSpec.m_rigidSearches.size(); i++) {
+        const std::vector<std::size_t>& search = m_buildSpec.m_rigidSearches[i];
+        TagSet need(nTags);
+        for (std::size_t j = 0; j < search.size(); j++) {
+            need.set(search[j]);
+        }
+        m_rigidNeeds.push_back(need - have);
+    }
+
+    for (std::size_t i = 0; i < m_buildSpec.m_connectorSearches.size(); i++) {
+        const std::vector<std::size_t>& search = m_buildSpec.m_connectorSearches[i];
+        TagSet need(nTags);
+        for (std::size_t j = 0; j < search.size(); j++) {
+            need.set(search[j]);
+        }
+        m_connectorNeeds.push_back(need - have);
+    }
+}
+
+const std::vector<tgBuildSpec::RigidAgent*>&
+tgBuildSpec::Matcher::rigidAgents(const tgTags& tags)
+{
+    const TagSet have = toTagSet(tags);
+    std::map<TagSet, std::vector<RigidAgent*> >::iterator it =
+        m_rigidMatches.find(have);
+    if (it == m_rigidMatches.end()) {
+        std::vector<RigidAgent*> matches;
+        for (int i = m_rigidNeeds.size() - 1; i >= 0; i--) {
+            if (m_rigidNeeds[i].is_subset_of(have)) {
+                matches.push_back(m_buildSpec.m_rigidAgents[i]);
+            }
+        }
+        it = m_rigidMatches.insert(std::make_pair(have, matches)).first;
+    }
+    return it->second;
+}
+
+const std::vector<tgBuildSpec::ConnectorAgent*>&
+tgBuildSpec::Matcher::connectorAgents(const tgTags& tags)
+{
+    const TagSet have = toTagSet(tags);
+    std::map<TagSet, std::vector<ConnectorAgent*> >::iterator it =
+        m_connectorMatches.find(have);
+    if (it == m_connectorMatches.end()) {
+        std::vector<ConnectorAgent*> matches;
+        for (int i = m_connectorNeeds.size() - 1; i >= 0; i--) {
+            if (m_connectorNeeds[i].is_subset_of(have)) {
+                matches.push_back(m_buildSpec.m_connectorAgents[i]);
+            }
+        }
+        it = m_connectorMatches.insert(std::make_pair(have, matches)).first;
+    }
+    return it->second;
+}
+
+tgBuildSpec::TagSet tgBuildSpec::Matcher::toTagSet(const tgTags& tags) const
+{
+    const std::map<tgTagRegistry::Id, std::size_t>& tagBits = m_buildSpec.m_tagBits;
+    TagSet result(tagBits.size());
+    const std::vector<tgTagRegistry::Id>& ids = tags.getIds();
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        const std::map<tgTagRegistry::Id, std::size_t>::const_iterator it =
+            tagBits.find(ids[i]);
+        if (it != tagBits.end()) {
+            result.set(it->second);
+        }
+    }
+    return result;
 }
 
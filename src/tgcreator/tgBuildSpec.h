@@ -27,8 +27,12 @@
 #ifndef TG_BUILD_SPEC_H
 #define TG_BUILD_SPEC_H
 
+#include <map>
+#include <string>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "core/tgTagSearch.h"
 
 class tgRigidInfo;
@@ -71,6 +75,51 @@ public:
         tgConnectorInfo* infoFactory;
     };
 
+    /** A set of the tags used by the builders, one bit per tag */
+    typedef boost::dynamic_bitset<> TagSet;
+
+    /**
+     * The builders whose searches match a candidate's tags, found once
+     * for each distinct set of tags. Made by tgBuildSpec::matcher() for
+     * the nodes and pairs of one structure.
+     */
+    class Matcher
+    {
+    public:
+
+        /**
+         * @param[in] tags a node's or pair's tags
+         * @return the rigid agents whose searches match, the one added
+         * last first
+         */
+        const std::vector<RigidAgent*>& rigidAgents(const tgTags& tags);
+
+        /**
+         * @param[in] tags a pair's tags
+         * @return the connector agents whose searches match, the one
+         * added last first
+         */
+        const std::vector<ConnectorAgent*>& connectorAgents(const tgTags& tags);
+
+    private:
+
+        friend class tgBuildSpec;
+
+        Matcher(const tgBuildSpec& buildSpec, const tgTags& inherited);
+
+        /** The tags that are in a search; the others are ignored */
+        TagSet toTagSet(const tgTags& tags) const;
+
+        const tgBuildSpec& m_buildSpec;
+
+        /** What each search needs of a candidate, by agent index */
+        std::vector<TagSet> m_rigidNeeds;
+        std::vector<TagSet> m_connectorNeeds;
+
+        std::map<TagSet, std::vector<RigidAgent*> > m_rigidMatches;
+        std::map<TagSet, std::vector<ConnectorAgent*> > m_connectorMatches;
+    };
+
     tgBuildSpec() {}
     virtual ~tgBuildSpec();
 
@@ -87,10 +136,32 @@ public:
     {
         return m_connectorAgents;
     }
+
+    /**
+     * Compile the builders' searches for the nodes and pairs of one
+     * structure. The structure's tags are taken off every search, so
+     * that its nodes and pairs inherit them.
+     * @param[in] inherited the structure's tags
+     */
+    Matcher matcher(const tgTags& inherited) const;
     
 private:
+
+    /** @return the tags of a search string, as bits of a TagSet */
+    std::vector<std::size_t> compileSearch(const std::string& tag_search);
+
     std::vector<RigidAgent*> m_rigidAgents;
     std::vector<ConnectorAgent*> m_connectorAgents;  
+
+    /**
+     * The bit in a TagSet of each tag used in a search, by tgTagRegistry
+     * id. Numbered apart from the ids so that the sets stay small.
+     */
+    std::map<tgTagRegistry::Id, std::size_t> m_tagBits;
+
+    /** The tags of each agent's search, by agent index */
+    std::vector< std::vector<std::size_t> > m_rigidSearches;
+    std::vector< std::vector<std::size_t> > m_connectorSearches;
 };
 
 #endif
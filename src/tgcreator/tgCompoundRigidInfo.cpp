@@ -100,6 +100,12 @@ btTransform tgCompoundRigidInfo::getTransform() const
     return t;
 }
     
+void tgCompoundRigidInfo::forgetWorld()
+{
+    tgRigidInfo::forgetWorld();
+    m_compoundShape = NULL;
+}
+
 double tgCompoundRigidInfo::getMass() const
 {
     /// @todo Use std::accumulate()
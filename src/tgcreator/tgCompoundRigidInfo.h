@@ -91,6 +91,12 @@ class tgCompoundRigidInfo : public tgRigidInfo
      */
     virtual btCollisionShape* getCollisionShape(tgWorld& world) const;
 
+    /**
+     * Also forget the compound shape. The component rigids must be
+     * forgotten separately.
+     */
+    virtual void forgetWorld();
+
     /**
      * Return an identity btTransform with the origin being the center of mass.
      * @return an identity btTransform with the origin being the center of mass
@@ -30,7 +30,10 @@
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
 #include "tgCompoundRigidInfo.h"
 // The C++ standard library
+#include <algorithm>
 #include <map>
+#include <set>
+#include <utility>
 #include <cstdlib> // for random number generator
 #include <sstream> // for string streams, tags.
 // Boost
@@ -85,51 +88,104 @@ void tgRigidAutoCompound::setRigidInfoForGroup(tgRigidInfo* rigidInfo, std::dequ
     }
 }
 
-void tgRigidAutoCompound::groupRigids()
+namespace
 {
-    std::deque<tgRigidInfo*> ungrouped = std::deque<tgRigidInfo*>(m_rigids); // Copy of m_rigids
+    /**
+     * Orders nodes by their coordinates. Two nodes are equivalent exactly
+     * when operator== says they are equal, which is the test
+     * tgRigidInfo::sharesNodesWith uses.
+     */
+    struct NodeLess
+    {
+        bool operator()(const btVector3& lhs, const btVector3& rhs) const
+        {
+            if (lhs.x() != rhs.x()) return lhs.x() < rhs.x();
+            if (lhs.y() != rhs.y()) return lhs.y() < rhs.y();
+            return lhs.z() < rhs.z();
+        }
+    };
 
-    while(ungrouped.size() > 0) {
-        // go through each ungrouped element and find the groups for it
-        tgRigidInfo* elem = ungrouped[0]; // Note: the 0 element is removed by findGroup, so ungrouped[0] is different each iteration
+    /** The indices of the rigids that contain each node, in ascending order */
+    typedef std::map<btVector3, std::vector<std::size_t>, NodeLess> NodeOwners;
+}
 
-        // Find all elements linked to the first item in ungrouped
-        // This will also remove the elements in the group from ungrouped
-        std::deque<tgRigidInfo*> group = findGroup(elem, ungrouped);
+void tgRigidAutoCompound::groupRigids()
+{
+    const std::size_t n = m_rigids.size();
 
-        // Add the group to the groups list
-        m_groups.push_back(group);            
+    // Index the rigids by the nodes they contain, so that the rigids
+    // sharing nodes with one rigid are found without comparing it to
+    // every other rigid
+    NodeOwners owners;
+    for (std::size_t i = 0; i < n; i++) {
+        const std::set<btVector3> nodes = m_rigids[i]->getContainedNodes();
+        for (std::set<btVector3>::const_iterator it = nodes.begin();
+             it != nodes.end(); ++it) {
+            owners[*it].push_back(i);
+        }
+    }
+
+    // For each rigid, the rigids it shares nodes with, in ascending order
+    std::vector< std::vector<std::size_t> > neighbours(n);
+    for (NodeOwners::const_iterator it = owners.begin(); it != owners.end(); ++it) {
+        const std::vector<std::size_t>& rigids = it->second;
+        for (std::size_t a = 0; a < rigids.size(); a++) {
+            for (std::size_t b = 0; b < rigids.size(); b++) {
+                if (a != b) {
+                    neighbours[rigids[a]].push_back(rigids[b]);
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        std::vector<std::size_t>& linked = neighbours[i];
+        std::sort(linked.begin(), linked.end());
+        linked.erase(std::unique(linked.begin(), linked.end()), linked.end());
     }
-}
 
-// Find all rigids that should be in a group with the given rigid
-// @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-std::deque<tgRigidInfo*> tgRigidAutoCompound::findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped) {
+    // Each group starts at the first ungrouped rigid and takes the linked
+    // rigids depth first, lowest index first, so that the groups and the
+    // order within them are the same as when each rigid was compared to
+    // every ungrouped rigid in turn. A rigid listed twice is grouped once.
+    std::vector<bool> visited(n, false);
+    std::set<tgRigidInfo*> grouped;
+    std::vector< std::pair<std::size_t, std::size_t> > stack;
+    for (std::size_t first = 0; first < n; first++) {
+        if (visited[first] || !grouped.insert(m_rigids[first]).second) {
+            continue;
+        }
 
-    std::deque<tgRigidInfo*> group;
+        std::deque<tgRigidInfo*> group;
+        visited[first] = true;
+        group.push_back(m_rigids[first]);
+        stack.push_back(std::make_pair(first, std::size_t(0)));
 
-    // Add the rigid to the current group
-    group.push_back(rigid);     
-    
-    // Remove the rigid from the ungrouped since it's now in a group
-    ungrouped.erase(std::remove(ungrouped.begin(), ungrouped.end(), rigid), ungrouped.end());
-    
-    // Recursively find linked elements
-    int i = 0;
-    while(i < ungrouped.size()) {
-        tgRigidInfo* other = ungrouped[i];
-        if(rigid->sharesNodesWith(*other)) {
-            std::deque<tgRigidInfo*> links = findGroup(other, ungrouped);
-            group.insert(group.end(), links.begin(), links.end());
-            i = 0;
-        } else {
-            i++;
+        while (!stack.empty()) {
+            // The current rigid, and the next of its links to try
+            const std::size_t current = stack.back().first;
+            std::size_t& next = stack.back().second;
+            const std::vector<std::size_t>& linked = neighbours[current];
+            while (next < linked.size() && visited[linked[next]]) {
+                next++;
+            }
+            if (next == linked.size()) {
+                stack.pop_back();
+                continue;
+            }
+
+            const std::size_t other = linked[next];
+            visited[other] = true;
+            if (grouped.insert(m_rigids[other]).second) {
+                group.push_back(m_rigids[other]);
+                stack.push_back(std::make_pair(other, std::size_t(0)));
+            }
         }
+
+        // Add the group to the groups list
+        m_groups.push_back(group);
     }
+}
 
-    return group;
-};
-    
 void tgRigidAutoCompound::createCompounds() {
     for(int i=0; i < m_groups.size(); i++) {
         std::deque<tgRigidInfo*>& group = m_groups[i];
@@ -66,12 +66,13 @@ protected:
    
     void setRigidInfoForGroup(tgRigidInfo* rigidInfo, std::deque<tgRigidInfo*>& group);
     
+    /**
+     * Sort the rigids into m_groups, each group holding the rigids that
+     * are linked to each other by shared nodes. Rigids that share no
+     * nodes get a group of their own.
+     */
     void groupRigids();
 
-    // Find all rigids that should be in a group with the given rigid
-    // @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-    std::deque<tgRigidInfo*> findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped);
-
     /**
      * Creates tgCompoundRigidInfos for compounded bodies.
      * Also, adds tags to each of the consitutent tgRigidInfos 
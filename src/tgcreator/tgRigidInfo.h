@@ -140,6 +140,17 @@ public:
         m_collisionShape = p_btCollisionShape;
     }
 
+    /**
+     * Forget the collision shape and body made by initRigidBody(), once
+     * the world that owns them has been reset, so that the next
+     * initRigidBody() makes new ones in the new world.
+     */
+    virtual void forgetWorld()
+    {
+        m_collisionShape = NULL;
+        m_collisionObject = NULL;
+    }
+
     /**
      * Get the tgRigidInfo that represents the compound rigid
      * that this rigid belongs to. If it doesn't share nodes with
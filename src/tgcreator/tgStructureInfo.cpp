@@ -38,7 +38,8 @@
 tgStructureInfo::tgStructureInfo(tgStructure& structure, tgBuildSpec& buildSpec) : 
     tgTaggable(),
     m_structure(structure), 
-    m_buildSpec(buildSpec)
+    m_buildSpec(buildSpec),
+    m_resolved(false)
 {
     createTree(*this, structure);    
 }
@@ -47,7 +48,8 @@ tgStructureInfo::tgStructureInfo(tgStructure& structure, tgBuildSpec& buildSpec,
                  const tgTags& tags) :
     tgTaggable(tags),
     m_structure(structure), 
-    m_buildSpec(buildSpec)
+    m_buildSpec(buildSpec),
+    m_resolved(false)
 {
     createTree(*this, structure);    
 }
@@ -119,27 +121,29 @@ std::vector<tgRigidInfo*> tgStructureInfo::getAllRigids() const
 ////////////////////////////
 
 void tgStructureInfo::addRigidsAndConnectors() {
-    const std::vector<tgBuildSpec::RigidAgent*> rigidAgents = m_buildSpec.getRigidAgents();
-    const std::vector<tgBuildSpec::ConnectorAgent*> connectorAgents = m_buildSpec.getConnectorAgents();
+    // Our tags are taken off the searches so that subcomponents 'inherit'
+    // them (because of the way tags work, removing a tag from the search is
+    // the same as adding the tag to children to be searched)
+    tgBuildSpec::Matcher matcher = m_buildSpec.matcher(getTags());
 
     const tgNodes& nodes = m_structure.getNodes();
     const tgPairs& pairs = m_structure.getPairs();
 
     // for each node, create a rigidInfo object using a matching rigidAgent
     for (int i = 0; i < nodes.size(); i++) {
-        tgRigidInfo* nodeRigid = initRigidInfo<tgNode>(nodes[i], rigidAgents);
+        tgRigidInfo* nodeRigid = initRigidInfo<tgNode>(nodes[i], matcher.rigidAgents(nodes[i].getTags()));
         if (nodeRigid) {
             m_rigids.push_back(nodeRigid);
         }
     }
     // for each pair, create a rigidInfo or connectorInfo object using a matching rigidAgent or connectorAgent
     for (int i = 0; i < pairs.size(); i++) {
-        tgRigidInfo* pairRigid = initRigidInfo<tgPair>(pairs[i], rigidAgents);
+        tgRigidInfo* pairRigid = initRigidInfo<tgPair>(pairs[i], matcher.rigidAgents(pairs[i].getTags()));
         if (pairRigid) {
 	  m_rigids.push_back(pairRigid);
         }
         else {
-            tgConnectorInfo* pairConnector = initConnectorInfo<tgPair>(pairs[i], connectorAgents);
+            tgConnectorInfo* pairConnector = initConnectorInfo<tgPair>(pairs[i], matcher.connectorAgents(pairs[i].getTags()));
             if (pairConnector) {
                 m_connectors.push_back(pairConnector);
             }
@@ -157,21 +161,15 @@ void tgStructureInfo::addRigidsAndConnectors() {
 
 template <class T>
 tgRigidInfo* tgStructureInfo::initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents) const {
-    for (int i = rigidAgents.size() - 1; i >= 0; i--) {
+    // The agents' searches already match the candidate
+    for (std::size_t i = 0; i < rigidAgents.size(); i++) {
         const tgBuildSpec::RigidAgent* pRigidAgent = rigidAgents[i];
         assert(pRigidAgent != NULL);
 
-        tgTagSearch tagSearch = tgTagSearch(pRigidAgent->tagSearch);
-
-        // Remove our tags so that subcomponents 'inherit' them (because of the
-        // way tags work, removing a tag from the search is the same as adding
-        // the tag to children to be searched)
-        tagSearch.remove(getTags());
-
         tgRigidInfo* pRigidInfo = pRigidAgent->infoFactory;
         assert(pRigidInfo != NULL);
 
-        tgRigidInfo* rigid = pRigidInfo->createRigidInfo(rigidCandidate, tagSearch);
+        tgRigidInfo* rigid = pRigidInfo->createRigidInfo(rigidCandidate);
         if (rigid) {// check if a tgRigidInfo was found
 	  return rigid;
 	}
@@ -181,21 +179,15 @@ tgRigidInfo* tgStructureInfo::initRigidInfo(const T& rigidCandidate, const std::
 
 template <class T>
 tgConnectorInfo* tgStructureInfo::initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents) const {
-    for (int i = connectorAgents.size() - 1; i >= 0; i--) {
+    // The agents' searches already match the candidate
+    for (std::size_t i = 0; i < connectorAgents.size(); i++) {
         const tgBuildSpec::ConnectorAgent*  pConnectorAgent = connectorAgents[i];
         assert(pConnectorAgent != NULL);
 
-        tgTagSearch tagSearch = tgTagSearch(pConnectorAgent->tagSearch);
-
-        // Remove our tags so that subcomponents 'inherit' them (because of the
-        // way tags work, removing a tag from the search is the same as adding
-        // the tag to children to be searched)
-        tagSearch.remove(getTags());
-
         tgConnectorInfo* pConnectorInfo = pConnectorAgent->infoFactory;
         assert(pConnectorInfo != NULL);
 
-        tgConnectorInfo* connector = pConnectorInfo->createConnectorInfo(connectorCandidate, tagSearch);
+        tgConnectorInfo* connector = pConnectorInfo->createConnectorInfo(connectorCandidate);
         if (connector) // check if a tgConnectorInfo was found
             return connector;
     }
@@ -269,6 +261,18 @@ void tgStructureInfo::initConnectors(tgWorld& world)
     } 
 }
 
+void tgStructureInfo::resolve()
+{
+    if (!m_resolved)
+    {
+        // These take care of things on a global level
+        addRigidsAndConnectors();    
+        autoCompoundRigids();    
+        chooseConnectorRigids();
+        m_resolved = true;
+    }
+}
+
 /**
  * This is the entry point from other classes.
  * The buildInto method starts the building process, and calls
@@ -276,10 +280,7 @@ void tgStructureInfo::initConnectors(tgWorld& world)
  */
 void tgStructureInfo::buildInto(tgModel& model, tgWorld& world) 
 {
-    // These take care of things on a global level
-    addRigidsAndConnectors();    
-    autoCompoundRigids();    
-    chooseConnectorRigids();
+    resolve();
     initRigidBodies(world);
     // Note: Muscle2Ps won't show up yet -- 
     // they need to be part of a model to have rendering...
@@ -52,6 +52,8 @@ class tgStructureInfo : public tgTaggable
 
     friend std::ostream& operator<<(std::ostream& os, const tgStructureInfo& obj);
 
+    friend class tgBlueprint;
+
 public:
 
     tgStructureInfo(tgStructure& structure, tgBuildSpec& buildSpec);
@@ -68,6 +70,11 @@ public:
         return m_connectors;
     }
 
+    // Create the rigid and connector infos, compound the rigids and
+    // attach the connectors to them, unless already done. Neither the
+    // structure nor the build spec is used after this.
+    void resolve();
+
     // Build our info into the provided model
     void buildInto(tgModel& model, tgWorld& world);
 
@@ -79,13 +86,15 @@ private:
     void addRigidsAndConnectors();
 
     /*
-     * Create and return a rigidInfo object using a matching rigidAgent
+     * Create and return a rigidInfo object using the first of the matching
+     * rigidAgents that can build the candidate
      */
     template <class T>
     tgRigidInfo* initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents) const;
 
     /*
-     * Create and return a connectorInfo object using a matching connectorAgent
+     * Create and return a connectorInfo object using the first of the
+     * matching connectorAgents that can build the candidate
      */
     template <class T>
     tgConnectorInfo* initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents) const;
@@ -135,6 +144,9 @@ private:
     std::vector<tgStructureInfo*> m_children;
     
     std::vector<tgRigidInfo*> m_compounded;
+
+    // True once resolve() has run
+    bool m_resolved;
 };
 
 /**
@@ -0,0 +1,87 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGCouplings.cpp
+ * @brief Implementation of class CPGCouplings
+ * $Id$
+ */
+
+#include "CPGCouplings.h"
+
+// The C++ Standard Library
+#include <cmath>
+
+CPGCouplings::CPGCouplings() :
+m_rowStart(1, 0)
+{
+}
+
+void CPGCouplings::add(std::size_t node, std::size_t target,
+					   double weight, double phaseOffset)
+{
+	m_edgeNode.push_back(node);
+	m_edgeTarget.push_back(target);
+	m_edgeWeight.push_back(weight);
+	m_edgePhase.push_back(phaseOffset);
+}
+
+void CPGCouplings::clear()
+{
+	m_edgeNode.clear();
+	m_edgeTarget.clear();
+	m_edgeWeight.clear();
+	m_edgePhase.clear();
+	m_rowStart.assign(1, 0);
+	m_edge.clear();
+	m_target.clear();
+	m_weight.clear();
+	m_cosOffset.clear();
+	m_sinOffset.clear();
+}
+
+void CPGCouplings::prepare(std::size_t nNodes)
+{
+	const std::size_t nEdges = size();
+
+	// Counting sort of the couplings by node, keeping their order
+	m_rowStart.assign(nNodes + 1, 0);
+	for (std::size_t e = 0; e < nEdges; e++)
+	{
+		m_rowStart[m_edgeNode[e] + 1]++;
+	}
+	for (std::size_t i = 0; i < nNodes; i++)
+	{
+		m_rowStart[i + 1] += m_rowStart[i];
+	}
+	std::vector<std::size_t> next(m_rowStart.begin(), m_rowStart.end() - 1);
+	m_edge.resize(nEdges);
+	m_target.resize(nEdges);
+	m_weight.resize(nEdges);
+	m_cosOffset.resize(nEdges);
+	m_sinOffset.resize(nEdges);
+	for (std::size_t e = 0; e < nEdges; e++)
+	{
+		const std::size_t k = next[m_edgeNode[e]]++;
+		m_edge[k] = e;
+		m_target[k] = m_edgeTarget[e];
+		m_weight[k] = m_edgeWeight[e];
+		m_cosOffset[k] = std::cos(m_edgePhase[e]);
+		m_sinOffset[k] = std::sin(m_edgePhase[e]);
+	}
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_COUPLINGS_H
+#define SRC_UTIL_CPG_COUPLINGS_H
+
+/**
+ * @file CPGCouplings.h
+ * @brief Definition of class CPGCouplings
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * The phase couplings of a CPG network, in compressed sparse row form,
+ * shared by the array engines CPGNetwork and CPGNetworkFB. Node i is
+ * pulled towards each node j it is coupled to by
+ * weight * r_j * sin(phi_j - phi_i - offset).
+ */
+class CPGCouplings
+{
+public:
+
+	CPGCouplings();
+
+	/**
+	 * @param[in] node the node affected
+	 * @param[in] target the node it is coupled to
+	 * @param[in] weight the strength of the coupling
+	 * @param[in] phaseOffset the desired phase of target relative to node
+	 */
+	void add(std::size_t node, std::size_t target,
+			 double weight, double phaseOffset);
+
+	void clear();
+
+	/** @return the number of couplings */
+	std::size_t size() const
+	{
+		return m_edgeNode.size();
+	}
+
+	/** The node, target, weight and offset of the eth coupling added */
+	std::size_t node(std::size_t e) const
+	{
+		return m_edgeNode[e];
+	}
+
+	std::size_t target(std::size_t e) const
+	{
+		return m_edgeTarget[e];
+	}
+
+	double weight(std::size_t e) const
+	{
+		return m_edgeWeight[e];
+	}
+
+	double phaseOffset(std::size_t e) const
+	{
+		return m_edgePhase[e];
+	}
+
+	/**
+	 * The rows made by prepare(): the couplings of node i are at
+	 * [rowStart()[i], rowStart()[i + 1]) in row order.
+	 */
+	const std::vector<std::size_t>& rowStart() const
+	{
+		return m_rowStart;
+	}
+
+	/** @return the index, in the order added, of a coupling in row order */
+	std::size_t edgeOfRow(std::size_t k) const
+	{
+		return m_edge[k];
+	}
+
+	/**
+	 * Sort the couplings into rows. Call after the last add() and before
+	 * addPhaseCoupling().
+	 * @param[in] nNodes the number of nodes
+	 */
+	void prepare(std::size_t nNodes);
+
+	/**
+	 * Add each node's coupling terms to out, the sine of each phase
+	 * difference found from the sines and cosines of the phases.
+	 * @param[in] s the sine of each node's phase
+	 * @param[in] c the cosine of each node's phase
+	 * @param[in] r each node's radius
+	 * @param[in,out] out one value per node
+	 */
+	void addPhaseCoupling(const double* s, const double* c, const double* r,
+						  double* out) const
+	{
+		const std::size_t nNodes = m_rowStart.size() - 1;
+		for (std::size_t i = 0; i < nNodes; i++)
+		{
+			double coupling = 0.0;
+			const std::size_t end = m_rowStart[i + 1];
+			for (std::size_t k = m_rowStart[i]; k < end; k++)
+			{
+				const std::size_t j = m_target[k];
+				const double sinDiff = s[j] * c[i] - c[j] * s[i];
+				const double cosDiff = c[j] * c[i] + s[j] * s[i];
+				coupling += m_weight[k] * r[j] *
+					(sinDiff * m_cosOffset[k] - cosDiff * m_sinOffset[k]);
+			}
+			out[i] += coupling;
+		}
+	}
+
+private:
+
+	/** The couplings in the order they were added */
+	std::vector<std::size_t> m_edgeNode;
+	std::vector<std::size_t> m_edgeTarget;
+	std::vector<double> m_edgeWeight;
+	std::vector<double> m_edgePhase;
+
+	/**
+	 * The couplings by row: those of node i are at
+	 * [m_rowStart[i], m_rowStart[i + 1]), in the order they were added.
+	 */
+	std::vector<std::size_t> m_rowStart;
+	std::vector<std::size_t> m_edge;
+	std::vector<std::size_t> m_target;
+	std::vector<double> m_weight;
+	std::vector<double> m_cosOffset;
+	std::vector<double> m_sinOffset;
+};
+
+#endif // SRC_UTIL_CPG_COUPLINGS_H
@@ -34,11 +34,10 @@
 
 
 // The C++ Standard Library
+#include <algorithm>
 #include <assert.h>
 #include <stdexcept>
 
-using namespace boost::numeric::odeint;
-
 typedef std::vector<double > cpgVars_type;
 
 CPGEquations::CPGEquations(int maxSteps) :
@@ -88,6 +87,18 @@ void CPGEquations::defineConnections (	int nodeIndex,
 	}
 }
 
+void CPGEquations::setCoupling(	std::size_t nodeIndex,
+								std::size_t couplingIndex,
+								double newWeight,
+								double newPhaseOffset)
+{
+	if (nodeIndex >= nodeList.size())
+	{
+		throw std::invalid_argument("Node index out of bounds");
+	}
+	nodeList[nodeIndex]->setCoupling(couplingIndex, newWeight, newPhaseOffset);
+}
+
 const double CPGEquations::operator[](const std::size_t i) const
 {
 #ifndef BT_NO_PROFILE 
@@ -242,15 +253,7 @@ void CPGEquations::update(std::vector<double>& descCom, double dt)
 	
 	numSteps = 0;
 	
-	/**
-	 * Read information from nodes into variables that work for ODEInt
-	 */
-	std::vector<double>& xVars = getXVars(); 
-	
-	/**
-	 * Run ODEInt. This will change the data in xVars
-	 */
-	integrate(integrate_function(this, descCom), xVars, 0.0, dt, stepSize, output_function(this));
+	integrate(descCom, dt);
 	
     if (numSteps > m_maxSteps)
     {
@@ -266,6 +269,126 @@ void CPGEquations::update(std::vector<double>& descCom, double dt)
 	   
 }
 
+void CPGEquations::integrate(std::vector<double>& descCom, double dt)
+{
+	assert(descCom.size() >= nodeList.size());
+	syncNetwork();
+	
+	/**
+	 * Read information from nodes into the network's state
+	 */
+	const std::size_t n = nodeList.size();
+	std::vector<double>& x = m_network.state();
+	for (std::size_t i = 0; i != n; i++){
+		x[i] = nodeList[i]->phiValue;
+		x[n + i] = nodeList[i]->rValue;
+		x[2 * n + i] = nodeList[i]->rDotValue;
+	}
+	
+	/**
+	 * Stops early once the evaluations pass m_maxSteps, since update
+	 * gives up on the trial then anyway
+	 */
+	numSteps = m_network.update(n > 0 ? &descCom[0] : NULL, dt, stepSize,
+								m_maxSteps < 0 ? 0 : m_maxSteps);
+	
+	/**
+	 * Push integrated vars back to nodes
+	 */
+	for (std::size_t i = 0; i != n; i++){
+		nodeList[i]->updateNodeValues(x[i], x[n + i], x[2 * n + i]);
+	}
+}
+
+void CPGEquations::integrateWithODEInt(std::vector<double>& descCom, double dt)
+{
+	/**
+	 * Read information from nodes into variables that work for ODEInt
+	 */
+	std::vector<double>& xVars = getXVars(); 
+	
+	/**
+	 * Run ODEInt. This will change the data in xVars
+	 */
+	boost::numeric::odeint::integrate(integrate_function(this, descCom), xVars, 0.0, dt, stepSize, output_function(this));
+}
+
+bool CPGEquations::networkChanged() const
+{
+	if (m_syncedNodes.size() != nodeList.size())
+	{
+		return true;
+	}
+	for (std::size_t i = 0; i != nodeList.size(); i++){
+		if (m_syncedNodes[i] != nodeList[i] ||
+			m_syncedVersions[i] != nodeList[i]->getCouplingVersion())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void CPGEquations::networkSynced()
+{
+	m_syncedNodes.assign(nodeList.begin(), nodeList.end());
+	m_syncedVersions.resize(nodeList.size());
+	for (std::size_t i = 0; i != nodeList.size(); i++){
+		m_syncedVersions[i] = nodeList[i]->getCouplingVersion();
+	}
+}
+
+void CPGEquations::syncNetwork()
+{
+	if (!networkChanged())
+	{
+		return;
+	}
+	
+	m_network.clear();
+	std::vector<double> params(7);
+	for (std::size_t i = 0; i != nodeList.size(); i++){
+		const CPGNode& node = *nodeList[i];
+		params[0] = node.frequencyOffset;
+		params[1] = node.frequencyScale;
+		params[2] = node.radiusOffset;
+		params[3] = node.radiusScale;
+		params[4] = node.rConst;
+		params[5] = node.dMin;
+		params[6] = node.dMax;
+		m_network.addNode(params);
+	}
+	for (std::size_t i = 0; i != nodeList.size(); i++){
+		const CPGNode& node = *nodeList[i];
+		for (std::size_t k = 0; k != node.couplingList.size(); k++){
+			const std::size_t target =
+				std::find(nodeList.begin(), nodeList.end(), node.couplingList[k])
+				- nodeList.begin();
+			assert(target < nodeList.size());
+			m_network.addCoupling(i, target, node.weightList[k], node.phaseList[k]);
+		}
+	}
+	networkSynced();
+}
+
+void CPGEquations::saveState(std::vector<double>& state)
+{
+	// Three values per node, whichever equations the nodes follow
+	const std::vector<double>& xVars = getXVars();
+	state.insert(state.end(), xVars.begin(), xVars.end());
+}
+
+void CPGEquations::restoreState(const std::vector<double>& state, std::size_t& pos)
+{
+	const std::size_t n = 3 * nodeList.size();
+	if (pos + n > state.size())
+	{
+		throw std::invalid_argument("Saved state is too short for CPGEquations");
+	}
+	updateNodeData(std::vector<double>(state.begin() + pos, state.begin() + pos + n));
+	pos += n;
+}
+
 std::string CPGEquations::toString(const std::string& prefix) const
 {
 	std::string p = "  ";
@@ -31,6 +31,7 @@
 #include <sstream>
 
 #include "CPGNode.h"
+#include "CPGNetwork.h"
 
 /**
  * The top level class for interfacing with CPGs. Contains the definition
@@ -53,6 +54,18 @@ class CPGEquations
 				 std::vector<double> newWeights,
 				 std::vector<double> newPhaseOffsets);
 	
+	/**
+	 * Change the weight and phase offset of a coupling made by
+	 * defineConnections
+	 * @param[in] nodeIndex the node the coupling acts on
+	 * @param[in] couplingIndex the coupling's index among that node's
+	 * @throw std::invalid_argument if there is no such node or coupling
+	 */
+	void setCoupling(	std::size_t nodeIndex,
+						std::size_t couplingIndex,
+						double newWeight,
+						double newPhaseOffset);
+	
 	const double operator[](const std::size_t i) const;
 
 	virtual std::vector<double>& getXVars();
@@ -68,6 +81,30 @@ class CPGEquations
 	 */
 	void update(std::vector<double>& descCom, double dt);
 	
+	/**
+	 * Choose between the adaptive integrator (the default) and fixed
+	 * steps of the step size
+	 */
+	virtual void setIntegrationMethod(CPGIntegrator::Method method)
+	{
+		m_network.integrator().setMethod(method);
+	}
+	
+	/**
+	 * Append the integrated values of every node, for a controller's
+	 * tgObserver::onSaveState
+	 * @param[out] state the buffer to append to
+	 */
+	void saveState(std::vector<double>& state);
+	
+	/**
+	 * Read back the values appended by saveState
+	 * @param[in] state the buffer written by saveState
+	 * @param[in,out] pos the read position
+	 * @throw std::invalid_argument if state is too short
+	 */
+	void restoreState(const std::vector<double>& state, std::size_t& pos);
+	
 	std::string toString(const std::string& prefix = "") const;
 	
     void countStep()
@@ -77,6 +114,29 @@ class CPGEquations
     
 protected:
 	
+	/**
+	 * Advance the nodes by dt, counting equation evaluations in numSteps.
+	 * Integrates a CPGNetwork copy of the nodes, without allocating.
+	 * Subclasses whose nodes follow other equations override this.
+	 */
+	virtual void integrate(std::vector<double>& descCom, double dt);
+	
+	/**
+	 * Advance the nodes by dt with boost::odeint, through getXVars,
+	 * updateNodes, getDXVars and updateNodeData. Slow, but works for any
+	 * subclass.
+	 */
+	void integrateWithODEInt(std::vector<double>& descCom, double dt);
+	
+	/**
+	 * @return true if nodeList, or the couplings of any node in it, have
+	 * changed since the last call to networkSynced
+	 */
+	bool networkChanged() const;
+	
+	/** Record nodeList and its couplings as copied into a network */
+	void networkSynced();
+	
 	std::vector<CPGNode*> nodeList;
 	
     std::vector<double> XVars;
@@ -87,6 +147,18 @@ protected:
     int m_maxSteps;
     int numSteps;
     
+private:
+	
+	/** Rebuild m_network if the nodes or their couplings changed. */
+	void syncNetwork();
+	
+	/** The equations of nodeList, in arrays */
+	CPGNetwork m_network;
+	
+	/** nodeList, and each node's coupling version, as last synced */
+	std::vector<const CPGNode*> m_syncedNodes;
+	std::vector<unsigned long> m_syncedVersions;
+    
 };
 
 /**
@@ -28,27 +28,34 @@
 
 #include "core/tgCast.h"
 
-#include "boost/array.hpp"
-#include "boost/numeric/odeint.hpp"
-
 // The Bullet Physics Library
 #include "LinearMath/btQuickprof.h"
 
 // The C++ Standard Library
+#include <algorithm>
 #include <assert.h>
 #include <stdexcept>
 #include <iterator> 
 
-using namespace boost::numeric::odeint;
-
-typedef std::vector<double > cpgVars_type;
-
 CPGEquationsFB::CPGEquationsFB(int maxSteps) :
-CPGEquations(maxSteps)
+CPGEquations(maxSteps),
+m_comGroup(3)
  {}
 CPGEquationsFB::CPGEquationsFB(std::vector<CPGNode*>& newNodeList, int maxSteps) :
-CPGEquations(newNodeList, maxSteps)
+CPGEquations(newNodeList, maxSteps),
+m_comGroup(3)
 {
+	// The only cast: from here on the nodes are known to be feedback nodes
+	for (std::size_t i = 0; i != nodeList.size(); i++){
+		CPGNodeFB* currentNode = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
+		if (currentNode == NULL)
+		{
+			// The caller keeps the nodes; ~CPGEquations must not delete them
+			nodeList.clear();
+			throw std::invalid_argument("CPGEquationsFB needs CPGNodeFB nodes");
+		}
+		m_fbNodes.push_back(currentNode);
+	}
 }
 
 CPGEquationsFB::~CPGEquationsFB()
@@ -61,6 +68,7 @@ int CPGEquationsFB::addNode(std::vector<double>& newParams)
 	int index = nodeList.size();
 	CPGNodeFB* newNode = new CPGNodeFB(index, newParams);
 	nodeList.push_back(newNode);
+	m_fbNodes.push_back(newNode);
 	
 	return index;
 }
@@ -72,8 +80,7 @@ std::vector<double>& CPGEquationsFB::getXVars() {
     XVars.clear();
 	
 	for (int i = 0; i != nodeList.size(); i++){
-		CPGNodeFB* currentNode = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
-        assert(currentNode);
+		CPGNodeFB* currentNode = m_fbNodes[i];
 		XVars.push_back(currentNode->phiValue);
 		XVars.push_back(currentNode->rValue);
 		XVars.push_back(currentNode->omega);
@@ -89,7 +96,7 @@ std::vector<double>& CPGEquationsFB::getDXVars() {
 	DXVars.clear();
 	
 	for (int i = 0; i != nodeList.size(); i++){
-		CPGNodeFB* currentNode = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
+		CPGNodeFB* currentNode = m_fbNodes[i];
 		DXVars.push_back(currentNode->phiDotValue);
 		DXVars.push_back(currentNode->rDotValue);
 		DXVars.push_back(currentNode->omegaDot);
@@ -108,9 +115,8 @@ void CPGEquationsFB::updateNodes(std::vector<double>& descCom)
 	assert(descCom.size() == nodeList.size() * 3);
 	
 	for(int i = 0; i != nodeList.size(); i++){
-		CPGNodeFB* currentNode = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
-		std::vector<double> comGroup(comIt, comIt + 3);
-		currentNode->updateDTs(comGroup);
+		m_comGroup.assign(comIt, comIt + 3);
+		m_fbNodes[i]->updateDTs(m_comGroup);
 		
 		comIt += 3;
 	}
@@ -124,7 +130,66 @@ void CPGEquationsFB::updateNodeData(std::vector<double> newXVals)
 	assert(newXVals.size()==3*nodeList.size());
 	
 	for(int i = 0; i!=nodeList.size(); i++){
-		CPGNodeFB* currentNode = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
+		CPGNodeFB* currentNode = m_fbNodes[i];
 		currentNode->updateNodeValues(newXVals[3*i], newXVals[3*i+1], newXVals[3*i+2]);
 	}
 }
+
+void CPGEquationsFB::integrate(std::vector<double>& descCom, double dt)
+{
+	assert(descCom.size() == nodeList.size() * 3);
+	syncNetwork();
+	
+	/**
+	 * Read information from nodes into the network's state
+	 */
+	const std::size_t n = m_fbNodes.size();
+	std::vector<double>& x = m_network.state();
+	for (std::size_t i = 0; i != n; i++){
+		x[i] = m_fbNodes[i]->phiValue;
+		x[n + i] = m_fbNodes[i]->rValue;
+		x[2 * n + i] = m_fbNodes[i]->omega;
+	}
+	
+	numSteps = m_network.update(n > 0 ? &descCom[0] : NULL, dt, stepSize,
+								m_maxSteps < 0 ? 0 : m_maxSteps);
+	
+	/**
+	 * Push integrated vars back to nodes
+	 */
+	for (std::size_t i = 0; i != n; i++){
+		m_fbNodes[i]->updateNodeValues(x[i], x[n + i], x[2 * n + i]);
+	}
+}
+
+void CPGEquationsFB::syncNetwork()
+{
+	if (!networkChanged())
+	{
+		return;
+	}
+	
+	m_network.clear();
+	std::vector<double> params(11);
+	for (std::size_t i = 0; i != m_fbNodes.size(); i++){
+		const CPGNodeFB& node = *m_fbNodes[i];
+		params[2] = node.radiusOffset;
+		params[4] = node.rConst;
+		params[7] = node.omega;
+		params[8] = node.kFreq;
+		params[9] = node.kAmp;
+		params[10] = node.kPhase;
+		m_network.addNode(params);
+	}
+	for (std::size_t i = 0; i != m_fbNodes.size(); i++){
+		const CPGNodeFB& node = *m_fbNodes[i];
+		for (std::size_t k = 0; k != node.couplingList.size(); k++){
+			const std::size_t target =
+				std::find(nodeList.begin(), nodeList.end(), node.couplingList[k])
+				- nodeList.begin();
+			assert(target < nodeList.size());
+			m_network.addCoupling(i, target, node.weightList[k], node.phaseList[k]);
+		}
+	}
+	networkSynced();
+}
@@ -30,6 +30,7 @@
 #include "util/CPGEquations.h"
 
 #include "CPGNodeFB.h"
+#include "CPGNetworkFB.h"
 
 
 #include <vector>
@@ -47,6 +48,10 @@ class CPGEquationsFB : public CPGEquations
 	
 	CPGEquationsFB(int maxSteps = 200);
 
+	/**
+	 * @throw std::invalid_argument if a node is not a CPGNodeFB. The
+	 * nodes are not deleted then.
+	 */
 	CPGEquationsFB(std::vector<CPGNode*>& newNodeList, int maxSteps = 200);
 	
 	~CPGEquationsFB();
@@ -60,6 +65,37 @@ class CPGEquationsFB : public CPGEquations
 	void updateNodes(std::vector<double>& descCom);
 	
 	void updateNodeData(std::vector<double> newXVals);
+	
+	/** Sets the integrator of the CPGNetworkFB that integrate() steps */
+	void setIntegrationMethod(CPGIntegrator::Method method)
+	{
+		m_network.integrator().setMethod(method);
+	}
+
+protected:
+	
+	/**
+	 * Integrates a CPGNetworkFB copy of the nodes, without allocating.
+	 * descCom holds three feedback values per node.
+	 */
+	void integrate(std::vector<double>& descCom, double dt);
+
+private:
+	
+	/** Rebuild m_network if the nodes or their couplings changed. */
+	void syncNetwork();
+	
+	/**
+	 * nodeList, with the type every node has. Kept so that no function
+	 * casts the nodes.
+	 */
+	std::vector<CPGNodeFB*> m_fbNodes;
+	
+	/** One node's feedback, reused by updateNodes */
+	std::vector<double> m_comGroup;
+	
+	/** The equations of the nodes, in arrays */
+	CPGNetworkFB m_network;
 
 };
 
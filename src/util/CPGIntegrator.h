@@ -0,0 +1,335 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_INTEGRATOR_H
+#define SRC_UTIL_CPG_INTEGRATOR_H
+
+/**
+ * @file CPGIntegrator.h
+ * @brief Definition of class CPGIntegrator
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Integrates an autonomous system of ODEs over a flat array of doubles,
+ * with buffers that are allocated once by resize(), so that integrate()
+ * does not touch the heap.
+ *
+ * The adaptive method is the Dormand-Prince 5(4) pair with the error
+ * control and step size rules of boost::odeint's dense output
+ * runge_kutta_dopri5, which CPGEquations integrated with before, and
+ * stops at the end time the same way odeint's integrate() does. The fixed
+ * step method is the classic fourth order Runge-Kutta.
+ *
+ * A system is any object with
+ * void operator()(const double* x, double* dxdt)
+ * that writes the derivatives of the size() values of x.
+ */
+class CPGIntegrator
+{
+public:
+
+	enum Method
+	{
+		/** Adaptive Dormand-Prince 5(4), the default */
+		eDormandPrince,
+		/** Fourth order Runge-Kutta with a fixed step */
+		eRungeKutta4
+	};
+
+	/**
+	 * @param[in] method the integration method
+	 * @param[in] absTolerance the absolute error tolerance of adaptive
+	 * steps
+	 * @param[in] relTolerance the relative error tolerance of adaptive
+	 * steps
+	 */
+	CPGIntegrator(Method method = eDormandPrince,
+				  double absTolerance = 1.0e-6,
+				  double relTolerance = 1.0e-6) :
+	m_method(method),
+	m_absTolerance(absTolerance),
+	m_relTolerance(relTolerance),
+	m_size(0)
+	{
+	}
+
+	/**
+	 * Allocate the buffers for systems of n values.
+	 */
+	void resize(std::size_t n)
+	{
+		m_size = n;
+		for (std::size_t i = 0; i < eNumBuffers; i++)
+		{
+			m_buffer[i].resize(n);
+		}
+	}
+
+	/** @return the number of values integrate() expects */
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+	Method method() const
+	{
+		return m_method;
+	}
+
+	void setMethod(Method method)
+	{
+		m_method = method;
+	}
+
+	/**
+	 * Advance x by duration.
+	 * @param[in] system the derivatives of the system
+	 * @param[in,out] x size() values
+	 * @param[in] duration the time to advance; must be positive
+	 * @param[in] dt the fixed step, or the first adaptive step
+	 * @param[in] maxEvaluations give up once the system has been
+	 * evaluated more often than this, leaving x where the integration had
+	 * got to
+	 * @return the number of times the system was evaluated
+	 * @throw std::runtime_error if an adaptive step keeps failing
+	 */
+	template <typename System>
+	std::size_t integrate(System& system, double* x, double duration,
+						  double dt, std::size_t maxEvaluations)
+	{
+		if (m_method == eRungeKutta4)
+		{
+			return integrateRK4(system, x, duration, dt, maxEvaluations);
+		}
+		return integrateDopri5(system, x, duration, dt, maxEvaluations);
+	}
+
+private:
+
+	enum Buffer
+	{
+		eK1, eK2, eK3, eK4, eK5, eK6, eK7,
+		eXTemp, eXNew, eNumBuffers
+	};
+
+	/** x + dt * sum of coefficients times stages, into eXTemp */
+	void stage(const double* x, double dt,
+			   double a1, double a2 = 0.0, double a3 = 0.0,
+			   double a4 = 0.0, double a5 = 0.0)
+	{
+		const double* const k1 = &m_buffer[eK1][0];
+		const double* const k2 = &m_buffer[eK2][0];
+		const double* const k3 = &m_buffer[eK3][0];
+		const double* const k4 = &m_buffer[eK4][0];
+		const double* const k5 = &m_buffer[eK5][0];
+		double* const out = &m_buffer[eXTemp][0];
+		for (std::size_t i = 0; i < m_size; i++)
+		{
+			out[i] = x[i] + dt * (a1 * k1[i] + a2 * k2[i] + a3 * k3[i]
+								  + a4 * k4[i] + a5 * k5[i]);
+		}
+	}
+
+	/**
+	 * One Dormand-Prince step from x, whose derivatives are in eK1.
+	 * Leaves the new state in eXNew and its derivatives in eK7.
+	 * @return the error relative to the tolerances; the step is good if
+	 * it is at most 1
+	 */
+	template <typename System>
+	double stepDopri5(System& system, const double* x, double dt)
+	{
+		static const double a21 = 1.0 / 5.0;
+		static const double a31 = 3.0 / 40.0;
+		static const double a32 = 9.0 / 40.0;
+		static const double a41 = 44.0 / 45.0;
+		static const double a42 = -56.0 / 15.0;
+		static const double a43 = 32.0 / 9.0;
+		static const double a51 = 19372.0 / 6561.0;
+		static const double a52 = -25360.0 / 2187.0;
+		static const double a53 = 64448.0 / 6561.0;
+		static const double a54 = -212.0 / 729.0;
+		static const double a61 = 9017.0 / 3168.0;
+		static const double a62 = -355.0 / 33.0;
+		static const double a63 = 46732.0 / 5247.0;
+		static const double a64 = 49.0 / 176.0;
+		static const double a65 = -5103.0 / 18656.0;
+		static const double b1 = 35.0 / 384.0;
+		static const double b3 = 500.0 / 1113.0;
+		static const double b4 = 125.0 / 192.0;
+		static const double b5 = -2187.0 / 6784.0;
+		static const double b6 = 11.0 / 84.0;
+		// Differences between the fifth and fourth order weights
+		static const double e1 = b1 - 5179.0 / 57600.0;
+		static const double e3 = b3 - 7571.0 / 16695.0;
+		static const double e4 = b4 - 393.0 / 640.0;
+		static const double e5 = b5 + 92097.0 / 339200.0;
+		static const double e6 = b6 - 187.0 / 2100.0;
+		static const double e7 = -1.0 / 40.0;
+
+		const double* const xTemp = &m_buffer[eXTemp][0];
+		stage(x, dt, a21);
+		system(xTemp, &m_buffer[eK2][0]);
+		stage(x, dt, a31, a32);
+		system(xTemp, &m_buffer[eK3][0]);
+		stage(x, dt, a41, a42, a43);
+		system(xTemp, &m_buffer[eK4][0]);
+		stage(x, dt, a51, a52, a53, a54);
+		system(xTemp, &m_buffer[eK5][0]);
+
+		const double* const k1 = &m_buffer[eK1][0];
+		const double* const k2 = &m_buffer[eK2][0];
+		const double* const k3 = &m_buffer[eK3][0];
+		const double* const k4 = &m_buffer[eK4][0];
+		const double* const k5 = &m_buffer[eK5][0];
+		double* const k6 = &m_buffer[eK6][0];
+		double* const k7 = &m_buffer[eK7][0];
+		double* const xNew = &m_buffer[eXNew][0];
+		double* const xStage = &m_buffer[eXTemp][0];
+		for (std::size_t i = 0; i < m_size; i++)
+		{
+			xStage[i] = x[i] + dt * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i]
+									 + a64 * k4[i] + a65 * k5[i]);
+		}
+		system(xStage, k6);
+		for (std::size_t i = 0; i < m_size; i++)
+		{
+			xNew[i] = x[i] + dt * (b1 * k1[i] + b3 * k3[i] + b4 * k4[i]
+								   + b5 * k5[i] + b6 * k6[i]);
+		}
+		// First same as last: k7 is the derivative at the new state
+		system(xNew, k7);
+
+		double maxError = 0.0;
+		for (std::size_t i = 0; i < m_size; i++)
+		{
+			const double error = dt * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i]
+									   + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+			const double scale = m_absTolerance + m_relTolerance *
+				(std::fabs(x[i]) + std::fabs(dt) * std::fabs(k1[i]));
+			maxError = std::max(maxError, std::fabs(error) / scale);
+		}
+		return maxError;
+	}
+
+	template <typename System>
+	std::size_t integrateDopri5(System& system, double* x, double duration,
+								double dt, std::size_t maxEvaluations)
+	{
+		static const double epsilon = 2.2204460492503131e-16;
+		static const std::size_t maxFailedSteps = 500;
+
+		double t = 0.0;
+		std::size_t evaluations = 0;
+		bool haveDerivatives = false;
+		while (duration - t > epsilon && evaluations <= maxEvaluations)
+		{
+			// Steps that would not pass the end time
+			while (t + dt - duration <= epsilon &&
+				   evaluations <= maxEvaluations)
+			{
+				if (!haveDerivatives)
+				{
+					system(x, &m_buffer[eK1][0]);
+					evaluations++;
+					haveDerivatives = true;
+				}
+				std::size_t failedSteps = 0;
+				for (;;)
+				{
+					const double error = stepDopri5(system, x, dt);
+					evaluations += 6;
+					if (error > 1.0)
+					{
+						dt *= std::max(0.9 * std::pow(error, -1.0 / 3.0), 0.2);
+						if (++failedSteps == maxFailedSteps)
+						{
+							throw std::runtime_error("CPG step size control failed");
+						}
+						continue;
+					}
+					t += dt;
+					if (error < 0.5)
+					{
+						// Grow by at most a factor of 4.5
+						dt *= 0.9 * std::pow(std::max(error, 1.0 / 3125.0),
+											 -1.0 / 5.0);
+					}
+					break;
+				}
+				std::copy(m_buffer[eXNew].begin(), m_buffer[eXNew].end(), x);
+				m_buffer[eK1].swap(m_buffer[eK7]);
+			}
+			// Arrive exactly at the end time; like odeint, start the last
+			// step afresh
+			dt = duration - t;
+			haveDerivatives = false;
+		}
+		return evaluations;
+	}
+
+	template <typename System>
+	std::size_t integrateRK4(System& system, double* x, double duration,
+							 double dt, std::size_t maxEvaluations)
+	{
+		const std::size_t steps =
+			std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(duration / dt - 1.0e-9)));
+		const double h = duration / steps;
+
+		const double* const k1 = &m_buffer[eK1][0];
+		const double* const k2 = &m_buffer[eK2][0];
+		const double* const k3 = &m_buffer[eK3][0];
+		const double* const k4 = &m_buffer[eK4][0];
+		std::size_t evaluations = 0;
+		for (std::size_t s = 0; s < steps && evaluations <= maxEvaluations; s++)
+		{
+			system(x, &m_buffer[eK1][0]);
+			stage(x, h, 0.5);
+			system(&m_buffer[eXTemp][0], &m_buffer[eK2][0]);
+			stage(x, h, 0.0, 0.5);
+			system(&m_buffer[eXTemp][0], &m_buffer[eK3][0]);
+			stage(x, h, 0.0, 0.0, 1.0);
+			system(&m_buffer[eXTemp][0], &m_buffer[eK4][0]);
+			for (std::size_t i = 0; i < m_size; i++)
+			{
+				x[i] += h / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+			}
+			evaluations += 4;
+		}
+		return evaluations;
+	}
+
+private:
+
+	Method m_method;
+	double m_absTolerance;
+	double m_relTolerance;
+	std::size_t m_size;
+
+	std::vector<double> m_buffer[eNumBuffers];
+};
+
+#endif // SRC_UTIL_CPG_INTEGRATOR_H
@@ -0,0 +1,172 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGNetwork.cpp
+ * @brief Implementation of class CPGNetwork
+ * $Id$
+ */
+
+#include "CPGNetwork.h"
+#include "CPGSinCos.h"
+
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	/** The same as CPGNode::nodeEquation */
+	double nodeEquation(double d, double c0, double c1, double dMin, double dMax)
+	{
+		if (d >= dMin && d <= dMax)
+		{
+			return c1 * d + c0;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+}
+
+CPGNetwork::CPGNetwork() :
+m_prepared(false)
+{
+}
+
+std::size_t CPGNetwork::addNode(const std::vector<double>& params)
+{
+	if (params.size() < 7)
+	{
+		throw std::invalid_argument("A CPG node needs 7 parameters");
+	}
+	m_frequencyOffset.push_back(params[0]);
+	m_frequencyScale.push_back(params[1]);
+	m_radiusOffset.push_back(params[2]);
+	m_radiusScale.push_back(params[3]);
+	m_rConst.push_back(params[4]);
+	m_dMin.push_back(params[5]);
+	m_dMax.push_back(params[6]);
+	// Nodes start at rest, as CPGNodes do
+	const std::size_t n = size();
+	m_state.insert(m_state.begin() + 2 * (n - 1), 0.0);
+	m_state.insert(m_state.begin() + (n - 1), 0.0);
+	m_state.push_back(0.0);
+	m_prepared = false;
+	return n - 1;
+}
+
+void CPGNetwork::addCoupling(std::size_t node, std::size_t target,
+							 double weight, double phaseOffset)
+{
+	if (node >= size() || target >= size())
+	{
+		throw std::invalid_argument("Coupling of a node that does not exist");
+	}
+	m_couplings.add(node, target, weight, phaseOffset);
+	m_prepared = false;
+}
+
+void CPGNetwork::clear()
+{
+	m_frequencyOffset.clear();
+	m_frequencyScale.clear();
+	m_radiusOffset.clear();
+	m_radiusScale.clear();
+	m_rConst.clear();
+	m_dMin.clear();
+	m_dMax.clear();
+	m_couplings.clear();
+	m_state.clear();
+	m_prepared = false;
+}
+
+void CPGNetwork::prepare()
+{
+	const std::size_t n = size();
+	m_couplings.prepare(n);
+
+	m_omega.resize(n);
+	m_radiusTarget.resize(n);
+	m_sin.resize(n);
+	m_cos.resize(n);
+	m_integrator.resize(3 * n);
+	m_prepared = true;
+}
+
+double CPGNetwork::nodeValue(std::size_t i) const
+{
+	return radius(i) * std::cos(phase(i));
+}
+
+void CPGNetwork::setCommands(const double* descCom)
+{
+	if (!m_prepared)
+	{
+		prepare();
+	}
+	const std::size_t n = size();
+	for (std::size_t i = 0; i < n; i++)
+	{
+		m_omega[i] = 2 * M_PI * nodeEquation(descCom[i], m_frequencyOffset[i],
+											 m_frequencyScale[i],
+											 m_dMin[i], m_dMax[i]);
+		m_radiusTarget[i] = nodeEquation(descCom[i], m_radiusOffset[i],
+										 m_radiusScale[i],
+										 m_dMin[i], m_dMax[i]);
+	}
+}
+
+void CPGNetwork::operator()(const double* x, double* dxdt)
+{
+	assert(m_prepared);
+	const std::size_t n = size();
+	const double* const phi = x;
+	const double* const r = x + n;
+	const double* const rDot = x + 2 * n;
+	double* const phiDot = dxdt;
+	double* const rDotOut = dxdt + n;
+	double* const rDoubleDot = dxdt + 2 * n;
+
+	double* const s = &m_sin[0];
+	double* const c = &m_cos[0];
+	CPGSinCos(phi, s, c, n);
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		phiDot[i] = m_omega[i];
+		rDotOut[i] = rDot[i];
+		rDoubleDot[i] = m_rConst[i] * (m_rConst[i] / 4 *
+			(m_radiusTarget[i] - r[i]) - rDot[i]);
+	}
+	m_couplings.addPhaseCoupling(s, c, r, phiDot);
+}
+
+std::size_t CPGNetwork::update(const double* descCom, double duration,
+							   double stepSize, std::size_t maxEvaluations)
+{
+	if (size() == 0)
+	{
+		return 0;
+	}
+	setCommands(descCom);
+	return m_integrator.integrate(*this, &m_state[0], duration, stepSize,
+								  maxEvaluations);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_NETWORK_H
+#define SRC_UTIL_CPG_NETWORK_H
+
+/**
+ * @file CPGNetwork.h
+ * @brief Definition of class CPGNetwork
+ * $Id$
+ */
+
+#include "CPGCouplings.h"
+#include "CPGIntegrator.h"
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * The equations of a network of CPGNodes, stored as arrays rather than
+ * as linked node objects: one array per node parameter, the couplings in
+ * compressed sparse row form, and the state as one block of phases, one
+ * of radii and one of radius velocities. CPGEquations is an adapter
+ * around this class.
+ *
+ * Evaluating the derivatives does not allocate. The sine of each phase
+ * difference is found from the sines and cosines of the phases, which
+ * CPGSinCos computes once per node in a loop the compiler can vectorize,
+ * so there are no library calls per node or per coupling.
+ */
+class CPGNetwork
+{
+	friend class CPGNetworkBatch;
+
+public:
+
+	CPGNetwork();
+
+	/**
+	 * Add a node with the parameters of a CPGNode.
+	 * @param[in] params at least 7 values: frequency offset and scale,
+	 * radius offset and scale, rConst, dMin and dMax
+	 * @return the node's index
+	 * @throw std::invalid_argument if there are too few parameters
+	 */
+	std::size_t addNode(const std::vector<double>& params);
+
+	/**
+	 * Make a node's phase follow another's.
+	 * @param[in] node the node affected
+	 * @param[in] target the node it is coupled to
+	 * @param[in] weight the strength of the coupling
+	 * @param[in] phaseOffset the desired phase of target relative to node
+	 * @throw std::invalid_argument if either index is out of range
+	 */
+	void addCoupling(std::size_t node, std::size_t target,
+					 double weight, double phaseOffset);
+
+	/** Remove every node and coupling. */
+	void clear();
+
+	std::size_t size() const
+	{
+		return m_rConst.size();
+	}
+
+	std::size_t couplingCount() const
+	{
+		return m_couplings.size();
+	}
+
+	/**
+	 * The state: size() phases, then size() radii, then size() radius
+	 * velocities.
+	 */
+	std::vector<double>& state()
+	{
+		return m_state;
+	}
+
+	const std::vector<double>& state() const
+	{
+		return m_state;
+	}
+
+	double phase(std::size_t i) const
+	{
+		return m_state[i];
+	}
+
+	double radius(std::size_t i) const
+	{
+		return m_state[size() + i];
+	}
+
+	double radiusVelocity(std::size_t i) const
+	{
+		return m_state[2 * size() + i];
+	}
+
+	/** @return the node's output, radius times the cosine of its phase */
+	double nodeValue(std::size_t i) const;
+
+	/**
+	 * Advance the network with constant descending commands.
+	 * @param[in] descCom one command per node
+	 * @param[in] duration the time to advance
+	 * @param[in] stepSize the first adaptive step, or the fixed step
+	 * @param[in] maxEvaluations stop once the equations have been
+	 * evaluated more often than this
+	 * @return the number of evaluations
+	 */
+	std::size_t update(const double* descCom, double duration,
+					   double stepSize, std::size_t maxEvaluations);
+
+	/**
+	 * Set the commands operator() uses, and the node equation terms that
+	 * depend only on them.
+	 * @param[in] descCom one command per node
+	 */
+	void setCommands(const double* descCom);
+
+	/**
+	 * The derivatives of a state under the commands of setCommands().
+	 * @param[in] x a state, laid out as state()
+	 * @param[out] dxdt its derivatives, laid out the same way
+	 */
+	void operator()(const double* x, double* dxdt);
+
+	CPGIntegrator& integrator()
+	{
+		return m_integrator;
+	}
+
+private:
+
+	/** Sort the couplings into rows, and size the buffers. */
+	void prepare();
+
+	/** The parameters of each node */
+	std::vector<double> m_frequencyOffset;
+	std::vector<double> m_frequencyScale;
+	std::vector<double> m_radiusOffset;
+	std::vector<double> m_radiusScale;
+	std::vector<double> m_rConst;
+	std::vector<double> m_dMin;
+	std::vector<double> m_dMax;
+
+	CPGCouplings m_couplings;
+
+	/** False when nodes or couplings were added since prepare() */
+	bool m_prepared;
+
+	/** The phase velocity and radius each node is driven towards */
+	std::vector<double> m_omega;
+	std::vector<double> m_radiusTarget;
+
+	/** The sines and cosines of the phases being evaluated */
+	std::vector<double> m_sin;
+	std::vector<double> m_cos;
+
+	std::vector<double> m_state;
+
+	CPGIntegrator m_integrator;
+};
+
+#endif // SRC_UTIL_CPG_NETWORK_H
@@ -0,0 +1,200 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGNetworkBatch.cpp
+ * @brief Implementation of class CPGNetworkBatch
+ * $Id$
+ */
+
+#include "CPGNetworkBatch.h"
+#include "CPGNetwork.h"
+#include "CPGSinCos.h"
+
+// The C++ Standard Library
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+CPGNetworkBatch::CPGNetworkBatch(const CPGNetwork& prototype,
+								 std::size_t members) :
+m_members(members),
+m_nodes(prototype.size()),
+m_couplings(prototype.m_couplings),
+m_integrator(CPGIntegrator::eRungeKutta4)
+{
+	if (members == 0)
+	{
+		throw std::invalid_argument("A CPG batch needs at least one member");
+	}
+	m_couplings.prepare(m_nodes);
+
+	const std::size_t nodeSlots = m_nodes * m_members;
+	const std::size_t couplingSlots = m_couplings.size() * m_members;
+	m_frequencyOffset.resize(nodeSlots);
+	m_frequencyScale.resize(nodeSlots);
+	m_radiusOffset.resize(nodeSlots);
+	m_radiusScale.resize(nodeSlots);
+	m_rConst.resize(nodeSlots);
+	m_dMin.resize(nodeSlots);
+	m_dMax.resize(nodeSlots);
+	m_weight.resize(couplingSlots);
+	m_cosOffset.resize(couplingSlots);
+	m_sinOffset.resize(couplingSlots);
+	m_omega.resize(nodeSlots);
+	m_radiusTarget.resize(nodeSlots);
+	m_sin.resize(nodeSlots);
+	m_cos.resize(nodeSlots);
+	m_state.resize(3 * nodeSlots);
+	m_integrator.resize(3 * nodeSlots);
+
+	for (std::size_t k = 0; k < m_members; k++)
+	{
+		load(k, prototype);
+	}
+}
+
+void CPGNetworkBatch::setMember(std::size_t member, const CPGNetwork& network)
+{
+	if (member >= m_members)
+	{
+		throw std::invalid_argument("No such member in the CPG batch");
+	}
+	bool same = network.size() == m_nodes &&
+		network.m_couplings.size() == m_couplings.size();
+	for (std::size_t e = 0; same && e < m_couplings.size(); e++)
+	{
+		same = network.m_couplings.node(e) == m_couplings.node(e) &&
+			network.m_couplings.target(e) == m_couplings.target(e);
+	}
+	if (!same)
+	{
+		throw std::invalid_argument("CPG batch members must share one topology");
+	}
+	load(member, network);
+}
+
+void CPGNetworkBatch::load(std::size_t member, const CPGNetwork& network)
+{
+	for (std::size_t i = 0; i < m_nodes; i++)
+	{
+		const std::size_t slot = i * m_members + member;
+		m_frequencyOffset[slot] = network.m_frequencyOffset[i];
+		m_frequencyScale[slot] = network.m_frequencyScale[i];
+		m_radiusOffset[slot] = network.m_radiusOffset[i];
+		m_radiusScale[slot] = network.m_radiusScale[i];
+		m_rConst[slot] = network.m_rConst[i];
+		m_dMin[slot] = network.m_dMin[i];
+		m_dMax[slot] = network.m_dMax[i];
+		for (std::size_t v = 0; v < 3; v++)
+		{
+			m_state[(v * m_nodes + i) * m_members + member] =
+				network.m_state[v * m_nodes + i];
+		}
+	}
+	for (std::size_t k = 0; k < m_couplings.size(); k++)
+	{
+		const std::size_t e = m_couplings.edgeOfRow(k);
+		const std::size_t slot = k * m_members + member;
+		m_weight[slot] = network.m_couplings.weight(e);
+		m_cosOffset[slot] = std::cos(network.m_couplings.phaseOffset(e));
+		m_sinOffset[slot] = std::sin(network.m_couplings.phaseOffset(e));
+	}
+}
+
+double CPGNetworkBatch::nodeValue(std::size_t member, std::size_t node) const
+{
+	return radius(member, node) * std::cos(phase(member, node));
+}
+
+std::size_t CPGNetworkBatch::update(const double* descCom, double duration,
+									double stepSize)
+{
+	if (m_nodes == 0)
+	{
+		return 0;
+	}
+	// The same node equation as CPGNode::nodeEquation
+	const std::size_t nodeSlots = m_nodes * m_members;
+	for (std::size_t slot = 0; slot < nodeSlots; slot++)
+	{
+		const double d = descCom[slot];
+		const bool inRange = d >= m_dMin[slot] && d <= m_dMax[slot];
+		m_omega[slot] = inRange ?
+			2 * M_PI * (m_frequencyScale[slot] * d + m_frequencyOffset[slot]) :
+			0.0;
+		m_radiusTarget[slot] = inRange ?
+			m_radiusScale[slot] * d + m_radiusOffset[slot] : 0.0;
+	}
+	return m_integrator.integrate(*this, &m_state[0], duration, stepSize,
+								  std::numeric_limits<std::size_t>::max());
+}
+
+void CPGNetworkBatch::operator()(const double* x, double* dxdt)
+{
+	const std::size_t K = m_members;
+	const std::size_t nodeSlots = m_nodes * K;
+	const double* const phi = x;
+	const double* const r = x + nodeSlots;
+	const double* const rDot = x + 2 * nodeSlots;
+	double* const phiDot = dxdt;
+	double* const rDotOut = dxdt + nodeSlots;
+	double* const rDoubleDot = dxdt + 2 * nodeSlots;
+
+	double* const s = &m_sin[0];
+	double* const c = &m_cos[0];
+	CPGSinCos(phi, s, c, nodeSlots);
+
+	for (std::size_t slot = 0; slot < nodeSlots; slot++)
+	{
+		phiDot[slot] = 0.0;
+		rDotOut[slot] = rDot[slot];
+		rDoubleDot[slot] = m_rConst[slot] * (m_rConst[slot] / 4 *
+			(m_radiusTarget[slot] - r[slot]) - rDot[slot]);
+	}
+
+	// The same sums as CPGCouplings::addPhaseCoupling, member by member
+	const std::vector<std::size_t>& rowStart = m_couplings.rowStart();
+	for (std::size_t i = 0; i < m_nodes; i++)
+	{
+		const double* const si = s + i * K;
+		const double* const ci = c + i * K;
+		double* const out = phiDot + i * K;
+		for (std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+		{
+			const std::size_t j = m_couplings.target(m_couplings.edgeOfRow(k));
+			const double* const sj = s + j * K;
+			const double* const cj = c + j * K;
+			const double* const rj = r + j * K;
+			const double* const w = &m_weight[k * K];
+			const double* const co = &m_cosOffset[k * K];
+			const double* const so = &m_sinOffset[k * K];
+			for (std::size_t m = 0; m < K; m++)
+			{
+				const double sinDiff = sj[m] * ci[m] - cj[m] * si[m];
+				const double cosDiff = cj[m] * ci[m] + sj[m] * si[m];
+				out[m] += w[m] * rj[m] * (sinDiff * co[m] - cosDiff * so[m]);
+			}
+		}
+	}
+	// Added last, so each member's sums round as they do alone
+	for (std::size_t slot = 0; slot < nodeSlots; slot++)
+	{
+		phiDot[slot] = m_omega[slot] + phiDot[slot];
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_NETWORK_BATCH_H
+#define SRC_UTIL_CPG_NETWORK_BATCH_H
+
+/**
+ * @file CPGNetworkBatch.h
+ * @brief Definition of class CPGNetworkBatch
+ * $Id$
+ */
+
+#include "CPGCouplings.h"
+#include "CPGIntegrator.h"
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class CPGNetwork;
+
+/**
+ * Advances a population of CPGNetworks that share one topology (the
+ * same nodes and the same couplings, added in the same order) but have
+ * their own parameters, such as the nodeVals and edgeVals of each
+ * candidate controller in a learning run, in lockstep.
+ *
+ * Every array is laid out [node][member], so the equations of all members
+ * are evaluated by the same loops, whose innermost runs over the members
+ * and vectorizes. The state is one block of phases, one of radii and one
+ * of radius velocities, each [node][member].
+ *
+ * Integrates with fixed RK4 steps by default, so that each member
+ * follows the trajectory it would alone. With the adaptive method, the
+ * members share the steps their worst member needs.
+ */
+class CPGNetworkBatch
+{
+public:
+
+	/**
+	 * @param[in] prototype the topology, and the parameters and state of
+	 * every member until setMember() is called
+	 * @param[in] members the number of networks; must be positive
+	 * @throw std::invalid_argument if members is zero
+	 */
+	CPGNetworkBatch(const CPGNetwork& prototype, std::size_t members);
+
+	/**
+	 * Replace one member's parameters and state with a network's.
+	 * @param[in] member less than members()
+	 * @param[in] network a network with the prototype's topology
+	 * @throw std::invalid_argument if the topology differs, or there is
+	 * no such member
+	 */
+	void setMember(std::size_t member, const CPGNetwork& network);
+
+	std::size_t members() const
+	{
+		return m_members;
+	}
+
+	std::size_t nodes() const
+	{
+		return m_nodes;
+	}
+
+	/** @return the node's output, radius times the cosine of its phase */
+	double nodeValue(std::size_t member, std::size_t node) const;
+
+	double phase(std::size_t member, std::size_t node) const
+	{
+		return m_state[node * m_members + member];
+	}
+
+	double radius(std::size_t member, std::size_t node) const
+	{
+		return m_state[(m_nodes + node) * m_members + member];
+	}
+
+	/**
+	 * Advance every member with constant descending commands.
+	 * @param[in] descCom the commands, [node][member]
+	 * @param[in] duration the time to advance
+	 * @param[in] stepSize the fixed step, or the first adaptive step
+	 * @return the number of evaluations of the whole batch
+	 */
+	std::size_t update(const double* descCom, double duration,
+					   double stepSize);
+
+	/**
+	 * The derivatives of a state of every member, under the commands of
+	 * the current update().
+	 */
+	void operator()(const double* x, double* dxdt);
+
+	CPGIntegrator& integrator()
+	{
+		return m_integrator;
+	}
+
+private:
+
+	/** Copy a network's parameters and state into one member's slots */
+	void load(std::size_t member, const CPGNetwork& network);
+
+	const std::size_t m_members;
+	const std::size_t m_nodes;
+
+	/** The prototype's couplings, for their rows and targets */
+	CPGCouplings m_couplings;
+
+	/** Node parameters, [node][member] */
+	std::vector<double> m_frequencyOffset;
+	std::vector<double> m_frequencyScale;
+	std::vector<double> m_radiusOffset;
+	std::vector<double> m_radiusScale;
+	std::vector<double> m_rConst;
+	std::vector<double> m_dMin;
+	std::vector<double> m_dMax;
+
+	/** Coupling parameters, [coupling in row order][member] */
+	std::vector<double> m_weight;
+	std::vector<double> m_cosOffset;
+	std::vector<double> m_sinOffset;
+
+	/** The node equation terms of the current commands, [node][member] */
+	std::vector<double> m_omega;
+	std::vector<double> m_radiusTarget;
+
+	/** The sines and cosines of the phases being evaluated */
+	std::vector<double> m_sin;
+	std::vector<double> m_cos;
+
+	std::vector<double> m_state;
+
+	CPGIntegrator m_integrator;
+};
+
+#endif // SRC_UTIL_CPG_NETWORK_BATCH_H
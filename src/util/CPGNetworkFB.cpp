@@ -0,0 +1,135 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGNetworkFB.cpp
+ * @brief Implementation of class CPGNetworkFB
+ * $Id$
+ */
+
+#include "CPGNetworkFB.h"
+#include "CPGSinCos.h"
+
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+CPGNetworkFB::CPGNetworkFB() :
+m_prepared(false),
+m_feedback(NULL)
+{
+}
+
+std::size_t CPGNetworkFB::addNode(const std::vector<double>& params)
+{
+	if (params.size() < 11)
+	{
+		throw std::invalid_argument("A feedback CPG node needs 11 parameters");
+	}
+	m_rConst.push_back(params[4]);
+	m_radiusOffset.push_back(params[2]);
+	m_kFreq.push_back(params[8]);
+	m_kAmp.push_back(params[9]);
+	m_kPhase.push_back(params[10]);
+	// The initial state of a CPGNodeFB
+	const std::size_t n = size();
+	m_state.insert(m_state.begin() + 2 * (n - 1), std::sqrt(params[2]));
+	m_state.insert(m_state.begin() + (n - 1), 0.0);
+	m_state.push_back(params[7]);
+	m_prepared = false;
+	return n - 1;
+}
+
+void CPGNetworkFB::addCoupling(std::size_t node, std::size_t target,
+							   double weight, double phaseOffset)
+{
+	if (node >= size() || target >= size())
+	{
+		throw std::invalid_argument("Coupling of a node that does not exist");
+	}
+	m_couplings.add(node, target, weight, phaseOffset);
+	m_prepared = false;
+}
+
+void CPGNetworkFB::clear()
+{
+	m_rConst.clear();
+	m_radiusOffset.clear();
+	m_kFreq.clear();
+	m_kAmp.clear();
+	m_kPhase.clear();
+	m_couplings.clear();
+	m_state.clear();
+	m_prepared = false;
+}
+
+void CPGNetworkFB::prepare()
+{
+	const std::size_t n = size();
+	m_couplings.prepare(n);
+	m_sin.resize(n);
+	m_cos.resize(n);
+	m_integrator.resize(3 * n);
+	m_prepared = true;
+}
+
+void CPGNetworkFB::operator()(const double* x, double* dxdt)
+{
+	assert(m_prepared && m_feedback != NULL);
+	const std::size_t n = size();
+	const double* const phi = x;
+	const double* const r = x + n;
+	const double* const omega = x + 2 * n;
+	double* const phiDot = dxdt;
+	double* const rDot = dxdt + n;
+	double* const omegaDot = dxdt + 2 * n;
+
+	double* const s = &m_sin[0];
+	double* const c = &m_cos[0];
+	CPGSinCos(phi, s, c, n);
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const double* const feedback = m_feedback + 3 * i;
+		phiDot[i] = omega[i] + m_kPhase[i] * feedback[2];
+		omegaDot[i] = m_kFreq[i] * feedback[0] * s[i];
+		rDot[i] = m_rConst[i] * (m_radiusOffset[i] + m_kAmp[i] * feedback[1]
+								 - r[i] * r[i]) * r[i];
+	}
+	m_couplings.addPhaseCoupling(s, c, r, phiDot);
+}
+
+std::size_t CPGNetworkFB::update(const double* feedback, double duration,
+								 double stepSize, std::size_t maxEvaluations)
+{
+	if (size() == 0)
+	{
+		return 0;
+	}
+	if (!m_prepared)
+	{
+		prepare();
+	}
+	m_feedback = feedback;
+	const std::size_t evaluations =
+		m_integrator.integrate(*this, &m_state[0], duration, stepSize,
+							   maxEvaluations);
+	m_feedback = NULL;
+	return evaluations;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_NETWORK_FB_H
+#define SRC_UTIL_CPG_NETWORK_FB_H
+
+/**
+ * @file CPGNetworkFB.h
+ * @brief Definition of class CPGNetworkFB
+ * $Id$
+ */
+
+#include "CPGCouplings.h"
+#include "CPGIntegrator.h"
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * The equations of a network of CPGNodeFBs, stored as arrays like
+ * CPGNetwork: one array per node parameter, the couplings in a
+ * CPGCouplings, and the state as one block of phases, one of radii and
+ * one of frequencies. CPGEquationsFB is an adapter around this class.
+ *
+ * The feedback of node i is read in place from the commands, at
+ * 3 * i, 3 * i + 1 and 3 * i + 2, so evaluating the derivatives neither
+ * allocates nor dispatches on node types.
+ */
+class CPGNetworkFB
+{
+public:
+
+	CPGNetworkFB();
+
+	/**
+	 * Add a node with the parameters of a CPGNodeFB. It starts with the
+	 * state a new CPGNodeFB has.
+	 * @param[in] params at least 11 values, as for CPGNodeFB
+	 * @return the node's index
+	 * @throw std::invalid_argument if there are too few parameters
+	 */
+	std::size_t addNode(const std::vector<double>& params);
+
+	/**
+	 * Make a node's phase follow another's.
+	 * @throw std::invalid_argument if either index is out of range
+	 */
+	void addCoupling(std::size_t node, std::size_t target,
+					 double weight, double phaseOffset);
+
+	/** Remove every node and coupling. */
+	void clear();
+
+	std::size_t size() const
+	{
+		return m_rConst.size();
+	}
+
+	std::size_t couplingCount() const
+	{
+		return m_couplings.size();
+	}
+
+	/**
+	 * The state: size() phases, then size() radii, then size()
+	 * frequencies.
+	 */
+	std::vector<double>& state()
+	{
+		return m_state;
+	}
+
+	const std::vector<double>& state() const
+	{
+		return m_state;
+	}
+
+	/**
+	 * Advance the network with constant feedback.
+	 * @param[in] feedback three values per node
+	 * @param[in] duration the time to advance
+	 * @param[in] stepSize the first adaptive step, or the fixed step
+	 * @param[in] maxEvaluations stop once the equations have been
+	 * evaluated more often than this
+	 * @return the number of evaluations
+	 */
+	std::size_t update(const double* feedback, double duration,
+					   double stepSize, std::size_t maxEvaluations);
+
+	/**
+	 * The derivatives of a state under the feedback of the current
+	 * update().
+	 */
+	void operator()(const double* x, double* dxdt);
+
+	CPGIntegrator& integrator()
+	{
+		return m_integrator;
+	}
+
+private:
+
+	/** Sort the couplings into rows, and size the buffers. */
+	void prepare();
+
+	/** The parameters of each node */
+	std::vector<double> m_rConst;
+	std::vector<double> m_radiusOffset;
+	std::vector<double> m_kFreq;
+	std::vector<double> m_kAmp;
+	std::vector<double> m_kPhase;
+
+	CPGCouplings m_couplings;
+
+	/** False when nodes or couplings were added since prepare() */
+	bool m_prepared;
+
+	/** The feedback of the current update(), three values per node */
+	const double* m_feedback;
+
+	/** The sines and cosines of the phases being evaluated */
+	std::vector<double> m_sin;
+	std::vector<double> m_cos;
+
+	std::vector<double> m_state;
+
+	CPGIntegrator m_integrator;
+};
+
+#endif // SRC_UTIL_CPG_NETWORK_FB_H
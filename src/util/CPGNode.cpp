@@ -31,6 +31,7 @@
 #include <algorithm> //for_each
 #include <math.h> 
 #include <assert.h>
+#include <stdexcept>
 
 CPGNode::CPGNode(int nodeNum, const std::vector<double> & params):
 nodeValue(0),
@@ -38,6 +39,7 @@ phiValue(0),
 phiDotValue(0),
 rValue(0),
 rDotValue(0),
+m_couplingVersion(0),
 m_nodeNumber(nodeNum),
 rDoubleDotValue(0),
 rConst(params[4]),
@@ -64,9 +66,23 @@ void CPGNode::addCoupling(	CPGNode* cNode,
 	couplingList.push_back(cNode);
     weightList.push_back(cWeight);
     phaseList.push_back(cPhase);
+    m_couplingVersion++;
     
     assert(couplingList.size() == weightList.size() && couplingList.size() == phaseList.size());
 }
+
+void CPGNode::setCoupling(	std::size_t i,
+							const double cWeight,
+							const double cPhase)
+{
+	if (i >= couplingList.size())
+	{
+		throw std::invalid_argument("Coupling index out of bounds");
+	}
+	weightList[i] = cWeight;
+	phaseList[i] = cPhase;
+	m_couplingVersion++;
+}
 	
 void CPGNode::updateDTs(double descCom)
 {
@@ -51,6 +51,24 @@ class CPGNode
 	void addCoupling(	CPGNode* cNode,
 						const double cWeight,
 						const double cPhase);
+	
+	/**
+	 * Change the weight and phase offset of an existing coupling
+	 * @param[in] i the coupling's index, in the order they were added
+	 * @throw std::invalid_argument if there is no such coupling
+	 */
+	void setCoupling(	std::size_t i,
+						const double cWeight,
+						const double cPhase);
+	
+	/**
+	 * Counts the changes to the couplings, so that CPGEquations knows
+	 * when to copy them again
+	 */
+	unsigned long getCouplingVersion() const
+	{
+		return m_couplingVersion;
+	}
 
 	/**
 	 * Update phiDotValue and rDoubleDotValue based on Node equations and
@@ -100,6 +118,12 @@ class CPGNode
 	std::vector<double> phaseList;
     std::vector<double> weightList;
     
+	/**
+	 * Incremented by every change to the lists above. Subclasses that
+	 * change them directly must increment it too.
+	 */
+	unsigned long m_couplingVersion;
+    
 	/**
 	 * Index of this node for printing and debugging
 	 */
@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_SIN_COS_H
+#define SRC_UTIL_CPG_SIN_COS_H
+
+/**
+ * @file CPGSinCos.h
+ * @brief Definition of function CPGSinCos
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+/**
+ * The sines and cosines of an array of angles, in one pass of plain
+ * arithmetic that the compiler can vectorize, instead of two library
+ * calls per angle. Uses the argument reduction and polynomial kernels of
+ * fdlibm, and is accurate to about an ulp while every angle is below
+ * 1e5 in magnitude (days of CPG phase). Falls back to the library
+ * otherwise.
+ * @param[in] x n angles
+ * @param[out] s their sines
+ * @param[out] c their cosines
+ * @param[in] n the number of angles
+ */
+inline void CPGSinCos(const double* x, double* s, double* c, std::size_t n)
+{
+	static const double limit = 1.0e5;
+
+	bool small = true;
+	for (std::size_t i = 0; i < n; i++)
+	{
+		small &= std::fabs(x[i]) < limit;
+	}
+	if (!small)
+	{
+		for (std::size_t i = 0; i < n; i++)
+		{
+			s[i] = std::sin(x[i]);
+			c[i] = std::cos(x[i]);
+		}
+		return;
+	}
+
+	// pi / 2 in three parts whose products with a quadrant number below
+	// 2^20 are exact
+	static const double twoOverPi = 6.36619772367581382433e-01;
+	static const double pio2_1 = 1.57079632673412561417e+00;
+	static const double pio2_2 = 6.07710050630396597660e-11;
+	static const double pio2_3 = 2.02226624871116645580e-21;
+
+	static const double S1 = -1.66666666666666324348e-01;
+	static const double S2 = 8.33333333332248946124e-03;
+	static const double S3 = -1.98412698298579493134e-04;
+	static const double S4 = 2.75573137070700676789e-06;
+	static const double S5 = -2.50507602534068634195e-08;
+	static const double S6 = 1.58969099521155010221e-10;
+
+	static const double C1 = 4.16666666666666019037e-02;
+	static const double C2 = -1.38888888888741095749e-03;
+	static const double C3 = 2.48015872894767294178e-05;
+	static const double C4 = -2.75573143513906633035e-07;
+	static const double C5 = 2.08757232129817482790e-09;
+	static const double C6 = -1.13596475577881948265e-11;
+
+	// Adding 1.5 * 2^52 rounds to an integer, which then sits in the low
+	// bits of the sum
+	static const double roundingShift = 6755399441055744.0;
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const double shifted = x[i] * twoOverPi + roundingShift;
+		const double q = shifted - roundingShift;
+		const double r = ((x[i] - q * pio2_1) - q * pio2_2) - q * pio2_3;
+
+		const double z = r * r;
+		const double sinR = r + z * r *
+			(S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+		const double hz = 0.5 * z;
+		const double w = 1.0 - hz;
+		const double cosR = w + (((1.0 - w) - hz) +
+			z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))));
+
+		// Rotate by the quadrant
+		uint64_t quadrant;
+		std::memcpy(&quadrant, &shifted, sizeof(quadrant));
+		const bool odd = (quadrant & 1) != 0;
+		const double sinSign = (quadrant & 2) ? -1.0 : 1.0;
+		const double cosSign = ((quadrant + 1) & 2) ? -1.0 : 1.0;
+		s[i] = sinSign * (odd ? cosR : sinR);
+		c[i] = cosSign * (odd ? sinR : cosR);
+	}
+}
+
+#endif // SRC_UTIL_CPG_SIN_COS_H
@@ -41,6 +41,7 @@
 #include "tgcreator/tgBoxInfo.h"
 #include "tgcreator/tgSphereInfo.h"
 #include "tgcreator/tgStructureInfo.h"
+#include "tgcreator/tgBlueprint.h"
 
 /**
  * Constructor that only takes the path to the YAML file.
@@ -60,7 +61,9 @@ TensegrityModel::TensegrityModel(const std::string& structurePath,
     debugging_on = debugging;
 }
 
-TensegrityModel::~TensegrityModel() {}
+TensegrityModel::~TensegrityModel() {
+    delete blueprint;
+}
 
 /**
  * Debugging function. Outputs the tgStructure, tgStructureInfo, and tgModel,
@@ -83,31 +86,38 @@ void TensegrityModel::trace(const tgStructure& structure,
  * calling the tgStructureInfo to build the structure into the world.
  */
 void TensegrityModel::setup(tgWorld& world) {
-    // create the build spec that uses tags to turn the structure into a model
-    tgBuildSpec spec;
-
-    // add default builders (rods, strings, boxes) that match the tags (rods, strings, boxes, spheres)
-    // (these will be overwritten if a different builder is specified for those tags)
-    Yam emptyYam = Yam();
-    addRodBuilder("tgRodInfo", "rod", emptyYam, spec);
-    addBasicActuatorBuilder("tgBasicActuatorInfo", "string", emptyYam, spec);
-    addBoxBuilder("tgBoxInfo", "box", emptyYam, spec);
-    addSphereBuilder("tgSphereInfo", "sphere", emptyYam, spec);
-
-    tgStructure structure;
-    buildStructure(structure, topLvlStructurePath, spec);
-
-    tgStructureInfo structureInfo(structure, spec);
-    structureInfo.buildInto(*this, world);
+    // the YAML file is only read and resolved on the first setup; resets
+    // build the same structure again from the blueprint
+    if (blueprint == NULL) {
+        // create the build spec that uses tags to turn the structure into a model
+        tgBuildSpec spec;
+
+        // add default builders (rods, strings, boxes) that match the tags (rods, strings, boxes, spheres)
+        // (these will be overwritten if a different builder is specified for those tags)
+        Yam emptyYam = Yam();
+        addRodBuilder("tgRodInfo", "rod", emptyYam, spec);
+        addBasicActuatorBuilder("tgBasicActuatorInfo", "string", emptyYam, spec);
+        addBoxBuilder("tgBoxInfo", "box", emptyYam, spec);
+        addSphereBuilder("tgSphereInfo", "sphere", emptyYam, spec);
+
+        tgStructure structure;
+        buildStructure(structure, topLvlStructurePath, spec);
+
+        blueprint = new tgBlueprint(structure, spec);
+        blueprint->buildInto(*this, world);
+
+        // DEBUGGING: print out the tgStructure, tgStructureInfo, and tgModel.
+        if(debugging_on) {
+            trace(structure, blueprint->getStructureInfo(), *this);
+        }
+    }
+    else {
+        blueprint->buildInto(*this, world);
+    }
 
     // use tgCast::filterto pull out the muscles that we want to control
     allActuators = tgCast::filter<tgModel, tgSpringCableActuator> (getDescendants());
 
-    // DEBUGGING: print out the tgStructure, tgStructureInfo, and tgModel.
-    if(debugging_on) {
-        trace(structure, structureInfo, *this);
-    }
-
     // notify controllers that setup has finished
     notifySetup();
 
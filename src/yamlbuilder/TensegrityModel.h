@@ -46,6 +46,7 @@ class tgSpringCableActuator;
 class tgModelVisitor;
 class tgWorld;
 class tgStructureInfo;
+class tgBlueprint;
 
 typedef YAML::Node Yam; // to avoid confusion with structure nodes
 
@@ -261,6 +262,12 @@ private:
      */
     std::vector<tgSpringCableActuator*> allActuators;
 
+    /**
+     * The structure, resolved from the YAML file on the first setup and
+     * built again from here after every reset.
+     */
+    tgBlueprint* blueprint = NULL;
+
     /*
      * Responsible for adding all the children defined in a structure file, and apply their
      * rotation, scale, offset and translation attributes.
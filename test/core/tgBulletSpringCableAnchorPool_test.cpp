@@ -0,0 +1,129 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBulletSpringCableAnchorPool_test.cpp
+* @brief Contains a test that tgBulletSpringCableAnchorPool recycles the
+* storage of the anchors it destroys
+* $Id$
+*/
+
+// This application
+#include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletSpringCableAnchorPool.h"
+// The Bullet Physics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	TEST(tgBulletSpringCableAnchorPoolTest, CreatesSlidingAnchors) {
+		// A static body at the origin, as Bullet's own fixed body is made
+		btRigidBody body(0.0, NULL, NULL);
+		tgBulletSpringCableAnchorPool pool;
+
+		const btVector3 pos(1.0, 2.0, 3.0);
+		const btVector3 normal(0.0, 1.0, 0.0);
+		tgBulletSpringCableAnchor* const pAnchor =
+			pool.create(&body, pos, normal, NULL);
+		EXPECT_FALSE(pAnchor->permanent);
+		EXPECT_TRUE(pAnchor->sliding);
+		EXPECT_EQ(&body, pAnchor->attachedBody);
+		EXPECT_EQ(NULL, pAnchor->getManifold());
+		EXPECT_EQ(pos, pAnchor->getWorldPosition());
+		EXPECT_EQ(normal, pAnchor->getContactNormal());
+		EXPECT_EQ(1, pool.live());
+
+		pool.destroy(pAnchor);
+		EXPECT_EQ(0, pool.live());
+	}
+
+	TEST(tgBulletSpringCableAnchorPoolTest, RecyclesStorage) {
+		btRigidBody body(0.0, NULL, NULL);
+		tgBulletSpringCableAnchorPool pool;
+		const btVector3 normal(0.0, 1.0, 0.0);
+
+		tgBulletSpringCableAnchor* const pFirst =
+			pool.create(&body, btVector3(1.0, 0.0, 0.0), normal, NULL);
+		pool.destroy(pFirst);
+		EXPECT_EQ(1, pool.spare());
+
+		// The storage comes back, with the new anchor's values
+		tgBulletSpringCableAnchor* const pSecond =
+			pool.create(&body, btVector3(2.0, 0.0, 0.0), normal, NULL);
+		EXPECT_EQ(pFirst, pSecond);
+		EXPECT_EQ(0, pool.spare());
+		EXPECT_EQ(btVector3(2.0, 0.0, 0.0), pSecond->getWorldPosition());
+		pool.destroy(pSecond);
+	}
+
+	TEST(tgBulletSpringCableAnchorPoolTest, ReusesEveryBlock) {
+		btRigidBody body(0.0, NULL, NULL);
+		tgBulletSpringCableAnchorPool pool;
+		const btVector3 normal(0.0, 1.0, 0.0);
+		const std::size_t n = 20;
+
+		std::vector<tgBulletSpringCableAnchor*> first;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			first.push_back(pool.create(&body, btVector3(i, 0.0, 0.0), normal, NULL));
+		}
+		EXPECT_EQ(n, pool.live());
+		for (std::size_t i = 0; i < n; i++)
+		{
+			pool.destroy(first[i]);
+		}
+		EXPECT_EQ(0, pool.live());
+		EXPECT_EQ(n, pool.spare());
+
+		// As many again need no new storage
+		std::vector<tgBulletSpringCableAnchor*> second;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			second.push_back(pool.create(&body, btVector3(i, 0.0, 0.0), normal, NULL));
+		}
+		EXPECT_EQ(0, pool.spare());
+		std::sort(first.begin(), first.end());
+		std::sort(second.begin(), second.end());
+		EXPECT_TRUE(first == second);
+
+		// One more does
+		tgBulletSpringCableAnchor* const pExtra =
+			pool.create(&body, btVector3(0.0, 0.0, 0.0), normal, NULL);
+		EXPECT_FALSE(std::binary_search(first.begin(), first.end(), pExtra));
+
+		pool.destroy(pExtra);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			pool.destroy(second[i]);
+		}
+		EXPECT_EQ(n + 1, pool.spare());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgModel_test.cpp
+* @brief Contains a test of the descendant index of tgModel
+* $Id$
+*/
+
+// This application
+#include "core/tgModel.h"
+#include "core/tgTags.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	class Leaf : public tgModel
+	{
+	public:
+		Leaf(const tgTags& tags) : tgModel(tags) { }
+	};
+
+	TEST(tgModelTest, findsDescendantsByTypeAndTags) {
+		tgModel root;
+		tgModel* const branch = new tgModel(tgTags("branch"));
+		Leaf* const a = new Leaf(tgTags("muscle left"));
+		Leaf* const b = new Leaf(tgTags("muscle right"));
+		Leaf* const c = new Leaf(tgTags("rod"));
+		root.addChild(branch);
+		branch->addChild(a);
+		root.addChild(b);
+		branch->addChild(c);
+
+		const std::vector<tgModel*>& all = root.getDescendants();
+		ASSERT_EQ(4, all.size());
+		EXPECT_EQ(branch, all[0]);
+		EXPECT_EQ(a, all[1]);
+		EXPECT_EQ(c, all[2]);
+		EXPECT_EQ(b, all[3]);
+
+		const std::vector<Leaf*> muscles = root.find<Leaf>("muscle");
+		ASSERT_EQ(2, muscles.size());
+		EXPECT_EQ(a, muscles[0]);
+		EXPECT_EQ(b, muscles[1]);
+
+		EXPECT_EQ(1, root.find<tgModel>("branch").size());
+		EXPECT_EQ(3, root.find<Leaf>("").size());
+		EXPECT_EQ(2, branch->find<Leaf>("").size());
+
+		root.teardown();
+	}
+
+	TEST(tgModelTest, followsChangesBelowTheModel) {
+		tgModel root;
+		tgModel* const branch = new tgModel();
+		root.addChild(branch);
+		ASSERT_EQ(0, root.find<Leaf>("muscle").size());
+
+		// Added below a child, after the root's index was built
+		Leaf* const a = new Leaf(tgTags("muscle"));
+		branch->addChild(a);
+		ASSERT_EQ(1, root.find<Leaf>("muscle").size());
+		EXPECT_EQ(a, root.find<Leaf>("muscle")[0]);
+
+		// Tags are not indexed
+		a->addTags("left");
+		EXPECT_EQ(1, root.find<Leaf>("left").size());
+
+		branch->teardown();
+		EXPECT_EQ(1, root.getDescendants().size());
+		EXPECT_EQ(0, root.find<Leaf>("muscle").size());
+
+		root.teardown();
+		EXPECT_TRUE(root.getDescendants().empty());
+	}
+
+	TEST(tgModelTest, rejectsDescendantsAsChildren) {
+		tgModel root;
+		tgModel* const branch = new tgModel();
+		tgModel* const leaf = new tgModel();
+		root.addChild(branch);
+		branch->addChild(leaf);
+
+		EXPECT_THROW(root.addChild(leaf), std::invalid_argument);
+		EXPECT_THROW(root.addChild(branch), std::invalid_argument);
+		EXPECT_THROW(root.addChild(&root), std::invalid_argument);
+		EXPECT_THROW(root.addChild(NULL), std::invalid_argument);
+
+		root.teardown();
+	}
+
+	TEST(tgModelTest, rejectsChildrenOfAnotherParent) {
+		tgModel first;
+		tgModel second;
+		tgModel* const child = new tgModel();
+		first.addChild(child);
+		ASSERT_EQ(1, first.getDescendants().size());
+
+		EXPECT_THROW(second.addChild(child), std::invalid_argument);
+		// Neither index changed
+		ASSERT_EQ(1, first.getDescendants().size());
+		EXPECT_EQ(child, first.getDescendants()[0]);
+		EXPECT_TRUE(second.getDescendants().empty());
+
+		first.teardown();
+	}
+
+	TEST(tgModelTest, rejectsAncestorsAsChildren) {
+		tgModel* const root = new tgModel();
+		tgModel* const branch = new tgModel();
+		tgModel* const leaf = new tgModel();
+		root->addChild(branch);
+		branch->addChild(leaf);
+
+		EXPECT_THROW(leaf->addChild(root), std::invalid_argument);
+		EXPECT_EQ(2, root->getDescendants().size());
+		EXPECT_TRUE(leaf->getDescendants().empty());
+
+		delete root;
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
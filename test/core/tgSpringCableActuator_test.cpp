@@ -0,0 +1,251 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgSpringCableActuator_test.cpp
+* @brief Contains a test of the history options of tgSpringCableActuator
+* $Id$
+*/
+
+// This application
+#include "core/tgSpringCable.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgSpringCableAnchor.h"
+#include "core/tgTags.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/** An anchor that stays where it was made */
+	class FixedAnchor : public tgSpringCableAnchor
+	{
+	public:
+		FixedAnchor(const btVector3& pos) :
+		tgSpringCableAnchor(pos),
+		m_pos(pos)
+		{
+		}
+
+		virtual btVector3 getWorldPosition() const { return m_pos; }
+		virtual bool setWorldPosition(btVector3& newPos) { m_pos = newPos; return true; }
+		virtual btVector3 getRelativePosition() const { return m_pos; }
+		virtual btVector3 getContactNormal() const { return btVector3(0, 0, 0); }
+
+	private:
+		btVector3 m_pos;
+	};
+
+	/** A spring cable ten units long that never moves */
+	class StillCable : public tgSpringCable
+	{
+	public:
+		StillCable(const std::vector<tgSpringCableAnchor*>& anchors) :
+		tgSpringCable(anchors, 1000.0, 10.0)
+		{
+		}
+
+		virtual void step(double dt) { }
+		virtual const double getActualLength() const { return 10.0; }
+		virtual const double getTension() const { return 0.0; }
+		virtual const std::vector<const tgSpringCableAnchor*> getAnchors() const
+		{
+			return std::vector<const tgSpringCableAnchor*>();
+		}
+	};
+
+	/** Records samples given by the test rather than by a simulation */
+	class Recorder : public tgSpringCableActuator
+	{
+	public:
+		Recorder(tgSpringCableActuator::Config& config) :
+		tgSpringCableActuator(makeCable(), tgTags(), config)
+		{
+		}
+
+		virtual void setControlInput(double input) { }
+
+		/** Sample i has tension i and rest length 100 - i */
+		void record(std::size_t steps)
+		{
+			for (std::size_t i = 0; i < steps; i++)
+			{
+				recordHistory(1.0 + i, 0.0, 0.0, 100.0 - i, 1.0 * i);
+			}
+		}
+
+	private:
+		static tgSpringCable* makeCable()
+		{
+			// Only read by the tgSpringCable constructor
+			static FixedAnchor a(btVector3(0, 0, 0));
+			static FixedAnchor b(btVector3(0, 10.0, 0));
+			std::vector<tgSpringCableAnchor*> anchors;
+			anchors.push_back(&a);
+			anchors.push_back(&b);
+			return new StillCable(anchors);
+		}
+	};
+
+	/** The energy the learning controllers computed from the sequences */
+	double energyOf(const tgSpringCableActuator::SpringCableActuatorHistory& h)
+	{
+		double energy = 0.0;
+		for (std::size_t j = 1; j < h.tensionHistory.size(); j++)
+		{
+			double motorSpeed = h.restLengths[j] - h.restLengths[j-1];
+			if (motorSpeed > 0)
+			{
+				motorSpeed = 0;
+			}
+			energy += h.tensionHistory[j-1] * motorSpeed;
+		}
+		return energy;
+	}
+
+	TEST(tgSpringCableActuatorTest, keepsEveryStepByDefault) {
+		tgSpringCableActuator::Config config(1000.0, 10.0, 0.0, true);
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		ASSERT_EQ(10, h.tensionHistory.size());
+		EXPECT_EQ(10, h.restLengths.size());
+		EXPECT_EQ(10, h.lastLengths.size());
+		EXPECT_EQ(10, h.lastVelocities.size());
+		EXPECT_EQ(10, h.dampingHistory.size());
+		EXPECT_EQ(0.0, h.tensionHistory.front());
+		EXPECT_EQ(9.0, h.tensionHistory.back());
+
+		// The aggregates come with the sequences
+		EXPECT_EQ(10, h.stats.count);
+		EXPECT_EQ(energyOf(h), h.stats.energySpent);
+	}
+
+	TEST(tgSpringCableActuatorTest, keepsNoHistoryUnlessAsked) {
+		tgSpringCableActuator::Config config;
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		EXPECT_EQ(0, h.tensionHistory.size());
+		EXPECT_EQ(0, h.stats.count);
+		EXPECT_EQ(0.0, h.stats.energySpent);
+	}
+
+	TEST(tgSpringCableActuatorTest, capacityKeepsTheLatestSamples) {
+		tgSpringCableActuator::Config config(1000.0, 10.0, 0.0, true);
+		config.histCapacity = 4;
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		ASSERT_EQ(4, h.tensionHistory.size());
+		EXPECT_EQ(4, h.restLengths.size());
+		EXPECT_EQ(4, h.lastLengths.size());
+		EXPECT_EQ(4, h.lastVelocities.size());
+		EXPECT_EQ(4, h.dampingHistory.size());
+		for (std::size_t i = 0; i < 4; i++)
+		{
+			EXPECT_EQ(6.0 + i, h.tensionHistory[i]);
+			EXPECT_EQ(94.0 - i, h.restLengths[i]);
+		}
+
+		// Still over every step
+		EXPECT_EQ(10, h.stats.count);
+		EXPECT_EQ(-36.0, h.stats.energySpent);
+	}
+
+	TEST(tgSpringCableActuatorTest, decimationKeepsEveryNthSample) {
+		tgSpringCableActuator::Config config(1000.0, 10.0, 0.0, true);
+		config.histDecimation = 3;
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		ASSERT_EQ(4, h.tensionHistory.size());
+		EXPECT_EQ(4, h.restLengths.size());
+		for (std::size_t i = 0; i < 4; i++)
+		{
+			EXPECT_EQ(3.0 * i, h.tensionHistory[i]);
+		}
+
+		// Still over every step
+		EXPECT_EQ(10, h.stats.count);
+		EXPECT_EQ(-36.0, h.stats.energySpent);
+	}
+
+	TEST(tgSpringCableActuatorTest, capacityAndDecimationCombine) {
+		tgSpringCableActuator::Config config(1000.0, 10.0, 0.0, true);
+		config.histCapacity = 2;
+		config.histDecimation = 3;
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		ASSERT_EQ(2, h.tensionHistory.size());
+		EXPECT_EQ(6.0, h.tensionHistory[0]);
+		EXPECT_EQ(9.0, h.tensionHistory[1]);
+	}
+
+	TEST(tgSpringCableActuatorTest, rejectsZeroDecimation) {
+		tgSpringCableActuator::Config config(1000.0, 10.0, 0.0, true);
+		config.histDecimation = 0;
+		EXPECT_THROW(Recorder recorder(config), std::invalid_argument);
+	}
+
+	TEST(tgSpringCableActuatorTest, statsWithoutSequences) {
+		tgSpringCableActuator::Config config;
+		config.histStats = true;
+		Recorder recorder(config);
+		recorder.record(10);
+
+		const tgSpringCableActuator::SpringCableActuatorHistory& h =
+			recorder.getHistory();
+		EXPECT_EQ(0, h.tensionHistory.size());
+
+		const tgSpringCableActuator::SpringCableActuatorStats& stats = h.stats;
+		EXPECT_EQ(10, stats.count);
+		EXPECT_EQ(45.0, stats.tensionSum);
+		EXPECT_EQ(285.0, stats.tensionSumSq);
+		EXPECT_EQ(4.5, stats.meanTension());
+		EXPECT_EQ(0.0, stats.tensionMin);
+		EXPECT_EQ(9.0, stats.tensionMax);
+		EXPECT_EQ(1.0, stats.lengthMin);
+		EXPECT_EQ(10.0, stats.lengthMax);
+		// Each step shortens the cable by one under the last tension
+		EXPECT_EQ(-36.0, stats.energySpent);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
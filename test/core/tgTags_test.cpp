@@ -0,0 +1,103 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgTags_test.cpp
+* @brief Contains a test of the set operations of tgTags
+* $Id$
+*/
+
+// This application
+#include "core/tgTags.h"
+#include "core/tgTagSearch.h"
+// The C++ Standard Library
+#include <string>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	TEST(tgTagsTest, keepsTheOrderTagsWereAddedIn) {
+		tgTags tags("b a c a");
+		tags.prepend("d");
+		tags.append(tgTags("e b"));
+
+		ASSERT_EQ(5, tags.size());
+		EXPECT_EQ("d", tags[0]);
+		EXPECT_EQ("b", tags[1]);
+		EXPECT_EQ("a", tags[2]);
+		EXPECT_EQ("c", tags[3]);
+		EXPECT_EQ("e", tags[4]);
+	}
+
+	TEST(tgTagsTest, containsIgnoresOrder) {
+		const tgTags tags("rod heavy left");
+
+		EXPECT_TRUE(tags.contains("left rod"));
+		EXPECT_TRUE(tags.contains(tgTags("heavy")));
+		EXPECT_TRUE(tags.contains(tgTags()));
+		EXPECT_FALSE(tags.contains("rod light"));
+		EXPECT_FALSE(tags.contains("neverUsedAnywhere"));
+
+		EXPECT_TRUE(tags.containsAny("light left"));
+		EXPECT_TRUE(tags.containsAny(tgTags("right heavy")));
+		EXPECT_FALSE(tags.containsAny(tgTags("right light")));
+		EXPECT_FALSE(tags.containsAny(tgTags()));
+	}
+
+	TEST(tgTagsTest, removeTakesOutEveryCopy) {
+		tgTags tags("a b");
+		tags += tgTags("a c");
+		ASSERT_EQ(4, tags.size());
+
+		tags.remove("a");
+		ASSERT_EQ(2, tags.size());
+		EXPECT_EQ("b", tags[0]);
+		EXPECT_EQ("c", tags[1]);
+		EXPECT_FALSE(tags.contains("a"));
+
+		tags.remove(tgTags("c unknownTag"));
+		ASSERT_EQ(1, tags.size());
+		EXPECT_EQ("b", tags[0]);
+	}
+
+	TEST(tgTagsTest, equalityIgnoresOrder) {
+		EXPECT_TRUE(tgTags("a b c") == tgTags("c a b"));
+		EXPECT_FALSE(tgTags("a b") == tgTags("a b c"));
+		EXPECT_TRUE(tgTags("a b") < tgTags("a c"));
+	}
+
+	TEST(tgTagsTest, rejectsInvalidTags) {
+		EXPECT_THROW(tgTags("a 42"), tgTagException);
+	}
+
+	TEST(tgTagsTest, searchInheritsRemovedTags) {
+		tgTagSearch search("muscle left");
+		EXPECT_FALSE(search.matches(tgTags("muscle")));
+
+		search.remove(tgTags("left"));
+		EXPECT_TRUE(search.matches(tgTags("muscle")));
+		EXPECT_FALSE(search.matches(tgTags("left")));
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
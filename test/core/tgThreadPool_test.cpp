@@ -0,0 +1,196 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgThreadPool_test.cpp
+* @brief Contains a test that tgThreadPool runs every task once, reports
+* failures and joins its workers
+* $Id$
+*/
+
+// This application
+#include "core/tgThreadPool.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+// POSIX
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/** Counts its runs, after sleeping for a while, and notes its thread */
+	class CountingTask : public tgThreadPool::Task
+	{
+	public:
+		CountingTask(useconds_t sleep = 0) : runs(0), m_sleep(sleep) { }
+
+		virtual void run()
+		{
+			if (m_sleep > 0)
+			{
+				usleep(m_sleep);
+			}
+			thread = pthread_self();
+			__sync_fetch_and_add(&runs, 1);
+		}
+
+		int runs;
+		pthread_t thread;
+
+	private:
+		const useconds_t m_sleep;
+	};
+
+	class FailingTask : public tgThreadPool::Task
+	{
+	public:
+		virtual void run()
+		{
+			throw std::invalid_argument("failing task");
+		}
+	};
+
+	/** @return the number of threads in this process */
+	int threadCount()
+	{
+		DIR* const dir = opendir("/proc/self/task");
+		if (dir == NULL)
+		{
+			return -1;
+		}
+		int n = 0;
+		while (dirent* const entry = readdir(dir))
+		{
+			if (entry->d_name[0] != '.')
+			{
+				n++;
+			}
+		}
+		closedir(dir);
+		return n;
+	}
+
+	TEST(tgThreadPoolTest, RunsEveryTaskExactlyOnce) {
+		tgThreadPool pool(4);
+		ASSERT_EQ(4u, pool.size());
+
+		std::vector<CountingTask> tasks(1000);
+		for (int round = 0; round < 3; round++)
+		{
+			for (std::size_t i = 0; i < tasks.size(); i++)
+			{
+				pool.submit(&tasks[i]);
+			}
+			pool.wait();
+			for (std::size_t i = 0; i < tasks.size(); i++)
+			{
+				ASSERT_EQ(round + 1, tasks[i].runs) << "task " << i;
+			}
+		}
+	}
+
+	TEST(tgThreadPoolTest, IdleWorkersStealTasks) {
+		// Round-robin puts every slow task on the first worker's deque;
+		// stealing lets the others take some of them.
+		tgThreadPool pool(4);
+		std::vector<CountingTask> slow(8, CountingTask(50000));
+		std::vector<CountingTask> quick(24);
+		for (std::size_t i = 0; i < slow.size(); i++)
+		{
+			pool.submit(&slow[i]);
+			pool.submit(&quick[3 * i]);
+			pool.submit(&quick[3 * i + 1]);
+			pool.submit(&quick[3 * i + 2]);
+		}
+		pool.wait();
+		bool stolen = false;
+		for (std::size_t i = 0; i < slow.size(); i++)
+		{
+			EXPECT_EQ(1, slow[i].runs);
+			stolen = stolen || !pthread_equal(slow[0].thread, slow[i].thread);
+		}
+		for (std::size_t i = 0; i < quick.size(); i++)
+		{
+			EXPECT_EQ(1, quick[i].runs);
+		}
+		EXPECT_TRUE(stolen);
+	}
+
+	TEST(tgThreadPoolTest, DestructorFinishesTasksAndJoinsWorkers) {
+		const int before = threadCount();
+		std::vector<CountingTask> tasks(16, CountingTask(10000));
+		{
+			tgThreadPool pool(4);
+			EXPECT_EQ(before + 4, threadCount());
+			for (std::size_t i = 0; i < tasks.size(); i++)
+			{
+				pool.submit(&tasks[i]);
+			}
+			// No wait(): the destructor waits for the pending tasks
+		}
+		for (std::size_t i = 0; i < tasks.size(); i++)
+		{
+			EXPECT_EQ(1, tasks[i].runs) << "task " << i;
+		}
+		// Joined threads are gone from the process
+		EXPECT_EQ(before, threadCount());
+	}
+
+	TEST(tgThreadPoolTest, WaitReportsAFailureOnce) {
+		tgThreadPool pool(2);
+		FailingTask failing;
+		std::vector<CountingTask> tasks(10);
+		pool.submit(&failing);
+		for (std::size_t i = 0; i < tasks.size(); i++)
+		{
+			pool.submit(&tasks[i]);
+		}
+		EXPECT_THROW(pool.wait(), std::runtime_error);
+		// The other tasks still ran
+		for (std::size_t i = 0; i < tasks.size(); i++)
+		{
+			EXPECT_EQ(1, tasks[i].runs);
+		}
+		// The failure was reported; the next batch starts clean
+		pool.submit(&tasks[0]);
+		EXPECT_NO_THROW(pool.wait());
+		EXPECT_EQ(2, tasks[0].runs);
+	}
+
+	TEST(tgThreadPoolTest, RejectsNullTask) {
+		tgThreadPool pool(1);
+		EXPECT_THROW(pool.submit(NULL), std::invalid_argument);
+	}
+
+	TEST(tgThreadPoolTest, DefaultsToHardwareConcurrency) {
+		tgThreadPool pool;
+		EXPECT_EQ(tgThreadPool::hardwareConcurrency(), pool.size());
+		EXPECT_GE(pool.size(), 1u);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,231 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file Evolution_test.cpp
+* @brief Contains a test of scoring a batch of trials from several
+* threads, for NeuroEvolution and AnnealEvolution
+* $Id$
+*/
+
+// This application
+#include "learning/AnnealEvolution/AnnealEvolution.h"
+#include "learning/NeuroEvolution/NeuroEvolution.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const int populationSize = 6;
+	const int numberOfElementsToMutate = 2;
+	const int numberOfControllers = 2;
+	const int numThreads = 3;
+
+	/** What differs between the evolution classes */
+	template <typename Evolution>
+	struct EvolutionTraits;
+
+	template <>
+	struct EvolutionTraits<NeuroEvolution>
+	{
+		typedef NeuroEvoMember Member;
+
+		/** The keys only NeuroEvolution reads */
+		static void writeConfig(std::ostream& config)
+		{
+			config << "numberOfChildren=0" << std::endl
+				<< "numberOfStates=0" << std::endl
+				<< "numberHidden=0" << std::endl;
+		}
+	};
+
+	template <>
+	struct EvolutionTraits<AnnealEvolution>
+	{
+		typedef AnnealEvoMember Member;
+
+		/** The keys only AnnealEvolution reads */
+		static void writeConfig(std::ostream& config)
+		{
+			config << "deviation=0.1" << std::endl
+				<< "MonteCarlo=0" << std::endl;
+		}
+	};
+
+	/** Scores every numThreads-th trial, last first */
+	template <typename Evolution>
+	struct ScoringJob
+	{
+		Evolution* evolution;
+		std::size_t numTrials;
+		std::size_t first;
+		int failures;
+	};
+
+	template <typename Evolution>
+	void* scoreTrials(void* arg)
+	{
+		ScoringJob<Evolution>& job = *static_cast<ScoringJob<Evolution>*>(arg);
+		std::vector<std::size_t> trials;
+		for (std::size_t i = job.first; i < job.numTrials; i += numThreads)
+		{
+			trials.push_back(i);
+		}
+		for (std::size_t i = trials.size(); i-- > 0; )
+		{
+			std::vector<double> scores;
+			scores.push_back(1.0 + trials[i]);
+			scores.push_back(0.0);
+			try
+			{
+				job.evolution->updateScores(trials[i], scores);
+			}
+			catch (std::exception&)
+			{
+				job.failures++;
+			}
+		}
+		return NULL;
+	}
+
+	std::size_t countLines(const std::string& path)
+	{
+		std::ifstream file(path.c_str());
+		std::string line;
+		std::size_t lines = 0;
+		while (std::getline(file, line))
+		{
+			lines++;
+		}
+		return lines;
+	}
+
+	// Runs each test in a scratch directory with a config.ini and logs/
+	template <typename Evolution>
+	class EvolutionTest : public ::testing::Test {
+		protected:
+			virtual void SetUp() {
+				char cwd[4096];
+				ASSERT_TRUE(getcwd(cwd, sizeof(cwd)) != NULL);
+				m_oldDir = cwd;
+
+				char scratch[] = "/tmp/Evolution_test.XXXXXX";
+				ASSERT_TRUE(mkdtemp(scratch) != NULL);
+				m_dir = scratch;
+				ASSERT_EQ(0, chdir(m_dir.c_str()));
+				ASSERT_EQ(0, mkdir("logs", 0755));
+
+				std::ofstream config("config.ini");
+				config << "populationSize=" << populationSize << std::endl
+					<< "numberOfElementsToMutate=" << numberOfElementsToMutate << std::endl
+					<< "numberOfTestsBetweenGenerations=" << populationSize << std::endl
+					<< "numberOfSubtests=1" << std::endl
+					<< "numberOfControllers=" << numberOfControllers << std::endl
+					<< "leniencyCoef=0.2" << std::endl
+					<< "coevolution=0" << std::endl
+					<< "startSeed=0" << std::endl
+					<< "learning=1" << std::endl
+					<< "numberOfActions=3" << std::endl
+					<< "compareAverageScores=0" << std::endl
+					<< "clearScoresBetweenGenerations=0" << std::endl;
+				EvolutionTraits<Evolution>::writeConfig(config);
+			}
+
+			virtual void TearDown() {
+				std::remove("config.ini");
+				std::remove("logs/scores.csv");
+				std::remove("logs/evolutiontest.csv");
+				for (int i = 0; i < numberOfControllers; i++)
+				{
+					std::ostringstream os;
+					os << "logs/bestParameters-test-" << i << ".nnw";
+					std::remove(os.str().c_str());
+				}
+				rmdir("logs");
+				chdir(m_oldDir.c_str());
+				rmdir(m_dir.c_str());
+			}
+
+			std::string m_oldDir;
+			std::string m_dir;
+	};
+
+	typedef ::testing::Types<NeuroEvolution, AnnealEvolution> Evolutions;
+	TYPED_TEST_CASE(EvolutionTest, Evolutions);
+
+	TYPED_TEST(EvolutionTest, ParallelScoresAdvanceOnce) {
+		typedef typename EvolutionTraits<TypeParam>::Member Member;
+		TypeParam* evolution = new TypeParam("test");
+
+		std::vector< std::vector<Member*> > trials =
+			evolution->nextGeneration();
+		ASSERT_EQ(populationSize, trials.size());
+		EXPECT_EQ(numberOfControllers, trials[0].size());
+
+		std::vector< ScoringJob<TypeParam> > jobs(numThreads);
+		std::vector<pthread_t> threads(numThreads);
+		for (int t = 0; t < numThreads; t++)
+		{
+			jobs[t].evolution = evolution;
+			jobs[t].numTrials = trials.size();
+			jobs[t].first = t;
+			jobs[t].failures = 0;
+			pthread_create(&threads[t], NULL, scoreTrials<TypeParam>, &jobs[t]);
+		}
+		for (int t = 0; t < numThreads; t++)
+		{
+			pthread_join(threads[t], NULL);
+			EXPECT_EQ(0, jobs[t].failures);
+		}
+
+		// One line of the evolution log per generation
+		EXPECT_EQ(1, countLines("logs/evolutiontest.csv"));
+
+		// A trial cannot be scored twice
+		std::vector<double> scores(2, 0.0);
+		EXPECT_THROW(evolution->updateScores(0, scores), std::invalid_argument);
+
+		// Only the mutated members are tested again
+		trials = evolution->nextGeneration();
+		EXPECT_EQ(numberOfElementsToMutate, trials.size());
+		EXPECT_EQ(1, countLines("logs/evolutiontest.csv"));
+		EXPECT_THROW(evolution->nextSetOfControllers(), std::runtime_error);
+
+		delete evolution;
+		EXPECT_EQ(populationSize, countLines("logs/scores.csv"));
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file LearningLog_test.cpp
+* @brief Contains a test of several processes appending score rows to
+* the same file
+* $Id$
+*/
+
+// This application
+#include "learning/Logging/LearningLog.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const int numProcesses = 4;
+	const int rowsPerProcess = 2000;
+	const int valuesPerRow = 40;
+
+	/** Every value in a row is the writer's number */
+	void writeRows(const std::string& path, int writer)
+	{
+		LearningLog log(path);
+		const std::vector<double> row(valuesPerRow, 1.0 + writer);
+		for (int i = 0; i < rowsPerProcess; i++)
+		{
+			log.addRow(row);
+		}
+	}
+
+	TEST(LearningLogTest, RowsFromSeveralProcessesStayWhole) {
+		char path[] = "/tmp/LearningLog_test.XXXXXX";
+		const int fd = mkstemp(path);
+		ASSERT_GE(fd, 0);
+		close(fd);
+
+		std::vector<pid_t> children;
+		for (int p = 0; p < numProcesses; p++)
+		{
+			const pid_t pid = fork();
+			ASSERT_GE(pid, 0);
+			if (pid == 0)
+			{
+				writeRows(path, p);
+				_exit(0);
+			}
+			children.push_back(pid);
+		}
+		for (std::size_t i = 0; i < children.size(); i++)
+		{
+			int status = 0;
+			ASSERT_EQ(children[i], waitpid(children[i], &status, 0));
+			EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+		}
+
+		std::vector<int> rows(numProcesses, 0);
+		std::ifstream file(path);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream values(line);
+			std::string value;
+			std::vector<std::string> fields;
+			while (std::getline(values, value, ','))
+			{
+				fields.push_back(value);
+			}
+			ASSERT_EQ(valuesPerRow, fields.size()) << "torn row: " << line;
+			for (std::size_t i = 1; i < fields.size(); i++)
+			{
+				ASSERT_EQ(fields[0], fields[i]) << "mixed row: " << line;
+			}
+			const int writer = std::atoi(fields[0].c_str()) - 1;
+			ASSERT_TRUE(writer >= 0 && writer < numProcesses) << line;
+			rows[writer]++;
+		}
+		for (int p = 0; p < numProcesses; p++)
+		{
+			EXPECT_EQ(rowsPerProcess, rows[p]) << "from process " << p;
+		}
+
+		std::remove(path);
+	}
+
+	TEST(LearningLogTest, AppendsToAnExistingFile) {
+		char path[] = "/tmp/LearningLog_test.XXXXXX";
+		const int fd = mkstemp(path);
+		ASSERT_GE(fd, 0);
+		close(fd);
+		{
+			std::ofstream file(path);
+			file << "1,2\n";
+		}
+
+		{
+			LearningLog log(path);
+			std::vector<double> row;
+			row.push_back(3.5);
+			row.push_back(-4);
+			log.addRow(row);
+		}
+
+		std::ifstream file(path);
+		const std::string contents((std::istreambuf_iterator<char>(file)),
+								   std::istreambuf_iterator<char>());
+		EXPECT_EQ("1,2\n3.5,-4\n", contents);
+		std::remove(path);
+	}
+
+	TEST(LearningLogTest, ReportsAFileItCannotOpen) {
+		LearningLog log("/nonexistent/directory/scores.csv");
+		EXPECT_THROW(log.addRow(std::vector<double>(1, 0.0)), std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,199 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgAsyncLogWriter_test.cpp
+* @brief Contains a test of when tgAsyncLogWriter writes its buffers out,
+* and of how it reports errors
+* $Id$
+*/
+
+// This application
+#include "sensors/tgAsyncLogWriter.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <sys/stat.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const fileName = "tgAsyncLogWriter_test.log";
+
+	std::string contents(const char* path)
+	{
+		std::ifstream file(path);
+		return std::string((std::istreambuf_iterator<char>(file)),
+						   std::istreambuf_iterator<char>());
+	}
+
+	long sizeOf(const char* path)
+	{
+		struct stat info;
+		return stat(path, &info) == 0 ? info.st_size : -1;
+	}
+
+	/** Wait up to timeout seconds for the file to reach size bytes */
+	bool waitForSize(const char* path, long size, double timeout)
+	{
+		for (double waited = 0.0; waited < timeout; waited += 0.01)
+		{
+			if (sizeOf(path) == size)
+			{
+				return true;
+			}
+			usleep(10000);
+		}
+		return sizeOf(path) == size;
+	}
+
+	/** Writes each byte twice */
+	class Doubler : public tgAsyncLogWriter::Formatter
+	{
+	public:
+		virtual void format(const char* data, std::size_t n,
+							std::vector<char>& out)
+		{
+			for (std::size_t i = 0; i < n; i++)
+			{
+				out.push_back(data[i]);
+				out.push_back(data[i]);
+			}
+		}
+	};
+
+	TEST(tgAsyncLogWriterTest, RejectsBadArguments) {
+		EXPECT_THROW(tgAsyncLogWriter(fileName, 0), std::invalid_argument);
+		EXPECT_THROW(tgAsyncLogWriter(fileName, 16, 0.0), std::invalid_argument);
+		EXPECT_THROW(tgAsyncLogWriter("/nonexistent/directory/log.txt"),
+					 std::runtime_error);
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, WritesAFullBlockWithoutAFlush) {
+		// The interval is too long to matter
+		tgAsyncLogWriter writer(fileName, 16, 1000.0);
+		writer.write(std::string(10, 'a'));
+		usleep(200000);
+		EXPECT_EQ(0, sizeOf(fileName));
+
+		writer.write(std::string(10, 'b'));
+		EXPECT_TRUE(waitForSize(fileName, 20, 5.0));
+
+		// Less than a block again stays in memory
+		writer.write(std::string(5, 'c'));
+		usleep(200000);
+		EXPECT_EQ(20, sizeOf(fileName));
+
+		writer.close();
+		EXPECT_EQ(std::string(10, 'a') + std::string(10, 'b') +
+				  std::string(5, 'c'), contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, WritesAPartBlockAfterTheInterval) {
+		// The block is too large to matter
+		tgAsyncLogWriter writer(fileName, 1 << 20, 0.05);
+		writer.write(std::string("some data"));
+		EXPECT_TRUE(waitForSize(fileName, 9, 5.0));
+
+		writer.write(std::string("more"));
+		EXPECT_TRUE(waitForSize(fileName, 13, 5.0));
+		writer.close();
+		EXPECT_EQ("some datamore", contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, FlushWritesEverythingBeforeIt) {
+		tgAsyncLogWriter writer(fileName, 1 << 20, 1000.0);
+		std::string expected;
+		for (int i = 0; i < 100; i++)
+		{
+			const std::string line = std::string(i, 'x') + "\n";
+			writer.write(line);
+			expected += line;
+			writer.flush();
+			ASSERT_EQ(expected, contents(fileName)) << "after flush " << i;
+		}
+		writer.close();
+		EXPECT_EQ(expected, contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, WritesAfterCloseAreIgnored) {
+		tgAsyncLogWriter writer(fileName);
+		writer.write(std::string("kept"));
+		writer.close();
+		writer.write(std::string("dropped"));
+		writer.flush();
+		writer.close();
+		EXPECT_EQ("kept", contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, AppendsToAnExistingFile) {
+		{
+			std::ofstream file(fileName);
+			file << "heading\n";
+		}
+		tgAsyncLogWriter writer(fileName, 1 << 20, 1.0, true);
+		writer.write(std::string("row\n"));
+		writer.close();
+		EXPECT_EQ("heading\nrow\n", contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, FormatsOnTheWriterThread) {
+		tgAsyncLogWriter writer(fileName, 4, 1000.0, false, new Doubler());
+		writer.write(std::string("ab"));
+		writer.write(std::string("cd"));
+		EXPECT_TRUE(waitForSize(fileName, 8, 5.0));
+		writer.write(std::string("e"));
+		writer.close();
+		EXPECT_EQ("aabbccddee", contents(fileName));
+		std::remove(fileName);
+	}
+
+	TEST(tgAsyncLogWriterTest, CloseReportsAFailedWrite) {
+		// Every write to /dev/full fails with ENOSPC
+		tgAsyncLogWriter writer("/dev/full", 1 << 20, 1000.0, true);
+		writer.write(std::string(100, 'x'));
+		EXPECT_THROW(writer.close(), std::runtime_error);
+	}
+
+	TEST(tgAsyncLogWriterTest, FlushReportsAFailedWrite) {
+		tgAsyncLogWriter writer("/dev/full", 1 << 20, 1000.0, true);
+		writer.write(std::string(100, 'x'));
+		EXPECT_THROW(writer.flush(), std::runtime_error);
+		// The failure stays reported
+		EXPECT_THROW(writer.close(), std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
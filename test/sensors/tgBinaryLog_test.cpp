@@ -0,0 +1,123 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBinaryLog_test.cpp
+* @brief Contains a round trip test of tgBinaryLogWriter and
+* tgBinaryLogReader
+* $Id$
+*/
+
+// This application
+#include "sensors/tgBinaryLogReader.h"
+#include "sensors/tgBinaryLogWriter.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const fileName = "tgBinaryLog_test.ntrtlog";
+
+	/** Write frames whose time is frame / 10 and whose values follow it */
+	void writeLog(std::size_t frames, std::size_t framesPerBlock)
+	{
+		std::vector<std::string> headings;
+		headings.push_back("time");
+		headings.push_back("0_X");
+		headings.push_back("0_tension");
+		tgBinaryLogWriter writer(fileName, headings, framesPerBlock);
+		for (std::size_t i = 0; i < frames; i++)
+		{
+			const double frame[3] = { i / 10.0, 1.0 * i, -2.0 * i };
+			writer.append(frame);
+		}
+		writer.close();
+	}
+
+	TEST(tgBinaryLogTest, RoundTrip) {
+		writeLog(50, 7);
+		const tgBinaryLogReader log(fileName);
+
+		ASSERT_EQ(3u, log.channelCount());
+		EXPECT_EQ("0_tension", log.headings()[2]);
+		EXPECT_EQ(1u, log.channelIndex("0_X"));
+		EXPECT_THROW(log.channelIndex("1_X"), std::invalid_argument);
+		ASSERT_EQ(50u, log.frameCount());
+		ASSERT_EQ(8u, log.blockCount());
+
+		const tgBinaryLogReader::Column tension = log.column(2);
+		std::size_t frame = 0;
+		for (std::size_t b = 0; b < tension.blockCount(); b++)
+		{
+			const double* values = tension.blockData(b);
+			for (std::size_t i = 0; i < tension.blockSize(b); i++, frame++)
+			{
+				EXPECT_EQ(-2.0 * frame, values[i]);
+				EXPECT_EQ(1.0 * frame, log.value(frame, 1));
+			}
+		}
+		EXPECT_EQ(50u, frame);
+
+		std::remove(fileName);
+	}
+
+	TEST(tgBinaryLogTest, LowerBoundFindsTimeRange) {
+		writeLog(50, 7);
+		const tgBinaryLogReader log(fileName);
+
+		EXPECT_EQ(0u, log.lowerBound(-1.0));
+		EXPECT_EQ(21u, log.lowerBound(2.05));
+		// On a block boundary
+		EXPECT_EQ(14u, log.lowerBound(1.4 - 1e-9));
+		EXPECT_EQ(50u, log.lowerBound(100.0));
+
+		std::remove(fileName);
+	}
+
+	TEST(tgBinaryLogTest, EmptyLog) {
+		writeLog(0, 16);
+		const tgBinaryLogReader log(fileName);
+
+		EXPECT_EQ(3u, log.channelCount());
+		EXPECT_EQ(0u, log.frameCount());
+		EXPECT_EQ(0u, log.lowerBound(1.0));
+
+		std::remove(fileName);
+	}
+
+	TEST(tgBinaryLogTest, RejectsOtherFiles) {
+		std::FILE* file = std::fopen(fileName, "w");
+		std::fputs("time,0_X,\n0,1,\n", file);
+		std::fclose(file);
+
+		EXPECT_THROW(tgBinaryLogReader log(fileName), std::runtime_error);
+
+		std::remove(fileName);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
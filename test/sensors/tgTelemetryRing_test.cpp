@@ -0,0 +1,265 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgTelemetryRing_test.cpp
+* @brief Contains a test of tgTelemetryRing and tgTelemetryRingReader:
+* the round trip, wraparound, and the reader's checks of what another
+* process wrote
+* $Id$
+*/
+
+// This application
+#include "sensors/tgTelemetryRing.h"
+#include "sensors/tgTelemetryRingFormat.h"
+#include "sensors/tgTelemetryRingReader.h"
+// The C++ Standard Library
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const ringName = "/tgTelemetryRing_test";
+
+	std::vector<std::string> headings()
+	{
+		std::vector<std::string> h;
+		h.push_back("time");
+		h.push_back("0_tension");
+		return h;
+	}
+
+	/** Frame i is { i, -2 i } */
+	void publish(tgTelemetryRing& ring, int first, int count)
+	{
+		for (int i = first; i < first + count; i++)
+		{
+			const double frame[2] = { 1.0 * i, -2.0 * i };
+			ring.publish(frame);
+		}
+	}
+
+	/** Read every new frame, expecting them to follow the pattern above */
+	std::vector<int> readAll(tgTelemetryRingReader& reader)
+	{
+		std::vector<int> numbers;
+		double frame[2];
+		while (reader.readNext(frame))
+		{
+			EXPECT_EQ(-2.0 * frame[0], frame[1]);
+			numbers.push_back(static_cast<int>(frame[0]));
+		}
+		return numbers;
+	}
+
+	/** A writable mapping of a ring's shared memory object */
+	class RawRing
+	{
+	public:
+		RawRing(const char* name, std::size_t bytes, bool create) :
+		m_name(name),
+		m_bytes(bytes),
+		m_p(NULL)
+		{
+			const int fd = shm_open(name, O_RDWR | (create ? O_CREAT : 0), 0644);
+			if (fd < 0)
+			{
+				throw std::runtime_error("shm_open");
+			}
+			if (create && ftruncate(fd, bytes) != 0)
+			{
+				close(fd);
+				throw std::runtime_error("ftruncate");
+			}
+			void* const p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+								 MAP_SHARED, fd, 0);
+			close(fd);
+			if (p == MAP_FAILED)
+			{
+				throw std::runtime_error("mmap");
+			}
+			m_p = static_cast<char*>(p);
+		}
+
+		~RawRing() { munmap(m_p, m_bytes); }
+
+		tgTelemetryRingFormat::Header& header()
+		{
+			return *reinterpret_cast<tgTelemetryRingFormat::Header*>(m_p);
+		}
+
+		/** The sequence number of the slot frame n goes into */
+		uint64_t& sequence(uint64_t n)
+		{
+			const tgTelemetryRingFormat::Header& h = header();
+			char* const pSlot = m_p + h.headerBytes +
+				(n % h.capacity) * tgTelemetryRingFormat::slotBytes(h.channelCount);
+			return *reinterpret_cast<uint64_t*>(pSlot);
+		}
+
+		char* data() { return m_p; }
+
+	private:
+		const char* m_name;
+		const std::size_t m_bytes;
+		char* m_p;
+	};
+
+	/** The size of the object a ring with headings() and capacity has */
+	std::size_t ringBytes(std::size_t capacity)
+	{
+		// The header, then "time" and "0_tension" with their lengths
+		std::size_t headerBytes = sizeof(tgTelemetryRingFormat::Header) + 4 + 4 + 4 + 9;
+		headerBytes = (headerBytes + 7) / 8 * 8;
+		return headerBytes + capacity * tgTelemetryRingFormat::slotBytes(2);
+	}
+
+	TEST(tgTelemetryRingTest, RoundTrip) {
+		tgTelemetryRing* const pRing = new tgTelemetryRing(ringName, headings(), 8);
+		tgTelemetryRingReader reader(ringName);
+		ASSERT_EQ(2u, reader.channelCount());
+		EXPECT_EQ(headings(), reader.headings());
+		EXPECT_EQ(8u, reader.capacity());
+		EXPECT_FALSE(reader.closed());
+
+		publish(*pRing, 0, 5);
+		EXPECT_EQ(5u, reader.published());
+		const std::vector<int> numbers = readAll(reader);
+		ASSERT_EQ(5u, numbers.size());
+		for (int i = 0; i < 5; i++)
+		{
+			EXPECT_EQ(i, numbers[i]);
+		}
+		EXPECT_EQ(5u, reader.position());
+		EXPECT_EQ(0u, reader.dropped());
+
+		// The reader keeps its mapping after the writer closes the ring
+		delete pRing;
+		EXPECT_TRUE(reader.closed());
+		EXPECT_THROW(tgTelemetryRingReader another(ringName), std::runtime_error);
+	}
+
+	TEST(tgTelemetryRingTest, StartsAtTheOldestFrameStillInTheRing) {
+		tgTelemetryRing ring(ringName, headings(), 8);
+		publish(ring, 0, 20);
+		tgTelemetryRingReader reader(ringName);
+		EXPECT_EQ(12u, reader.position());
+
+		const std::vector<int> numbers = readAll(reader);
+		ASSERT_EQ(8u, numbers.size());
+		for (int i = 0; i < 8; i++)
+		{
+			EXPECT_EQ(12 + i, numbers[i]);
+		}
+		EXPECT_EQ(0u, reader.dropped());
+	}
+
+	TEST(tgTelemetryRingTest, SkipsAndCountsFramesTheWriterLapped) {
+		tgTelemetryRing ring(ringName, headings(), 8);
+		tgTelemetryRingReader reader(ringName);
+		publish(ring, 0, 5);
+		EXPECT_EQ(5u, readAll(reader).size());
+
+		// Wraps around the ring more than once past the reader
+		publish(ring, 5, 20);
+		const std::vector<int> numbers = readAll(reader);
+		ASSERT_EQ(8u, numbers.size());
+		EXPECT_EQ(17, numbers.front());
+		EXPECT_EQ(24, numbers.back());
+		EXPECT_EQ(12u, reader.dropped());
+
+		reader.skipToLatest();
+		EXPECT_EQ(25u, reader.position());
+		publish(ring, 25, 1);
+		ASSERT_EQ(1u, readAll(reader).size());
+	}
+
+	TEST(tgTelemetryRingTest, SkipsATornSlot) {
+		tgTelemetryRing ring(ringName, headings(), 8);
+		tgTelemetryRingReader reader(ringName);
+		publish(ring, 0, 4);
+
+		RawRing raw(ringName, ringBytes(8), false);
+		// The writer is in the middle of copying into frame 1's slot
+		raw.sequence(1) = tgTelemetryRingFormat::writing;
+		// and has already overwritten frame 2's slot with a later frame
+		raw.sequence(2) = 2 + 8 + 1;
+
+		const std::vector<int> numbers = readAll(reader);
+		ASSERT_EQ(2u, numbers.size());
+		EXPECT_EQ(0, numbers[0]);
+		EXPECT_EQ(3, numbers[1]);
+		EXPECT_EQ(2u, reader.dropped());
+	}
+
+	TEST(tgTelemetryRingTest, RejectsHeadingsThatOverrunTheHeader) {
+		// Only the name is left from the ring; RawRing makes the object
+		{
+			tgTelemetryRing ring(ringName, headings(), 8);
+		}
+		const std::size_t bytes = ringBytes(8);
+		{
+			RawRing raw(ringName, bytes, true);
+			tgTelemetryRingFormat::Header& h = raw.header();
+			std::memcpy(h.magic, tgTelemetryRingFormat::magic(), sizeof(h.magic));
+			h.version = tgTelemetryRingFormat::version;
+			h.headerBytes = bytes - 8 * tgTelemetryRingFormat::slotBytes(2);
+			h.channelCount = 2;
+			h.capacity = 8;
+			// The first heading claims more than the whole object
+			const uint32_t length = 1 << 30;
+			std::memcpy(raw.data() + sizeof(h), &length, sizeof(length));
+			EXPECT_THROW(tgTelemetryRingReader reader(ringName), std::runtime_error);
+
+			// A header larger than the object
+			std::memset(raw.data() + sizeof(h), 0, h.headerBytes - sizeof(h));
+			h.headerBytes = bytes + 8;
+			EXPECT_THROW(tgTelemetryRingReader reader(ringName), std::runtime_error);
+
+			// More channels than the header has room for
+			h.headerBytes = bytes - 8 * tgTelemetryRingFormat::slotBytes(2);
+			h.channelCount = 1000;
+			EXPECT_THROW(tgTelemetryRingReader reader(ringName), std::runtime_error);
+
+			// Slots that do not fill the object
+			h.channelCount = 2;
+			h.capacity = 7;
+			EXPECT_THROW(tgTelemetryRingReader reader(ringName), std::runtime_error);
+
+			// Made whole again, it reads as a ring with empty headings
+			h.capacity = 8;
+			tgTelemetryRingReader reader(ringName);
+			EXPECT_EQ(2u, reader.channelCount());
+		}
+		shm_unlink(ringName);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
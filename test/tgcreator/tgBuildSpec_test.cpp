@@ -0,0 +1,97 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBuildSpec_test.cpp
+* @brief Contains a test of the builder matching in tgBuildSpec
+* $Id$
+*/
+
+// This application
+#include "tgcreator/tgBuildSpec.h"
+#include "core/tgTags.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// The fixture: builders without factories, since only the matching
+	// is tested
+	class tgBuildSpecTest : public ::testing::Test {
+		protected:
+			tgBuildSpecTest() {
+				spec.addBuilder("rod", (tgRigidInfo*) NULL);
+				spec.addBuilder("rod heavy", (tgRigidInfo*) NULL);
+				spec.addBuilder("muscle", (tgConnectorInfo*) NULL);
+				spec.addBuilder("", (tgConnectorInfo*) NULL);
+				rigidAgents = spec.getRigidAgents();
+				connectorAgents = spec.getConnectorAgents();
+			}
+
+			tgBuildSpec spec;
+			std::vector<tgBuildSpec::RigidAgent*> rigidAgents;
+			std::vector<tgBuildSpec::ConnectorAgent*> connectorAgents;
+	};
+
+	TEST_F(tgBuildSpecTest, lastAddedMatchesFirst) {
+		tgBuildSpec::Matcher matcher = spec.matcher(tgTags());
+
+		const std::vector<tgBuildSpec::RigidAgent*> rod =
+			matcher.rigidAgents(tgTags("rod"));
+		ASSERT_EQ(1, rod.size());
+		EXPECT_EQ(rigidAgents[0], rod[0]);
+
+		const std::vector<tgBuildSpec::RigidAgent*> heavy =
+			matcher.rigidAgents(tgTags("heavy rod other"));
+		ASSERT_EQ(2, heavy.size());
+		EXPECT_EQ(rigidAgents[1], heavy[0]);
+		EXPECT_EQ(rigidAgents[0], heavy[1]);
+
+		EXPECT_TRUE(matcher.rigidAgents(tgTags("other")).empty());
+	}
+
+	TEST_F(tgBuildSpecTest, emptySearchMatchesEverything) {
+		tgBuildSpec::Matcher matcher = spec.matcher(tgTags());
+
+		const std::vector<tgBuildSpec::ConnectorAgent*> other =
+			matcher.connectorAgents(tgTags("other"));
+		ASSERT_EQ(1, other.size());
+		EXPECT_EQ(connectorAgents[1], other[0]);
+
+		const std::vector<tgBuildSpec::ConnectorAgent*> muscle =
+			matcher.connectorAgents(tgTags("muscle"));
+		ASSERT_EQ(2, muscle.size());
+		EXPECT_EQ(connectorAgents[1], muscle[0]);
+		EXPECT_EQ(connectorAgents[0], muscle[1]);
+	}
+
+	TEST_F(tgBuildSpecTest, structureTagsAreInherited) {
+		tgBuildSpec::Matcher matcher = spec.matcher(tgTags("heavy"));
+
+		EXPECT_EQ(2, matcher.rigidAgents(tgTags("rod")).size());
+		EXPECT_TRUE(matcher.rigidAgents(tgTags()).empty());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
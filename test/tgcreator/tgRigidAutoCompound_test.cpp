@@ -0,0 +1,153 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgRigidAutoCompound_test.cpp
+* @brief Contains a test of the grouping of rigids that share nodes in
+* tgRigidAutoCompound
+* $Id$
+*/
+
+// This application
+#include "tgcreator/tgRigidAutoCompound.h"
+#include "tgcreator/tgPair.h"
+#include "tgcreator/tgRodInfo.h"
+#include "core/tgRod.h"
+// The Bullet Physics Library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <deque>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Gives the tests access to the groups
+	class GroupedAutoCompound : public tgRigidAutoCompound {
+		public:
+			GroupedAutoCompound(std::vector<tgRigidInfo*> rigids) :
+				tgRigidAutoCompound(rigids) { }
+
+			const std::vector< std::deque<tgRigidInfo*> >& groups() {
+				if (m_groups.empty()) {
+					groupRigids();
+				}
+				return m_groups;
+			}
+	};
+
+	// The fixture: rods on the x axis that share end points
+	class tgRigidAutoCompoundTest : public ::testing::Test {
+		protected:
+			tgRigidAutoCompoundTest() { }
+
+			virtual ~tgRigidAutoCompoundTest() {
+				for (std::size_t i = 0; i < rods.size(); i++) {
+					delete rods[i];
+				}
+			}
+
+			void addRod(double from, double to) {
+				const tgPair pair(btVector3(from, 0.0, 0.0), btVector3(to, 0.0, 0.0));
+				rods.push_back(new tgRodInfo(config, pair));
+			}
+
+			tgRod::Config config;
+			std::vector<tgRigidInfo*> rods;
+	};
+
+	TEST_F(tgRigidAutoCompoundTest, groupsLinkedRigidsDepthFirst) {
+		addRod(0.0, 1.0);   // 0: linked to 2 and 5
+		addRod(5.0, 6.0);   // 1: linked to 3 and 5
+		addRod(1.0, 2.0);   // 2
+		addRod(6.0, 7.0);   // 3
+		addRod(10.0, 11.0); // 4: alone
+		addRod(0.0, 5.0);   // 5
+
+		GroupedAutoCompound compound(rods);
+		const std::vector< std::deque<tgRigidInfo*> >& groups = compound.groups();
+
+		// Each rigid's links are followed before its next link is taken,
+		// lowest index first
+		ASSERT_EQ(2, groups.size());
+		ASSERT_EQ(5, groups[0].size());
+		EXPECT_EQ(rods[0], groups[0][0]);
+		EXPECT_EQ(rods[2], groups[0][1]);
+		EXPECT_EQ(rods[5], groups[0][2]);
+		EXPECT_EQ(rods[1], groups[0][3]);
+		EXPECT_EQ(rods[3], groups[0][4]);
+		ASSERT_EQ(1, groups[1].size());
+		EXPECT_EQ(rods[4], groups[1][0]);
+	}
+
+	TEST_F(tgRigidAutoCompoundTest, rigidsWithoutSharedNodesStayApart) {
+		addRod(0.0, 1.0);
+		addRod(1.5, 2.0);
+		addRod(3.0, 4.0);
+
+		GroupedAutoCompound compound(rods);
+		const std::vector< std::deque<tgRigidInfo*> >& groups = compound.groups();
+
+		ASSERT_EQ(3, groups.size());
+		for (std::size_t i = 0; i < groups.size(); i++) {
+			ASSERT_EQ(1, groups[i].size());
+			EXPECT_EQ(rods[i], groups[i][0]);
+		}
+	}
+
+	TEST_F(tgRigidAutoCompoundTest, listedTwiceIsGroupedOnce) {
+		addRod(0.0, 1.0);
+		addRod(1.0, 2.0);
+		rods.push_back(rods[0]);
+
+		std::vector<tgRigidInfo*> listed(rods);
+		rods.pop_back();
+		GroupedAutoCompound compound(listed);
+		const std::vector< std::deque<tgRigidInfo*> >& groups = compound.groups();
+
+		ASSERT_EQ(1, groups.size());
+		ASSERT_EQ(2, groups[0].size());
+		EXPECT_EQ(rods[0], groups[0][0]);
+		EXPECT_EQ(rods[1], groups[0][1]);
+	}
+
+	TEST_F(tgRigidAutoCompoundTest, executeSharesOneCompoundPerGroup) {
+		addRod(0.0, 1.0);
+		addRod(1.0, 2.0);
+		addRod(3.0, 4.0);
+
+		tgRigidAutoCompound compound(rods);
+		std::vector<tgRigidInfo*> compounded = compound.execute();
+
+		ASSERT_EQ(2, compounded.size());
+		EXPECT_EQ(compounded[0], rods[0]->getRigidInfoGroup());
+		EXPECT_EQ(compounded[0], rods[1]->getRigidInfoGroup());
+		EXPECT_EQ(rods[2], rods[2]->getRigidInfoGroup());
+		EXPECT_EQ(rods[2], compounded[1]);
+
+		// The compound is ours; the lone rod is not
+		delete compounded[0];
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file CPGEquationsFB_test.cpp
+* @brief Contains a test that CPGEquationsFB follows the trajectory its
+* nodes follow when integrated one by one with boost::odeint
+* $Id$
+*/
+
+// This application
+#include "util/CPGEquationsFB.h"
+#include "util/CPGNodeFB.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * Integrates through getXVars, updateNodes, getDXVars and
+	 * updateNodeData, the way CPGEquationsFB did before its nodes were
+	 * flattened into a CPGNetworkFB
+	 */
+	class ODEIntCPGEquationsFB : public CPGEquationsFB
+	{
+	public:
+		ODEIntCPGEquationsFB(int maxSteps) :
+		CPGEquationsFB(maxSteps)
+		{
+		}
+
+	protected:
+		void integrate(std::vector<double>& descCom, double dt)
+		{
+			integrateWithODEInt(descCom, dt);
+		}
+	};
+
+	/** A ring of four feedback nodes with uneven couplings */
+	void buildSystem(CPGEquationsFB& system)
+	{
+		const int numNodes = 4;
+		std::vector<double> params (11);
+		params[0] = 0.0; // Frequency Offset (unused)
+		params[1] = 0.0; // Frequency Scale (unused)
+		params[2] = 1.0; // Radius Offset
+		params[3] = 0.0; // Radius Scale (unused)
+		params[4] = 2.0; // rConst (a constant)
+		params[5] = 0.0; // dMin (unused)
+		params[6] = 5.0; // dMax (unused)
+		params[7] = 2.0 * M_PI; // omega
+		params[8] = 0.5; // kFreq
+		params[9] = 0.3; // kAmp
+		params[10] = 0.2; // kPhase
+		for (int i = 0; i < numNodes; i++)
+		{
+			params[7] = 2.0 * M_PI * (1.0 + 0.1 * i);
+			system.addNode(params);
+		}
+		for (int i = 0; i < numNodes; i++)
+		{
+			std::vector<int> connectivityList;
+			std::vector<double> weights;
+			std::vector<double> phases;
+
+			connectivityList.push_back((i + 1) % numNodes);
+			weights.push_back(1.0);
+			phases.push_back(M_PI / 2.0);
+
+			connectivityList.push_back((i + numNodes - 1) % numNodes);
+			weights.push_back(0.5);
+			phases.push_back(-M_PI / 4.0);
+
+			system.defineConnections(i, connectivityList, weights, phases);
+		}
+	}
+
+	TEST(CPGEquationsFBTest, MatchesODEIntPath) {
+		const int numNodes = 4;
+		CPGEquationsFB flat(5000);
+		ODEIntCPGEquationsFB perNode(5000);
+		buildSystem(flat);
+		buildSystem(perNode);
+
+		std::vector<double> feedback (3 * numNodes);
+		for (int step = 0; step < 2000; step++)
+		{
+			for (int i = 0; i < numNodes; i++)
+			{
+				feedback[3 * i] = 0.5 * std::sin(0.01 * step + i);
+				feedback[3 * i + 1] = 0.2 * std::cos(0.02 * step);
+				feedback[3 * i + 2] = 0.1 * i;
+			}
+			flat.update(feedback, 0.001);
+			perNode.update(feedback, 0.001);
+		}
+
+		for (int i = 0; i < numNodes; i++)
+		{
+			EXPECT_NEAR(perNode[i], flat[i], 1.0e-6);
+		}
+	}
+
+	/** Feedback that changes with the step */
+	void setFeedback(std::vector<double>& feedback, int step)
+	{
+		const int numNodes = feedback.size() / 3;
+		for (int i = 0; i < numNodes; i++)
+		{
+			feedback[3 * i] = 0.5 * std::sin(0.1 * step + i);
+			feedback[3 * i + 1] = 0.2 * std::cos(0.2 * step);
+			feedback[3 * i + 2] = 0.1 * i;
+		}
+	}
+
+	TEST(CPGEquationsFBTest, FixedStepIntegration) {
+		const int numNodes = 4;
+		CPGEquationsFB adaptive(5000);
+		CPGEquationsFB fixed(5000);
+		buildSystem(adaptive);
+		buildSystem(fixed);
+		// Through the base class, as controllers hold their equations
+		CPGEquations& base = fixed;
+		base.setIntegrationMethod(CPGIntegrator::eRungeKutta4);
+
+		// Steps long enough that a single RK4 step is visibly less exact
+		// than the adaptive steps
+		std::vector<double> feedback (3 * numNodes);
+		for (int step = 0; step < 20; step++)
+		{
+			setFeedback(feedback, step);
+			adaptive.update(feedback, 0.1);
+			fixed.update(feedback, 0.1);
+		}
+
+		double difference = 0.0;
+		for (int i = 0; i < numNodes; i++)
+		{
+			difference = std::max(difference, std::fabs(adaptive[i] - fixed[i]));
+		}
+		EXPECT_GT(difference, 1.0e-6);
+
+		// Short fixed steps come back to the adaptive trajectory
+		CPGEquationsFB fine(50000);
+		buildSystem(fine);
+		fine.setIntegrationMethod(CPGIntegrator::eRungeKutta4);
+		for (int step = 0; step < 20; step++)
+		{
+			setFeedback(feedback, step);
+			for (int k = 0; k < 100; k++)
+			{
+				fine.update(feedback, 0.001);
+			}
+		}
+		for (int i = 0; i < numNodes; i++)
+		{
+			EXPECT_NEAR(adaptive[i], fine[i], 1.0e-4);
+		}
+	}
+
+	TEST(CPGEquationsFBTest, NodeListConstructorChecksNodeTypes) {
+		std::vector<double> params (11, 1.0);
+
+		std::vector<CPGNode*> fbNodes;
+		fbNodes.push_back(new CPGNodeFB(0, params));
+		fbNodes.push_back(new CPGNodeFB(1, params));
+		// Takes ownership of the nodes
+		EXPECT_NO_THROW(CPGEquationsFB system(fbNodes));
+
+		std::vector<CPGNode*> mixedNodes;
+		mixedNodes.push_back(new CPGNodeFB(0, params));
+		mixedNodes.push_back(new CPGNode(1, params));
+		EXPECT_THROW(CPGEquationsFB system(mixedNodes), std::invalid_argument);
+		delete mixedNodes[0];
+		delete mixedNodes[1];
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -31,8 +31,11 @@
 #include "LinearMath/btQuaternion.h"
 #include "LinearMath/btMatrix3x3.h"
 // The C++ Standard Library
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
+#include <vector>
 // Google Test
 #include "gtest/gtest.h"
 
@@ -41,6 +44,41 @@ using namespace std;
 
 namespace {
 
+	/** Lets the tests reorder the nodes, as a subclass may */
+	class ReorderableCPGEquations : public CPGEquations
+	{
+	public:
+		ReorderableCPGEquations(int maxSteps) :
+		CPGEquations(maxSteps)
+		{
+		}
+
+		void swapNodes(std::size_t i, std::size_t j)
+		{
+			std::swap(nodeList[i], nodeList[j]);
+		}
+	};
+
+	/**
+	 * Integrates through getXVars, updateNodes, getDXVars and
+	 * updateNodeData with boost::odeint, reading the nodes afresh at
+	 * every evaluation
+	 */
+	class ODEIntCPGEquations : public ReorderableCPGEquations
+	{
+	public:
+		ODEIntCPGEquations(int maxSteps) :
+		ReorderableCPGEquations(maxSteps)
+		{
+		}
+
+	protected:
+		void integrate(std::vector<double>& descCom, double dt)
+		{
+			integrateWithODEInt(descCom, dt);
+		}
+	};
+
 	// The fixture for testing class FileHelpers.
 	class CPGEquationsTest : public ::testing::Test {
 		protected:
@@ -71,6 +109,13 @@ namespace {
             CPGEquations* getCPGSystem(int numNodes)
             {
                 CPGEquations* m_pCPGSystem = new CPGEquations(5000);
+                buildCPGSystem(*m_pCPGSystem, numNodes);
+                return m_pCPGSystem;
+            }
+            
+            void buildCPGSystem(CPGEquations& system, int numNodes)
+            {
+                CPGEquations* m_pCPGSystem = &system;
                 
                 std::vector<double> params (7);
                 params[0] = 1.0; // Frequency Offset
@@ -134,8 +179,6 @@ namespace {
                 phases.push_back(M_PI / 2.0);
                 
                 m_pCPGSystem->defineConnections(2, connectivityList, weights, phases); 
-                
-                return m_pCPGSystem;
             }
 	};
 
@@ -172,6 +215,76 @@ namespace {
             delete m_pCPGSystem2;
 	}
 
+	TEST_F(CPGEquationsTest, testFixedStepIntegration) {
+            
+            int numNodes = 3;
+            
+            CPGEquations* m_pCPGSystem = getCPGSystem(numNodes);
+            CPGEquations* m_pCPGSystem2 = getCPGSystem(numNodes);
+            m_pCPGSystem2->setIntegrationMethod(CPGIntegrator::eRungeKutta4);
+            
+            std::vector<double> desComs (numNodes, 0.0);
+            
+            // Both integrate at the step size of a simulation
+            int numSteps = 2000;
+            for (int i = 0; i < numSteps; i++)
+            {
+                m_pCPGSystem->update(desComs, 0.001);
+                m_pCPGSystem2->update(desComs, 0.001);
+            }
+            
+            EXPECT_NEAR((*m_pCPGSystem)[0], (*m_pCPGSystem2)[0], 1.0 * pow(10, -6));
+            EXPECT_NEAR((*m_pCPGSystem)[1], (*m_pCPGSystem2)[1], 1.0 * pow(10, -6));
+            EXPECT_NEAR((*m_pCPGSystem)[2], (*m_pCPGSystem2)[2], 1.0 * pow(10, -6));
+            
+            delete m_pCPGSystem;
+            delete m_pCPGSystem2;
+	}
+
+	TEST_F(CPGEquationsTest, seesChangedCouplings) {
+            
+            int numNodes = 3;
+            
+            ReorderableCPGEquations flat(5000);
+            ODEIntCPGEquations perNode(5000);
+            buildCPGSystem(flat, numNodes);
+            buildCPGSystem(perNode, numNodes);
+            
+            std::vector<double> desComs (numNodes, 0.0);
+            
+            for (int i = 0; i < 3000; i++)
+            {
+                if (i == 1000)
+                {
+                    // Same number of couplings, different weight and phase
+                    flat.setCoupling(0, 1, 3.0, -M_PI / 3.0);
+                    perNode.setCoupling(0, 1, 3.0, -M_PI / 3.0);
+                }
+                if (i == 2000)
+                {
+                    // Same nodes and couplings, in another order
+                    flat.swapNodes(0, 2);
+                    perNode.swapNodes(0, 2);
+                }
+                flat.update(desComs, 0.001);
+                perNode.update(desComs, 0.001);
+                
+                for (int j = 0; j < numNodes; j++)
+                {
+                    ASSERT_NEAR(perNode[j], flat[j], 1.0 * pow(10, -6))
+                        << "node " << j << " after step " << i;
+                }
+            }
+	}
+
+	TEST_F(CPGEquationsTest, rejectsMissingCoupling) {
+            
+            CPGEquations system(5000);
+            buildCPGSystem(system, 3);
+            EXPECT_THROW(system.setCoupling(3, 0, 1.0, 0.0), std::invalid_argument);
+            EXPECT_THROW(system.setCoupling(0, 2, 1.0, 0.0), std::invalid_argument);
+	}
+
 } // namespace
 
 int main(int argc, char **argv) {
@@ -0,0 +1,121 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file CPGNetworkBatch_test.cpp
+* @brief Contains a test that each member of a CPGNetworkBatch follows
+* the trajectory its CPGNetwork follows alone
+* $Id$
+*/
+
+// This application
+#include "util/CPGNetwork.h"
+#include "util/CPGNetworkBatch.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/** A ring of five nodes whose parameters depend on the variant */
+	void buildNetwork(CPGNetwork& network, int variant)
+	{
+		const int numNodes = 5;
+		std::vector<double> params (7);
+		params[0] = 1.0 + 0.1 * variant; // Frequency Offset
+		params[1] = 0.2; // Frequency Scale
+		params[2] = 1.0 + 0.05 * variant; // Radius Offset
+		params[3] = 0.1; // Radius Scale
+		params[4] = 20.0; // rConst (a constant)
+		params[5] = 0.0; // dMin for descending commands
+		params[6] = 5.0; // dMax for descending commands
+		for (int i = 0; i < numNodes; i++)
+		{
+			network.addNode(params);
+		}
+		for (int i = 0; i < numNodes; i++)
+		{
+			network.addCoupling(i, (i + 1) % numNodes, 1.0 + 0.1 * variant, M_PI / 2.0);
+			network.addCoupling(i, (i + numNodes - 1) % numNodes, 0.5, -0.3 * variant);
+		}
+	}
+
+	TEST(CPGNetworkBatchTest, MembersMatchSingleNetworks) {
+		const int numMembers = 4;
+		CPGNetwork prototype;
+		buildNetwork(prototype, 0);
+		CPGNetworkBatch batch(prototype, numMembers);
+
+		std::vector<CPGNetwork*> singles;
+		for (int k = 0; k < numMembers; k++)
+		{
+			singles.push_back(new CPGNetwork());
+			buildNetwork(*singles[k], k);
+			singles[k]->integrator().setMethod(CPGIntegrator::eRungeKutta4);
+			batch.setMember(k, *singles[k]);
+		}
+
+		const std::size_t numNodes = prototype.size();
+		std::vector<double> batchComs(numNodes * numMembers);
+		std::vector<double> singleComs(numNodes);
+		for (int step = 0; step < 1000; step++)
+		{
+			for (int k = 0; k < numMembers; k++)
+			{
+				for (std::size_t i = 0; i < numNodes; i++)
+				{
+					const double com = 1.0 + 0.5 * std::sin(0.01 * step + i + k);
+					singleComs[i] = com;
+					batchComs[i * numMembers + k] = com;
+				}
+				singles[k]->update(&singleComs[0], 0.001, 0.001, 1000);
+			}
+			batch.update(&batchComs[0], 0.001, 0.001);
+		}
+
+		for (int k = 0; k < numMembers; k++)
+		{
+			for (std::size_t i = 0; i < numNodes; i++)
+			{
+				EXPECT_NEAR(singles[k]->nodeValue(i), batch.nodeValue(k, i), 1.0e-12);
+			}
+			delete singles[k];
+		}
+	}
+
+	TEST(CPGNetworkBatchTest, RejectsOtherTopologies) {
+		CPGNetwork prototype;
+		buildNetwork(prototype, 0);
+		CPGNetworkBatch batch(prototype, 2);
+
+		CPGNetwork other;
+		buildNetwork(other, 1);
+		other.addCoupling(0, 2, 1.0, 0.0);
+		EXPECT_THROW(batch.setMember(1, other), std::invalid_argument);
+		EXPECT_THROW(batch.setMember(2, prototype), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
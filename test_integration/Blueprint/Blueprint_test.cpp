@@ -0,0 +1,197 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file Blueprint_test.cpp
+* @brief Contains a test ensuring a model built from a tgBlueprint after
+* resets matches one built from a new tgStructureInfo every setup
+* $Id$
+*/
+
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBlueprint.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * Two pretensioned 3-bar prisms in substructures, joined by a rod
+	 * that shares a node with each, so the rigids are auto-compounded.
+	 */
+	void buildStructure(tgStructure& s)
+	{
+		tgStructure prism("prism");
+		prism.addNode(-5.0, 0, 0);
+		prism.addNode( 5.0, 0, 0);
+		prism.addNode(0, 0, 10.0);
+		prism.addNode(-5.0, 20.0, 0);
+		prism.addNode( 5.0, 20.0, 0);
+		prism.addNode(0, 20.0, 10.0);
+
+		prism.addPair(0, 4, "rod");
+		prism.addPair(1, 5, "rod");
+		prism.addPair(2, 3, "rod");
+
+		prism.addPair(0, 1, "muscle");
+		prism.addPair(1, 2, "muscle");
+		prism.addPair(2, 0, "muscle");
+		prism.addPair(3, 4, "muscle");
+		prism.addPair(4, 5, "muscle");
+		prism.addPair(5, 3, "muscle");
+		prism.addPair(0, 3, "muscle");
+		prism.addPair(1, 4, "muscle");
+		prism.addPair(2, 5, "muscle");
+
+		tgStructure* const first = new tgStructure(prism);
+		first->move(btVector3(0, 10.0, 0));
+		s.addChild(first);
+		tgStructure* const second = new tgStructure(prism);
+		second->move(btVector3(30.0, 10.0, 0));
+		s.addChild(second);
+
+		// From the first prism's node 4 to the second's node 0
+		s.addNode(5.0, 30.0, 0);
+		s.addNode(25.0, 10.0, 0);
+		s.addPair(0, 1, "rod");
+	}
+
+	class Prisms : public tgModel
+	{
+	public:
+		Prisms(bool useBlueprint) :
+			m_useBlueprint(useBlueprint),
+			m_pBlueprint(NULL)
+		{
+		}
+
+		virtual ~Prisms()
+		{
+			delete m_pBlueprint;
+		}
+
+		virtual void setup(tgWorld& world)
+		{
+			if (!m_useBlueprint || m_pBlueprint == NULL)
+			{
+				const tgRod::Config rodConfig(0.31, 0.2);
+				const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0,
+																 500.0);
+				tgBuildSpec spec;
+				spec.addBuilder("rod", new tgRodInfo(rodConfig));
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+				tgStructure s;
+				buildStructure(s);
+
+				if (m_useBlueprint)
+				{
+					m_pBlueprint = new tgBlueprint(s, spec);
+				}
+				else
+				{
+					tgStructureInfo structureInfo(s, spec);
+					structureInfo.buildInto(*this, world);
+				}
+			}
+			if (m_useBlueprint)
+			{
+				m_pBlueprint->buildInto(*this, world);
+			}
+			tgModel::setup(world);
+		}
+
+	private:
+		const bool m_useBlueprint;
+		tgBlueprint* m_pBlueprint;
+	};
+
+	/**
+	 * Run the prisms, reset and run them again, twice, and return the
+	 * world's state and the number of muscles at the end.
+	 */
+	std::vector<double> runPrisms(bool useBlueprint, int steps,
+								  std::size_t& muscles)
+	{
+		// the world will delete this
+		tgBoxGround* const ground = new tgBoxGround();
+		const tgWorld::Config config(98.1);
+		tgWorld world(config, ground);
+
+		const double stepSize = 1.0/1000.0; // Seconds
+		const double renderRate = 1.0/60.0; // Seconds
+		tgSimView view(world, stepSize, renderRate);
+		tgSimulation simulation(view);
+
+		Prisms* const pPrisms = new Prisms(useBlueprint);
+		simulation.addModel(pPrisms);
+
+		simulation.run(steps);
+		simulation.reset();
+		simulation.run(steps);
+		simulation.reset();
+		simulation.run(steps);
+
+		muscles = pPrisms->find<tgSpringCableActuator>("muscle").size();
+
+		std::vector<double> state;
+		world.saveState(state);
+		return state;
+	}
+
+	TEST(BlueprintTest, MatchesStructureInfoAfterResets) {
+		const int steps = 1000;
+		std::size_t expectedMuscles = 0;
+		std::size_t muscles = 0;
+		const std::vector<double> expected =
+			runPrisms(false, steps, expectedMuscles);
+		const std::vector<double> actual = runPrisms(true, steps, muscles);
+
+		EXPECT_EQ(18, expectedMuscles);
+		EXPECT_EQ(expectedMuscles, muscles);
+
+		// Bit for bit: the same bodies are created in the same order
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i], actual[i]) << "at state index " << i;
+		}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,252 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file CableBatch_test.cpp
+* @brief Contains a test that batched cables follow the same trajectory
+* as cables that apply their own forces, also when bodies are moved
+* between steps
+* $Id$
+*/
+
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgBulletSpringCable.h"
+#include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * Builds tgBasicActuators whose cables apply their own forces, as
+	 * they did before the world batched them.
+	 */
+	class UnbatchedActuatorInfo : public tgBasicActuatorInfo
+	{
+	public:
+		UnbatchedActuatorInfo(const tgBasicActuator::Config& config) :
+		tgBasicActuatorInfo(config),
+		m_unbatchedConfig(config)
+		{
+		}
+
+		UnbatchedActuatorInfo(const tgBasicActuator::Config& config,
+							  const tgPair& pair) :
+		tgBasicActuatorInfo(config, pair),
+		m_unbatchedConfig(config)
+		{
+		}
+
+		virtual tgConnectorInfo* createConnectorInfo(const tgPair& pair)
+		{
+			return new UnbatchedActuatorInfo(m_unbatchedConfig, pair);
+		}
+
+		virtual void initConnector(tgWorld& world)
+		{
+			// Anchors at the nodes, as the config below asks
+			std::vector<tgBulletSpringCableAnchor*> anchors;
+			anchors.push_back(new tgBulletSpringCableAnchor(getFromRigidBody(), getFrom()));
+			anchors.push_back(new tgBulletSpringCableAnchor(getToRigidBody(), getTo()));
+			m_bulletSpringCable = new tgBulletSpringCable(anchors,
+				m_unbatchedConfig.stiffness, m_unbatchedConfig.damping,
+				m_unbatchedConfig.pretension);
+		}
+
+	private:
+		const tgBasicActuator::Config m_unbatchedConfig;
+	};
+
+	/** A pretensioned 3-bar prism with batched or unbatched cables */
+	class Prism : public tgModel
+	{
+	public:
+		Prism(bool batched) : m_batched(batched) { }
+
+		virtual void setup(tgWorld& world)
+		{
+			const tgRod::Config rodConfig(0.31, 0.2);
+			// Anchors at the nodes, so both kinds of cable agree
+			const tgBasicActuator::Config muscleConfig(1000.0, 10.0, 500.0,
+				false, 1000.0, 100.0, 0.1, 0.1, 0, false, false);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			if (m_batched)
+			{
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+			}
+			else
+			{
+				spec.addBuilder("muscle", new UnbatchedActuatorInfo(muscleConfig));
+			}
+
+			tgStructure s;
+			s.addNode(-5.0, 0, 0);
+			s.addNode( 5.0, 0, 0);
+			s.addNode(0, 0, 10.0);
+			s.addNode(-5.0, 20.0, 0);
+			s.addNode( 5.0, 20.0, 0);
+			s.addNode(0, 20.0, 10.0);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, 10.0, 0));
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			m_rods = tgCast::filter<tgModel, tgRod>(getDescendants());
+			m_muscles = tgCast::filter<tgModel, tgSpringCableActuator>(getDescendants());
+			tgModel::setup(world);
+		}
+
+		/** Move one rod, as apps that place their robots do */
+		void moveRod(const btVector3& offset)
+		{
+			btRigidBody* const pBody = m_rods[0]->getPRigidBody();
+			btTransform transform = pBody->getCenterOfMassTransform();
+			transform.setOrigin(transform.getOrigin() + offset);
+			pBody->setCenterOfMassTransform(transform);
+		}
+
+		/** Append the tension of every cable */
+		void appendTensions(std::vector<double>& tensions) const
+		{
+			for (std::size_t i = 0; i < m_muscles.size(); i++)
+			{
+				tensions.push_back(m_muscles[i]->getTension());
+			}
+		}
+
+	private:
+		const bool m_batched;
+		std::vector<tgRod*> m_rods;
+		std::vector<tgSpringCableActuator*> m_muscles;
+	};
+
+	/** The tensions after every step, then the world's final state */
+	struct Trajectory
+	{
+		std::vector<double> tensions;
+		std::vector<double> state;
+	};
+
+	Trajectory runPrism(bool batched, int steps, int moveAt)
+	{
+		// the world will delete this
+		tgBoxGround* const ground = new tgBoxGround();
+		const tgWorld::Config config(98.1);
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+
+		Prism* const prism = new Prism(batched);
+		simulation.addModel(prism);
+
+		Trajectory trajectory;
+		for (int i = 0; i < steps; i++)
+		{
+			if (i == moveAt)
+			{
+				// Between steps, after the world step moved the bodies
+				prism->moveRod(btVector3(0.5, 0.0, 0.0));
+			}
+			simulation.run(1);
+			prism->appendTensions(trajectory.tensions);
+		}
+		world.saveState(trajectory.state);
+		return trajectory;
+	}
+
+	/**
+	 * The batch finds the same lengths with the same operations, but the
+	 * compiler may vectorize or contract them differently from the
+	 * btVector3 code, so allow for rounding rather than expect identical
+	 * bits. The tolerance is relative, with a floor for values near zero.
+	 */
+	void expectClose(const std::vector<double>& expected,
+					 const std::vector<double>& actual,
+					 const char* what)
+	{
+		const double tolerance = 1e-9;
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			const double scale = std::max(1.0, std::fabs(expected[i]));
+			EXPECT_NEAR(expected[i], actual[i], tolerance * scale)
+				<< "at " << what << " index " << i;
+		}
+	}
+
+	TEST(CableBatchTest, MatchesUnbatchedCables) {
+		const int steps = 1000;
+		const Trajectory expected = runPrism(false, steps, -1);
+		const Trajectory actual = runPrism(true, steps, -1);
+		expectClose(expected.tensions, actual.tensions, "tension");
+		expectClose(expected.state, actual.state, "state");
+	}
+
+	TEST(CableBatchTest, SeesBodiesMovedBetweenSteps) {
+		const int steps = 1000;
+		const int moveAt = 400;
+		const Trajectory expected = runPrism(false, steps, moveAt);
+		const Trajectory actual = runPrism(true, steps, moveAt);
+		expectClose(expected.tensions, actual.tensions, "tension");
+		expectClose(expected.state, actual.state, "state");
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,361 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file ContactCable_test.cpp
+* @brief Contains tests of a contact cable that wraps around a body and
+* unwraps again: its collision shape against one rebuilt from scratch,
+* and its anchors through snapshots, resets and teardown. Build it with
+* -fsanitize=address to check the anchors' memory.
+* $Id$
+*/
+
+// This library
+#include "core/terrain/tgEmptyGround.h"
+#include "core/tgBulletUtil.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCable.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicContactCableInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+#include "tgcreator/tgUtil.h"
+// The Bullet Physics library
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "BulletCollision/CollisionShapes/btCylinderShape.h"
+#include "BulletDynamics/Dynamics/btDynamicsWorld.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/** Steps to sweep the cable across the post, and as many back */
+	const int sweepSteps = 300;
+
+	/**
+	 * A contact cable between two rods, beside a static post. The test
+	 * moves the rods so that the cable wraps over the post and back off.
+	 */
+	class Wrap : public tgModel
+	{
+	public:
+		virtual void setup(tgWorld& world)
+		{
+			const tgRod::Config rodConfig(0.25, 1.0);
+			const tgRod::Config postConfig(0.25, 0.0);
+			const tgSpringCableActuator::Config muscleConfig(1000.0, 0.0, 0.0,
+															 false, 600000000);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("post", new tgRodInfo(postConfig));
+			spec.addBuilder("muscle", new tgBasicContactCableInfo(muscleConfig));
+
+			tgStructure s;
+			s.addNode(0, 2, 0);
+			s.addNode(0, 4, 0);
+			s.addNode(0, 12, 0);
+			s.addNode(0, 14, 0);
+			s.addNode(-2, 8, -1);
+			s.addNode( 2, 8, -1);
+
+			s.addPair(0, 1, "rod");
+			s.addPair(2, 3, "rod");
+			s.addPair(4, 5, "post");
+			s.addPair(1, 2, "muscle");
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			m_rods = tgCast::filter<tgModel, tgRod>(getDescendants());
+			m_muscles = tgCast::filter<tgModel, tgSpringCableActuator>(getDescendants());
+			tgModel::setup(world);
+		}
+
+		/**
+		 * Place the two free rods at depth z, at rest. The post is at
+		 * z = -1 and the cable starts clear of it, at z = 0.
+		 */
+		void placeRods(double z)
+		{
+			for (std::size_t i = 0; i < m_rods.size(); i++)
+			{
+				btRigidBody* const pBody = m_rods[i]->getPRigidBody();
+				if (pBody->getInvMass() == 0.0)
+				{
+					continue;
+				}
+				btTransform transform = pBody->getCenterOfMassTransform();
+				btVector3 origin = transform.getOrigin();
+				origin.setZ(z);
+				transform.setOrigin(origin);
+				pBody->setCenterOfMassTransform(transform);
+				pBody->setLinearVelocity(btVector3(0, 0, 0));
+				pBody->setAngularVelocity(btVector3(0, 0, 0));
+			}
+		}
+
+		const tgSpringCable& cable() const
+		{
+			return *m_muscles[0]->getSpringCable();
+		}
+
+		std::size_t anchorCount() const
+		{
+			return cable().getAnchors().size();
+		}
+
+	private:
+		std::vector<tgRod*> m_rods;
+		std::vector<tgSpringCableActuator*> m_muscles;
+	};
+
+	/** Depth of the rods at step i: down past the post, then back up */
+	double depthAt(int i)
+	{
+		const double travel = 2.0;
+		if (i < sweepSteps)
+		{
+			return -travel * i / sweepSteps;
+		}
+		return -travel * (2 * sweepSteps - i) / sweepSteps;
+	}
+
+	/** The most anchors seen, and the anchors after the last step */
+	struct Sweep
+	{
+		std::size_t maxAnchors;
+		std::size_t endAnchors;
+	};
+
+	/** Move the rods along the sweep, steps from to to, inclusive */
+	Sweep sweep(tgSimulation& simulation, Wrap& wrap, int from, int to)
+	{
+		Sweep result;
+		result.maxAnchors = wrap.anchorCount();
+		for (int i = from; i <= to; i++)
+		{
+			wrap.placeRods(depthAt(i));
+			simulation.run(1);
+			if (wrap.anchorCount() > result.maxAnchors)
+			{
+				result.maxAnchors = wrap.anchorCount();
+			}
+		}
+		result.endAnchors = wrap.anchorCount();
+		return result;
+	}
+
+	/** The radius tgBasicContactCableInfo gives the cable's segments */
+	const double thickness = 0.001;
+
+	/** The cable's ghost object, the only one in the world */
+	btCollisionObject* findGhost(const tgWorld& world)
+	{
+		btCollisionObjectArray& objects =
+			tgBulletUtil::worldToDynamicsWorld(world).getCollisionObjectArray();
+		for (int i = 0; i < objects.size(); i++)
+		{
+			if (btGhostObject::upcast(objects[i]))
+			{
+				return objects[i];
+			}
+		}
+		return NULL;
+	}
+
+	void expectSame(const btVector3& expected, const btVector3& actual,
+					const char* what, std::size_t segment)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			EXPECT_EQ(expected[k], actual[k]) << what << " of segment " << segment;
+		}
+	}
+
+	/**
+	 * Check the ghost object's shape against the one the cable used to
+	 * build from new btCylinderShapes on every step, from the anchors.
+	 * @return the number of segments
+	 */
+	std::size_t checkShape(const tgWorld& world, const tgSpringCable& cable)
+	{
+		const std::vector<const tgSpringCableAnchor*> anchors = cable.getAnchors();
+		const std::size_t n = anchors.size();
+
+		btVector3 maxes(anchors[n - 1]->getWorldPosition());
+		btVector3 mins(anchors[0]->getWorldPosition());
+		for (std::size_t i = 0; i < n; i++)
+		{
+			const btVector3 worldPos = anchors[i]->getWorldPosition();
+			maxes.setMax(worldPos);
+			mins.setMin(worldPos);
+		}
+		const btVector3 center = (maxes + mins) / 2.0;
+
+		btCollisionObject* const pGhost = findGhost(world);
+		EXPECT_TRUE(pGhost != NULL);
+		if (!pGhost)
+		{
+			return 0;
+		}
+		expectSame(center, pGhost->getWorldTransform().getOrigin(), "center", 0);
+
+		const btCompoundShape* const pCompound =
+			static_cast<const btCompoundShape*>(pGhost->getCollisionShape());
+		EXPECT_EQ(n - 1, pCompound->getNumChildShapes());
+		if (pCompound->getNumChildShapes() != static_cast<int>(n - 1))
+		{
+			return pCompound->getNumChildShapes();
+		}
+
+		btCompoundShape expected;
+		std::vector<btCylinderShape*> segments;
+		for (std::size_t i = 0; i < n - 1; i++)
+		{
+			const btVector3 pos1 = anchors[i]->getWorldPosition();
+			const btVector3 pos2 = anchors[i + 1]->getWorldPosition();
+			btTransform t = tgUtil::getTransform(pos2, pos1);
+			t.setOrigin(t.getOrigin() - center);
+			const btScalar length = (pos2 - pos1).length() / 2.0;
+			segments.push_back(new btCylinderShape(btVector3(thickness, length, thickness)));
+			expected.addChildShape(t, segments.back());
+
+			const btCylinderShape* const pSegment =
+				static_cast<const btCylinderShape*>(pCompound->getChildShape(i));
+			const btTransform& actual = pCompound->getChildTransform(i);
+			expectSame(t.getOrigin(), actual.getOrigin(), "origin", i);
+			for (int r = 0; r < 3; r++)
+			{
+				expectSame(t.getBasis()[r], actual.getBasis()[r], "basis", i);
+			}
+			expectSame(segments.back()->getHalfExtentsWithMargin(),
+					   pSegment->getHalfExtentsWithMargin(), "half extents", i);
+			expectSame(segments.back()->getImplicitShapeDimensions(),
+					   pSegment->getImplicitShapeDimensions(), "dimensions", i);
+		}
+
+		// The bounds the broadphase sees
+		btTransform identity;
+		identity.setIdentity();
+		btVector3 expectedMin, expectedMax, actualMin, actualMax;
+		expected.getAabb(identity, expectedMin, expectedMax);
+		pCompound->getAabb(identity, actualMin, actualMax);
+		expectSame(expectedMin, actualMin, "bounds min", n - 1);
+		expectSame(expectedMax, actualMax, "bounds max", n - 1);
+
+		for (std::size_t i = 0; i < segments.size(); i++)
+		{
+			delete segments[i];
+		}
+		return n - 1;
+	}
+
+	TEST(ContactCableTest, ReusedSegmentsMatchNewOnes) {
+		// the world will delete this
+		tgEmptyGround* const ground = new tgEmptyGround();
+		const tgWorld::Config config(0.0);
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+
+		Wrap* const wrap = new Wrap();
+		simulation.addModel(wrap);
+
+		// Twice, so that the second wrap takes its segments from the
+		// ones the first one left
+		for (int pass = 0; pass < 2; pass++)
+		{
+			std::size_t maxSegments = 0;
+			for (int i = 0; i <= 2 * sweepSteps; i++)
+			{
+				wrap->placeRods(depthAt(i));
+				simulation.run(1);
+				const std::size_t segments = checkShape(world, wrap->cable());
+				if (segments > maxSegments)
+				{
+					maxSegments = segments;
+				}
+				if (HasFailure())
+				{
+					FAIL() << "at step " << i << " of pass " << pass;
+				}
+			}
+			EXPECT_GT(maxSegments, 1) << "on pass " << pass;
+			EXPECT_EQ(1, checkShape(world, wrap->cable())) << "on pass " << pass;
+		}
+	}
+
+	TEST(ContactCableTest, WrapsRestoresResetsAndTearsDown) {
+		// the world will delete this
+		tgEmptyGround* const ground = new tgEmptyGround();
+		const tgWorld::Config config(0.0);
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+
+		Wrap* const wrap = new Wrap();
+		simulation.addModel(wrap);
+		EXPECT_EQ(2, wrap->anchorCount());
+
+		// Sliding anchors come with the contact and go when it ends
+		const Sweep first = sweep(simulation, *wrap, 0, 2 * sweepSteps);
+		EXPECT_GT(first.maxAnchors, 2);
+		EXPECT_EQ(2, first.endAnchors);
+
+		// Restoring drops the anchors, wherever the cable is
+		simulation.reset();
+		const Sweep down = sweep(simulation, *wrap, 0, sweepSteps);
+		EXPECT_GT(down.endAnchors, 2);
+		const tgSimulation::SnapshotHandle handle = simulation.snapshot();
+		sweep(simulation, *wrap, sweepSteps + 1, sweepSteps + 100);
+		simulation.restore(handle);
+		EXPECT_EQ(2, wrap->anchorCount());
+		sweep(simulation, *wrap, sweepSteps + 1, 2 * sweepSteps);
+
+		// Reset while wrapped
+		simulation.reset();
+		EXPECT_EQ(2, wrap->anchorCount());
+		const Sweep second = sweep(simulation, *wrap, 0, 2 * sweepSteps);
+		EXPECT_GT(second.maxAnchors, 2);
+		EXPECT_EQ(2, second.endAnchors);
+
+		// And tear down while wrapped, when the simulation goes
+		sweep(simulation, *wrap, 0, sweepSteps);
+		EXPECT_GT(wrap->anchorCount(), 2);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
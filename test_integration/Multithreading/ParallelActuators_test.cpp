@@ -0,0 +1,169 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file ParallelActuators_test.cpp
+* @brief Contains a test ensuring actuators stepped on several threads
+* give the same results as when stepped with their models
+* $Id$
+*/
+
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * A grid of pretensioned 3-bar prisms, enough cables for the stepper
+	 * to split them over several threads.
+	 */
+	class PrismGrid : public tgModel
+	{
+	public:
+		PrismGrid(int side) : m_side(side) { }
+
+		virtual void setup(tgWorld& world)
+		{
+			const tgRod::Config rodConfig(0.31, 0.2);
+			const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0,
+															 500.0);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+			for (int i = 0; i < m_side; i++)
+			{
+				for (int j = 0; j < m_side; j++)
+				{
+					tgStructure s;
+					s.addNode(-5.0, 0, 0);
+					s.addNode( 5.0, 0, 0);
+					s.addNode(0, 0, 10.0);
+					s.addNode(-5.0, 20.0, 0);
+					s.addNode( 5.0, 20.0, 0);
+					s.addNode(0, 20.0, 10.0);
+
+					s.addPair(0, 4, "rod");
+					s.addPair(1, 5, "rod");
+					s.addPair(2, 3, "rod");
+
+					s.addPair(0, 1, "muscle");
+					s.addPair(1, 2, "muscle");
+					s.addPair(2, 0, "muscle");
+					s.addPair(3, 4, "muscle");
+					s.addPair(4, 5, "muscle");
+					s.addPair(5, 3, "muscle");
+					s.addPair(0, 3, "muscle");
+					s.addPair(1, 4, "muscle");
+					s.addPair(2, 5, "muscle");
+
+					s.move(btVector3(30.0 * i, 10.0, 30.0 * j));
+
+					tgStructureInfo structureInfo(s, spec);
+					structureInfo.buildInto(*this, world);
+				}
+			}
+			tgModel::setup(world);
+		}
+
+	private:
+		const int m_side;
+	};
+
+	/** Run the grid and return the world's state after the given steps. */
+	std::vector<double> runPrisms(std::size_t actuatorThreads, int steps)
+	{
+		// the world will delete this
+		tgBoxGround* const ground = new tgBoxGround();
+		const tgWorld::Config config(98.1);
+		tgWorld world(config, ground);
+
+		const double stepSize = 1.0/1000.0; // Seconds
+		const double renderRate = 1.0/60.0; // Seconds
+		tgSimView view(world, stepSize, renderRate);
+		tgSimulation simulation(view);
+
+		simulation.setActuatorThreads(actuatorThreads);
+		simulation.addModel(new PrismGrid(4));
+
+		simulation.run(steps);
+
+		std::vector<double> state;
+		world.saveState(state);
+		return state;
+	}
+
+	TEST(ParallelActuatorsTest, MatchesSerialStep) {
+		const int steps = 2000;
+		const std::vector<double> expected = runPrisms(1, steps);
+		const std::vector<double> first = runPrisms(4, steps);
+		const std::vector<double> second = runPrisms(4, steps);
+
+		// Bit for bit: the impulses are applied in the serial order
+		ASSERT_EQ(expected.size(), first.size());
+		ASSERT_EQ(expected.size(), second.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i], first[i]) << "at state index " << i;
+			EXPECT_EQ(first[i], second[i]) << "at state index " << i;
+		}
+	}
+
+	TEST(ParallelActuatorsTest, SurvivesReset) {
+		tgBoxGround* const ground = new tgBoxGround();
+		const tgWorld::Config config(98.1);
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+
+		simulation.addModel(new PrismGrid(4));
+		simulation.setActuatorThreads(0);
+		simulation.run(100);
+		simulation.reset();
+		simulation.run(100);
+		simulation.setActuatorThreads(1);
+		simulation.run(100);
+
+		std::vector<double> state;
+		world.saveState(state);
+		EXPECT_FALSE(state.empty());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
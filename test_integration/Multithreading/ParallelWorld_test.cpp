@@ -0,0 +1,194 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file ParallelWorld_test.cpp
+* @brief Contains a test ensuring a multithreaded tgWorld gives the same
+* results as the single-threaded one
+* $Id$
+*/
+
+// This application
+#include "examples/SUPERball/T6Model.h"
+#include "models/obstacles/tgBlockField.h"
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgWorld.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstdlib>
+#include <vector>
+// POSIX
+#include <dirent.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * Drop SUPERball on a field of blocks, so the step has many islands and
+	 * contacts, and return the world's state after the given steps.
+	 */
+	std::vector<double> runSUPERball(const tgWorld::Config& config, int steps)
+	{
+		// tgBlockField places its blocks with rand()
+		srand(1);
+
+		// the world will delete this
+		tgBoxGround* const ground = new tgBoxGround();
+		tgWorld world(config, ground);
+
+		const double stepSize = 1.0/1000.0; // Seconds
+		const double renderRate = 1.0/60.0; // Seconds
+		tgSimView view(world, stepSize, renderRate);
+		tgSimulation simulation(view);
+
+		simulation.addModel(new T6Model());
+		tgBlockField::Config fieldConfig(btVector3(0.0, 0.0, 0.0),
+										 0.5, 0.0,
+										 btVector3(-20.0, 0.0, -20.0),
+										 btVector3(20.0, 0.0, 20.0),
+										 200, 3.0, 3.0, 3.0);
+		simulation.addObstacle(new tgBlockField(fieldConfig));
+
+		simulation.run(steps);
+
+		std::vector<double> state;
+		world.saveState(state);
+		return state;
+	}
+
+	void expectSameState(const std::vector<double>& expected,
+						 const std::vector<double>& actual)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i], actual[i]) << "at state index " << i;
+		}
+	}
+
+	/**
+	 * Runs the same solver on one thread and on four. Different solvers
+	 * give different trajectories, so each is only compared with itself.
+	 */
+	void expectSameAsSingleThreaded(tgWorld::Config::SolverType solver)
+	{
+		const int steps = 2000;
+		const tgWorld::Config serial(98.1, 1000, solver,
+									 tgWorld::Config::eAxisSweep3, 10, 1);
+		// Only the number of threads differs
+		tgWorld::Config parallel = serial;
+		parallel.threads = 4;
+
+		const std::vector<double> expected = runSUPERball(serial, steps);
+		const std::vector<double> first = runSUPERball(parallel, steps);
+		const std::vector<double> second = runSUPERball(parallel, steps);
+
+		// Bit for bit: each island batch is solved with the same input
+		expectSameState(expected, first);
+		expectSameState(first, second);
+	}
+
+	/** @return the number of threads in this process */
+	int processThreads()
+	{
+		DIR* const dir = opendir("/proc/self/task");
+		if (dir == NULL)
+		{
+			return -1;
+		}
+		int n = 0;
+		while (dirent* const entry = readdir(dir))
+		{
+			if (entry->d_name[0] != '.')
+			{
+				n++;
+			}
+		}
+		closedir(dir);
+		return n;
+	}
+
+	/**
+	 * Run SUPERball, reset the simulation and run it again, checking
+	 * after each reset that no threads were started.
+	 */
+	std::vector<double> runSUPERballTwice(const tgWorld::Config& config,
+										  int steps)
+	{
+		srand(1);
+		tgBoxGround* const ground = new tgBoxGround();
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+		simulation.addModel(new T6Model());
+
+		const int threads = processThreads();
+		simulation.run(steps);
+		simulation.reset();
+		EXPECT_EQ(threads, processThreads());
+		simulation.run(steps);
+
+		std::vector<double> state;
+		world.saveState(state);
+		return state;
+	}
+
+	TEST(ParallelWorldTest, DantzigMatchesSingleThreaded) {
+		expectSameAsSingleThreaded(tgWorld::Config::eDantzigMLCP);
+	}
+
+	TEST(ParallelWorldTest, SequentialImpulseMatchesSingleThreaded) {
+		expectSameAsSingleThreaded(tgWorld::Config::eSequentialImpulse);
+	}
+
+	TEST(ParallelWorldTest, PGSMatchesSingleThreaded) {
+		expectSameAsSingleThreaded(tgWorld::Config::ePGSMLCP);
+	}
+
+	TEST(ParallelWorldTest, ResetKeepsTheThreads) {
+		const int steps = 500;
+		const tgWorld::Config serial(98.1, 1000,
+									 tgWorld::Config::eDantzigMLCP,
+									 tgWorld::Config::eAxisSweep3, 10, 1);
+		tgWorld::Config parallel = serial;
+		parallel.threads = 4;
+
+		const std::vector<double> expected = runSUPERballTwice(serial, steps);
+		const std::vector<double> actual = runSUPERballTwice(parallel, steps);
+		expectSameState(expected, actual);
+	}
+
+	TEST(ParallelWorldTest, ZeroThreadsMeansOnePerProcessor) {
+		const tgWorld::Config config(98.1, 1000,
+									 tgWorld::Config::eDantzigMLCP,
+									 tgWorld::Config::eAxisSweep3, 10, 0);
+		const std::vector<double> state = runSUPERball(config, 100);
+		EXPECT_FALSE(state.empty());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
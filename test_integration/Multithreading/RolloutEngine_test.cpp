@@ -0,0 +1,187 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file RolloutEngine_test.cpp
+* @brief Contains a test ensuring rollouts run in parallel by
+* tgRolloutEngine score the same as when run one at a time
+* $Id$
+*/
+
+// This library
+#include "core/tgBaseRigid.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgRolloutEngine.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * A 3-bar prism dropped from the height params[0], with the
+	 * pretension params[1].
+	 */
+	class Prism : public tgModel
+	{
+	public:
+		Prism(const std::vector<double>& params) : m_params(params) { }
+
+		virtual void setup(tgWorld& world)
+		{
+			const tgRod::Config rodConfig(0.31, 0.2);
+			const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0,
+															 m_params[1]);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+			tgStructure s;
+			s.addNode(-5.0, 0, 0);
+			s.addNode( 5.0, 0, 0);
+			s.addNode(0, 0, 10.0);
+			s.addNode(-5.0, 20.0, 0);
+			s.addNode( 5.0, 20.0, 0);
+			s.addNode(0, 20.0, 10.0);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, m_params[0], 0));
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+			tgModel::setup(world);
+		}
+
+	private:
+		const std::vector<double> m_params;
+	};
+
+	/** Scores a rollout by where the rods came to rest */
+	class PrismFactory : public tgRolloutFactory
+	{
+	public:
+		virtual tgModel* createModel(const std::vector<double>& params)
+		{
+			if (params[0] < 0.0)
+			{
+				throw std::invalid_argument("Prism below the ground");
+			}
+			return new Prism(params);
+		}
+
+		virtual double score(tgModel& model)
+		{
+			const std::vector<tgRod*> rods =
+				tgCast::filter<tgModel, tgRod>(model.getDescendants());
+			double score = 0.0;
+			for (std::size_t i = 0; i < rods.size(); i++)
+			{
+				const btVector3 com = rods[i]->centerOfMass();
+				score += com.x() + 10.0 * com.y() + 100.0 * com.z();
+			}
+			return score;
+		}
+	};
+
+	std::vector<std::vector<double> > parameterSets(std::size_t n)
+	{
+		std::vector<std::vector<double> > params;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			std::vector<double> p;
+			p.push_back(5.0 + 2.0 * i);
+			p.push_back(200.0 + 50.0 * i);
+			params.push_back(p);
+		}
+		return params;
+	}
+
+	std::vector<double> runRollouts(std::size_t threads,
+		const std::vector<std::vector<double> >& params)
+	{
+		const tgWorld::Config world(98.1);
+		const tgRolloutEngine::Config config(world, 1.0/1000.0, 2000, threads);
+		tgRolloutEngine engine(config);
+		EXPECT_EQ(threads, engine.threadCount());
+		PrismFactory factory;
+		return engine.run(factory, params);
+	}
+
+	TEST(RolloutEngineTest, ParallelMatchesSerial) {
+		const std::vector<std::vector<double> > params = parameterSets(8);
+		const std::vector<double> expected = runRollouts(1, params);
+		const std::vector<double> actual = runRollouts(4, params);
+
+		// Bit for bit: the worlds share no state
+		ASSERT_EQ(params.size(), expected.size());
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i], actual[i]) << "rollout " << i;
+		}
+		// The parameters mattered, so the order of the scores is checked
+		EXPECT_NE(expected.front(), expected.back());
+	}
+
+	TEST(RolloutEngineTest, ReportsAFailedRollout) {
+		std::vector<std::vector<double> > params = parameterSets(4);
+		params[2][0] = -1.0;
+		EXPECT_THROW(runRollouts(2, params), std::runtime_error);
+	}
+
+	TEST(RolloutEngineTest, RejectsMismatchedSizes) {
+		tgRolloutEngine engine(tgRolloutEngine::Config(tgWorld::Config(),
+													   1.0/1000.0, 10, 1));
+		PrismFactory factory;
+		const std::vector<tgRolloutFactory*> factories(3, &factory);
+		EXPECT_THROW(engine.run(factories, parameterSets(2)),
+					 std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,228 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file Snapshot_test.cpp
+* @brief Contains a test that a run continued from a restored snapshot
+* repeats the run that followed the snapshot
+* $Id$
+*/
+
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgObserver.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	/**
+	 * Drives an actuator's preferred length along a sine wave of its
+	 * own clock, which it keeps through snapshots.
+	 */
+	class SineLengthControl : public tgObserver<tgSpringCableActuator>
+	{
+	public:
+		SineLengthControl(double phase) :
+		m_phase(phase),
+		m_time(0.0)
+		{
+		}
+
+		virtual void onStep(tgSpringCableActuator& subject, double dt)
+		{
+			m_time += dt;
+			tgBasicActuator* const pActuator =
+				tgCast::cast<tgSpringCableActuator, tgBasicActuator>(subject);
+			const double start = subject.getStartLength();
+			pActuator->setControlInput(start * (0.9 + 0.1 *
+				std::sin(2.0 * M_PI * m_time + m_phase)), dt);
+		}
+
+		virtual void onSaveState(const tgSpringCableActuator& subject,
+								 std::vector<double>& state) const
+		{
+			state.push_back(m_time);
+		}
+
+		virtual void onRestoreState(tgSpringCableActuator& subject,
+									const std::vector<double>& state,
+									std::size_t& pos)
+		{
+			if (pos + 1 > state.size())
+			{
+				throw std::invalid_argument("Saved state is too short for SineLengthControl");
+			}
+			m_time = state[pos++];
+		}
+
+	private:
+		const double m_phase;
+		double m_time;
+	};
+
+	/**
+	 * A pretensioned 3-bar prism, well clear of the ground so that
+	 * nothing makes contact, with history kept and every cable driven.
+	 */
+	class Prism : public tgModel
+	{
+	public:
+		virtual ~Prism()
+		{
+			for (std::size_t i = 0; i < m_controllers.size(); i++)
+			{
+				delete m_controllers[i];
+			}
+		}
+
+		virtual void setup(tgWorld& world)
+		{
+			const tgRod::Config rodConfig(0.31, 0.2);
+			tgSpringCableActuator::Config muscleConfig(1000.0, 10.0, 500.0,
+													   true);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+			tgStructure s;
+			s.addNode(-5.0, 0, 0);
+			s.addNode( 5.0, 0, 0);
+			s.addNode(0, 0, 10.0);
+			s.addNode(-5.0, 20.0, 0);
+			s.addNode( 5.0, 20.0, 0);
+			s.addNode(0, 20.0, 10.0);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, 100.0, 0));
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			m_muscles = tgCast::filter<tgModel, tgSpringCableActuator>(getDescendants());
+			for (std::size_t i = 0; i < m_muscles.size(); i++)
+			{
+				SineLengthControl* const pControl = new SineLengthControl(0.5 * i);
+				m_muscles[i]->attach(pControl);
+				m_controllers.push_back(pControl);
+			}
+			tgModel::setup(world);
+		}
+
+		/** Append the history and tension of every cable */
+		void appendCables(std::vector<double>& values) const
+		{
+			for (std::size_t i = 0; i < m_muscles.size(); i++)
+			{
+				const tgSpringCableActuator::SpringCableActuatorHistory& h =
+					m_muscles[i]->getHistory();
+				values.push_back(h.tensionHistory.size());
+				values.insert(values.end(), h.tensionHistory.begin(),
+							  h.tensionHistory.end());
+				values.insert(values.end(), h.restLengths.begin(),
+							  h.restLengths.end());
+				values.push_back(m_muscles[i]->getTension());
+			}
+		}
+
+	private:
+		std::vector<tgSpringCableActuator*> m_muscles;
+		std::vector<SineLengthControl*> m_controllers;
+	};
+
+	TEST(SnapshotTest, RestoredRunRepeats) {
+		// the world will delete this
+		tgBoxGround* const ground = new tgBoxGround();
+		// No gravity, so the prism stays away from the ground
+		const tgWorld::Config config(0.0);
+		tgWorld world(config, ground);
+		tgSimView view(world, 1.0/1000.0, 1.0/60.0);
+		tgSimulation simulation(view);
+
+		Prism* const prism = new Prism();
+		simulation.addModel(prism);
+
+		const int n = 500;
+		const int m = 700;
+		simulation.run(n);
+		const tgSimulation::SnapshotHandle handle = simulation.snapshot();
+
+		simulation.run(m);
+		std::vector<double> expectedBodies;
+		world.saveState(expectedBodies);
+		std::vector<double> expectedCables;
+		prism->appendCables(expectedCables);
+
+		simulation.restore(handle);
+		simulation.run(m);
+		std::vector<double> bodies;
+		world.saveState(bodies);
+		std::vector<double> cables;
+		prism->appendCables(cables);
+
+		// Bit for bit: nothing the trajectory depends on is lost
+		ASSERT_EQ(expectedBodies.size(), bodies.size());
+		for (std::size_t i = 0; i < bodies.size(); i++)
+		{
+			EXPECT_EQ(expectedBodies[i], bodies[i]) << "at body state index " << i;
+		}
+		ASSERT_EQ(expectedCables.size(), cables.size());
+		for (std::size_t i = 0; i < cables.size(); i++)
+		{
+			EXPECT_EQ(expectedCables[i], cables[i]) << "at cable value " << i;
+		}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}